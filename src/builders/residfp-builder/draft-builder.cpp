@@ -0,0 +1,69 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "draft.h"
+
+#include <new>
+
+#include "draft-emu.h"
+
+DraftSIDBuilder::~DraftSIDBuilder()
+{   // Remove all SID emulations
+    remove();
+}
+
+// Create a new sid emulation.
+unsigned int DraftSIDBuilder::create(unsigned int sids)
+{
+    m_status = true;
+
+    // Check available devices
+    unsigned int count = availDevices();
+
+    if (count && (count < sids))
+        sids = count;
+
+    for (count = 0; count < sids; count++)
+    {
+        try
+        {
+            sidobjs.insert(new libsidplayfp::DraftSID(this));
+        }
+        // Memory alloc failed?
+        catch (std::bad_alloc const &)
+        {
+            m_errorBuffer.assign(name()).append(" ERROR: Unable to create DraftSID object");
+            m_status = false;
+            break;
+        }
+    }
+    return count;
+}
+
+const char *DraftSIDBuilder::credits() const
+{
+    return libsidplayfp::DraftSID::getCredits();
+}
+
+void DraftSIDBuilder::filter(bool enable)
+{
+    for (libsidplayfp::sidemu* e: sidobjs)
+        static_cast<libsidplayfp::DraftSID*>(e)->filter(enable);
+}
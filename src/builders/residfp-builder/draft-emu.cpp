@@ -0,0 +1,146 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "draft-emu.h"
+
+#include "residfp/SID.h"
+#include "residfp/siddefs-fp.h"
+#include "sidplayfp/siddefs.h"
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+namespace libsidplayfp
+{
+
+const char* DraftSID::getCredits()
+{
+    return
+        "DraftSID V" VERSION " Engine:\n"
+        "\tFast approximate emulation based on ReSIDfp\n"
+        "MOS6581/CSG8580 (SID) Emulation:\n"
+        "\t(C) 1999-2002 Dag Lem\n"
+        "\t(C) 2005-2011 Antti S. Lankila\n"
+        "\t(C) 2010-2025 Leandro Nini\n";
+}
+
+DraftSID::DraftSID(sidbuilder *builder) :
+    sidemu(builder),
+    m_sid(*(new reSIDfp::DraftSID))
+{
+    m_buffer = new short[OUTPUTBUFFERSIZE];
+    reset(0);
+}
+
+DraftSID::~DraftSID()
+{
+    delete &m_sid;
+    delete[] m_buffer;
+}
+
+// Standard component options
+void DraftSID::reset(uint8_t volume)
+{
+    m_accessClk = 0;
+    m_sid.reset();
+    m_sid.write(0x18, volume);
+}
+
+uint8_t DraftSID::read(uint_least8_t addr)
+{
+    clock();
+    return m_sid.read(addr);
+}
+
+void DraftSID::write(uint_least8_t addr, uint8_t data)
+{
+    clock();
+    m_sid.write(addr, data);
+}
+
+// The open bus is not emulated
+void DraftSID::OS_write(uint_least8_t addr, uint8_t data)
+{
+    write(addr, data);
+}
+
+// Debug switches are not supported
+void DraftSID::sidvis(uint_least8_t, bool, bool, bool)
+{
+    clock();
+}
+
+void DraftSID::clock()
+{
+    const event_clock_t cycles = eventScheduler->getTime(EVENT_CLOCK_PHI1) - m_accessClk;
+    m_accessClk += cycles;
+    m_bufferpos += m_sid.clock(cycles, m_buffer+m_bufferpos);
+}
+
+void DraftSID::filter(bool enable)
+{
+    m_sid.enableFilter(enable);
+}
+
+// The sampling method is ignored,
+// output is always decimated with a zero order hold
+void DraftSID::sampling(float systemclock, float freq,
+        SidConfig::sampling_method_t, bool)
+{
+    try
+    {
+        m_sid.setSamplingParameters(systemclock, freq);
+    }
+    catch (reSIDfp::SIDError const &)
+    {
+        m_status = false;
+        m_error = ERR_UNSUPPORTED_FREQ;
+        return;
+    }
+
+    m_status = true;
+}
+
+// Set the emulated SID model
+void DraftSID::model(SidConfig::sid_model_t model, bool digiboost)
+{
+    reSIDfp::ChipModel chipModel;
+    switch (model)
+    {
+        case SidConfig::MOS6581:
+            chipModel = reSIDfp::MOS6581;
+            m_sid.input(0);
+            break;
+        case SidConfig::MOS8580:
+            chipModel = reSIDfp::MOS8580;
+            m_sid.input(digiboost ? -32768 : 0);
+            break;
+        default:
+            m_status = false;
+            m_error = ERR_INVALID_CHIP;
+            return;
+    }
+
+    m_sid.setChipModel(chipModel);
+    m_status = true;
+}
+
+}
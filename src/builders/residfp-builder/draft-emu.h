@@ -0,0 +1,76 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef DRAFT_EMU_H
+#define DRAFT_EMU_H
+
+#include <stdint.h>
+
+#include "residfp/DraftSID.h"
+#include "sidplayfp/SidConfig.h"
+#include "sidemu.h"
+#include "Event.h"
+
+#include "sidcxx11.h"
+
+
+class sidbuilder;
+
+namespace libsidplayfp
+{
+
+class DraftSID final : public sidemu
+{
+private:
+    reSIDfp::DraftSID &m_sid;
+
+public:
+    static const char* getCredits();
+
+public:
+    DraftSID(sidbuilder *builder);
+    ~DraftSID() override;
+
+    bool getStatus() const { return m_status; }
+
+    uint8_t read(uint_least8_t addr) override;
+    void write(uint_least8_t addr, uint8_t data) override;
+    void OS_write(uint_least8_t addr, uint8_t data) override;
+
+    void sidvis(uint_least8_t addr, bool env_disable, bool tw_enable, bool kink_disable) override;
+
+    // c64sid functions
+    void reset(uint8_t volume) override;
+
+    // Standard SID emu functions
+    void clock() override;
+
+    void sampling(float systemclock, float freq,
+        SidConfig::sampling_method_t method, bool) override;
+
+    void model(SidConfig::sid_model_t model, bool digiboost) override;
+
+    // Specific to draft
+    void filter(bool enable);
+};
+
+}
+
+#endif // DRAFT_EMU_H
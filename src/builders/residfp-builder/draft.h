@@ -0,0 +1,68 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef DRAFT_H
+#define DRAFT_H
+
+#include "sidplayfp/sidbuilder.h"
+#include "sidplayfp/siddefs.h"
+
+/**
+ * Draft quality SID Builder Class.
+ *
+ * Creates fast approximate emulations meant for
+ * previews, thumbnails and batch analysis.
+ * Oscillators and envelopes are exact while
+ * the filter and mixer are simplified models.
+ */
+class SID_EXTERN DraftSIDBuilder: public sidbuilder
+{
+public:
+    DraftSIDBuilder(const char * const name) :
+        sidbuilder(name) {}
+    ~DraftSIDBuilder();
+
+    /**
+     * Available sids.
+     *
+     * @return the number of available sids, 0 = endless.
+     */
+    unsigned int availDevices() const { return 0; }
+
+    /**
+     * Create the sid emu.
+     *
+     * @param sids the number of required sid emu
+     */
+    unsigned int create(unsigned int sids);
+
+    const char *credits() const;
+
+    /// @name global settings
+    /// Settings that affect all SIDs.
+    //@{
+    /**
+     * enable/disable filter.
+     */
+    void filter(bool enable);
+    //@}
+};
+
+#endif // DRAFT_H
@@ -47,7 +47,8 @@ unsigned int ReSIDfpBuilder::create(unsigned int sids)
     {
         try
         {
-            sidobjs.insert(new libsidplayfp::ReSIDfp(this));
+            libsidplayfp::sidemu *sid = fromPool();
+            sidobjs.insert(sid != nullptr ? sid : new libsidplayfp::ReSIDfp(this));
         }
         // Memory alloc failed?
         catch (std::bad_alloc const &)
@@ -95,3 +96,9 @@ void ReSIDfpBuilder::combinedWaveformsStrength(SidConfig::sid_cw_t cws)
     for (libsidplayfp::sidemu* e: sidobjs)
         static_cast<libsidplayfp::ReSIDfp*>(e)->combinedWaveforms(cws);
 }
+
+void ReSIDfpBuilder::lockstep(bool enable)
+{
+    for (libsidplayfp::sidemu* e: sidobjs)
+        static_cast<libsidplayfp::ReSIDfp*>(e)->lockstep(enable);
+}
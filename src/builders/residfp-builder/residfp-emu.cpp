@@ -78,10 +78,116 @@ void ReSIDfp::filter8580Curve(double filterCurve)
    m_sid.setFilter8580Curve(filterCurve);
 }
 
+void ReSIDfp::oscillatorEvents(bool enable)
+{
+   m_sid.enableOscillatorEvents(enable);
+}
+
+unsigned int ReSIDfp::getOscillatorEvents(OscillatorEvent* events, unsigned int count)
+{
+    reSIDfp::OscillatorEventBuffer* buffer = m_sid.getOscillatorEvents();
+
+    if (buffer == nullptr)
+        return 0;
+
+    reSIDfp::OscillatorEvent event;
+    unsigned int n = 0;
+
+    while ((n < count) && buffer->read(&event, 1))
+    {
+        events[n].sample = event.sample;
+        events[n].voice = event.voice;
+        events[n].type = static_cast<OscillatorEvent::type_t>(event.type);
+        n++;
+    }
+
+    return n;
+}
+
+void ReSIDfp::stateSnapshots(unsigned int interval)
+{
+   m_sid.enableStateSnapshots(interval);
+}
+
+unsigned int ReSIDfp::getStateSnapshots(SidState* states, unsigned int count)
+{
+    reSIDfp::SIDStateBuffer* buffer = m_sid.getStateSnapshots();
+
+    if (buffer == nullptr)
+        return 0;
+
+    const unsigned int n = std::min(buffer->available(), count);
+
+    for (unsigned int j = 0; j < n; j++)
+    {
+        const unsigned int i = buffer->index(j);
+        SidState& state = states[j];
+
+        state.sample = buffer->sample[i];
+
+        for (int v = 0; v < 3; v++)
+        {
+            state.voice[v].freq = buffer->freq[v][i];
+            state.voice[v].pw = buffer->pw[v][i];
+            state.voice[v].waveform = buffer->waveform[v][i];
+            state.voice[v].envelope = buffer->envelope[v][i];
+            state.voice[v].envState = static_cast<SidState::env_state_t>(buffer->envelopeState[v][i]);
+        }
+
+        state.fc = buffer->fc[i];
+        state.resFilt = buffer->resFilt[i];
+        state.modeVol = buffer->modeVol[i];
+    }
+
+    buffer->consume(n);
+
+    return n;
+}
+
+void ReSIDfp::waveformCapture(unsigned int decimation, bool minMax)
+{
+    m_sid.enableWaveformCapture(decimation, minMax);
+}
+
+unsigned int ReSIDfp::getWaveformCapture(WaveformSample* samples, unsigned int count)
+{
+    reSIDfp::WaveformCaptureBuffer* buffer = m_sid.getWaveformCapture();
+
+    if (buffer == nullptr)
+        return 0;
+
+    const unsigned int n = std::min(buffer->available(), count);
+
+    for (int v = 0; v < 3; v++)
+    {
+        const unsigned short* const waveMin = buffer->waveMin[v];
+        const unsigned short* const waveMax = buffer->waveMax[v];
+        const unsigned char* const envMin = buffer->envMin[v];
+        const unsigned char* const envMax = buffer->envMax[v];
+
+        for (unsigned int j = 0; j < n; j++)
+        {
+            const unsigned int i = buffer->index(j);
+
+            samples[j].voice[v].waveMin = waveMin[i];
+            samples[j].voice[v].waveMax = waveMax[i];
+            samples[j].voice[v].envMin = envMin[i];
+            samples[j].voice[v].envMax = envMax[i];
+        }
+    }
+
+    buffer->consume(n);
+
+    return n;
+}
+
 // Standard component options
 void ReSIDfp::reset(uint8_t volume)
 {
+    m_pendingWrites.clear();
     m_accessClk = 0;
+    if (m_multiSID)
+        m_multiSID->reset();
     m_sid.reset();
     m_sid.write(0x18, volume);
 }
@@ -94,27 +200,142 @@ uint8_t ReSIDfp::read(uint_least8_t addr)
 
 void ReSIDfp::write(uint_least8_t addr, uint8_t data)
 {
+    if (m_deferWrites)
+    {
+        m_pendingWrites.push_back({ eventScheduler->getTime(EVENT_CLOCK_PHI1), PendingWrite::WRITE, addr, data });
+        return;
+    }
+
     clock();
     m_sid.write(addr, data);
 }
 
 void ReSIDfp::OS_write(uint_least8_t addr, uint8_t data)
 {
+    if (m_deferWrites)
+    {
+        m_pendingWrites.push_back({ eventScheduler->getTime(EVENT_CLOCK_PHI1), PendingWrite::OS_WRITE, addr, data });
+        return;
+    }
+
     clock();
     m_sid.OS_write(addr, data);
 }
 
 void ReSIDfp::sidvis(uint_least8_t addr, bool env_disable, bool tw_enable, bool kink_disable)
 {
+    if (m_deferWrites)
+    {
+        const uint8_t flags = (env_disable ? 1 : 0) | (tw_enable ? 2 : 0) | (kink_disable ? 4 : 0);
+        m_pendingWrites.push_back({ eventScheduler->getTime(EVENT_CLOCK_PHI1), PendingWrite::SIDVIS, addr, flags });
+        return;
+    }
+
     clock();
     m_sid.sidvis(addr, env_disable, tw_enable, kink_disable);
 }
 
 void ReSIDfp::clock()
 {
-    const event_clock_t cycles = eventScheduler->getTime(EVENT_CLOCK_PHI1) - m_accessClk;
+    if (m_leader != nullptr)
+    {
+        m_leader->clockGroup();
+        return;
+    }
+
+    if (!m_pendingWrites.empty())
+        runPendingWrites();
+
+    clockTo(eventScheduler->getTime(EVENT_CLOCK_PHI1));
+}
+
+void ReSIDfp::clockTo(event_clock_t time)
+{
+    const event_clock_t cycles = time - m_accessClk;
     m_accessClk += cycles;
-    m_bufferpos += m_sid.clock(cycles, m_buffer+m_bufferpos);
+
+    if (m_silent)
+        m_sid.clockSilent(cycles);
+    else
+        m_bufferpos += m_sid.clock(cycles, m_buffer+m_bufferpos);
+}
+
+void ReSIDfp::runPendingWrites()
+{
+    for (const PendingWrite& w: m_pendingWrites)
+    {
+        clockTo(w.time);
+
+        switch (w.type)
+        {
+        case PendingWrite::WRITE:
+            m_sid.write(w.addr, w.data);
+            break;
+        case PendingWrite::OS_WRITE:
+            m_sid.OS_write(w.addr, w.data);
+            break;
+        case PendingWrite::SIDVIS:
+            m_sid.sidvis(w.addr, w.data & 1, w.data & 2, w.data & 4);
+            break;
+        }
+    }
+
+    m_pendingWrites.clear();
+}
+
+bool ReSIDfp::deferWrites(bool enable)
+{
+    if (!enable || (m_leader != nullptr))
+    {
+        if (!m_pendingWrites.empty())
+        {
+            if (eventScheduler != nullptr)
+                runPendingWrites();
+            else
+                m_pendingWrites.clear();
+        }
+
+        m_deferWrites = false;
+        return !enable;
+    }
+
+    m_deferWrites = true;
+    return true;
+}
+
+bool ReSIDfp::silent(bool enable)
+{
+    m_silent = enable;
+    return true;
+}
+
+bool ReSIDfp::recycle()
+{
+    if (m_leader != nullptr)
+        m_leader->ungroup();
+    ungroup();
+
+    deferWrites(false);
+    unlock();
+
+    m_sid.restoreDefaults();
+    m_lockstep = false;
+    m_silent = false;
+
+    isMuted.reset();
+    isFilterDisabled = false;
+    isNotFiltered.reset();
+    isNoEnvelopesEnabled = false;
+    disableEnvelopes = false;
+    isTriggerWavesEnabled = false;
+    isNoKinksEnabled = false;
+
+    m_bufferpos = 0;
+    reset(0);
+
+    m_status = true;
+    m_error = "N/A";
+    return true;
 }
 
 void ReSIDfp::filter(bool enable)
@@ -140,18 +361,132 @@ void ReSIDfp::sampling(float systemclock, float freq,
         return;
     }
 
+    // Keep the resampler if nothing changed
+    const bool unchanged = m_samplingSet
+        && (m_systemClock == systemclock)
+        && (m_sampleFreq == freq)
+        && (m_sampleMethod == sampleMethod);
+
+    if (!unchanged)
+    {
+        try
+        {
+            m_sid.setSamplingParameters(systemclock, sampleMethod, freq);
+        }
+        catch (reSIDfp::SIDError const &)
+        {
+            m_status = false;
+            m_error = ERR_UNSUPPORTED_FREQ;
+            return;
+        }
+    }
+
+    m_systemClock = systemclock;
+    m_sampleFreq = freq;
+    m_sampleMethod = sampleMethod;
+    m_samplingSet = true;
+
+    if (m_leader != nullptr)
+        m_leader->updateGroupSampling();
+
+    m_status = true;
+}
+
+bool ReSIDfp::lockstep(const std::vector<sidemu*>& chips, const std::vector<float>& gains, unsigned int channels)
+{
+    ungroup();
+
+    if (!m_lockstep
+        || (chips.size() < 2)
+        || (chips.size() > reSIDfp::MultiSID::MAX_CHIPS)
+        || (chips.front() != this))
+        return false;
+
+    std::vector<ReSIDfp*> group;
+    reSIDfp::SID* sids[reSIDfp::MultiSID::MAX_CHIPS];
+
+    for (sidemu* chip: chips)
+    {
+        // All the chips must be ours
+        if (chip->builder() != builder())
+            return false;
+
+        ReSIDfp* emu = static_cast<ReSIDfp*>(chip);
+        sids[group.size()] = &emu->m_sid;
+        group.push_back(emu);
+    }
+
+    m_multiSID.reset(new reSIDfp::MultiSID());
+
     try
     {
-        m_sid.setSamplingParameters(systemclock, sampleMethod, freq);
+        m_multiSID->setChips(sids, group.size(), gains.data(), channels);
     }
     catch (reSIDfp::SIDError const &)
     {
-        m_status = false;
-        m_error = ERR_UNSUPPORTED_FREQ;
+        m_multiSID.reset();
+        return false;
+    }
+
+    m_group = group;
+    for (ReSIDfp* emu: m_group)
+    {
+        emu->m_leader = this;
+        emu->m_accessClk = m_accessClk;
+    }
+
+    updateGroupSampling();
+
+    return true;
+}
+
+void ReSIDfp::ungroup()
+{
+    if (m_group.empty())
+        return;
+
+    for (ReSIDfp* emu: m_group)
+    {
+        emu->m_leader = nullptr;
+
+        // Restore the chip's own resampler
+        if (emu->m_samplingSet)
+            emu->m_sid.setSamplingParameters(emu->m_systemClock, emu->m_sampleMethod, emu->m_sampleFreq);
+    }
+
+    m_group.clear();
+    m_multiSID.reset();
+}
+
+void ReSIDfp::updateGroupSampling()
+{
+    if (m_samplingSet)
+        m_multiSID->setSamplingParameters(m_systemClock, m_sampleMethod, m_sampleFreq);
+}
+
+void ReSIDfp::clockGroup()
+{
+    const event_clock_t cycles = eventScheduler->getTime(EVENT_CLOCK_PHI1) - m_accessClk;
+
+    if (m_silent)
+    {
+        for (ReSIDfp* emu: m_group)
+        {
+            emu->m_sid.clockSilent(cycles);
+            emu->m_accessClk += cycles;
+        }
         return;
     }
 
-    m_status = true;
+    // The second channel goes to the second chip's buffer
+    short* const buf[2] = { m_buffer + m_bufferpos, m_group[1]->m_buffer + m_bufferpos };
+    const int samples = m_multiSID->clock(cycles, buf);
+
+    for (ReSIDfp* emu: m_group)
+    {
+        emu->m_accessClk += cycles;
+        emu->m_bufferpos += samples;
+    }
 }
 
 // Set the emulated SID model
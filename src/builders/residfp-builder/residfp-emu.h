@@ -25,6 +25,10 @@
 
 #include <stdint.h>
 
+#include <memory>
+#include <vector>
+
+#include "residfp/MultiSID.h"
 #include "residfp/SID.h"
 #include "sidplayfp/SidConfig.h"
 #include "sidemu.h"
@@ -40,9 +44,66 @@ namespace libsidplayfp
 
 class ReSIDfp final : public sidemu
 {
+private:
+    /// A register write waiting for the chip to be clocked
+    struct PendingWrite
+    {
+        enum type_t : uint8_t
+        {
+            WRITE,
+            OS_WRITE,
+            SIDVIS
+        };
+
+        event_clock_t time;
+        type_t type;
+        uint8_t addr;
+        uint8_t data;
+    };
+
 private:
     reSIDfp::SID &m_sid;
 
+    /// Writes logged since the last clock
+    std::vector<PendingWrite> m_pendingWrites;
+
+    /// Log the writes instead of clocking the chip
+    bool m_deferWrites = false;
+
+    /// Chips clocked together, owned by the first one
+    std::unique_ptr<reSIDfp::MultiSID> m_multiSID;
+
+    /// The chips in the group, first one only
+    std::vector<ReSIDfp*> m_group;
+
+    /// The first chip of the group this chip belongs to
+    ReSIDfp* m_leader = nullptr;
+
+    /// Sampling parameters
+    //@{
+    double m_systemClock = 0.;
+    double m_sampleFreq = 0.;
+    reSIDfp::SamplingMethod m_sampleMethod = reSIDfp::DECIMATE;
+    bool m_samplingSet = false;
+    //@}
+
+    /// Allow clocking together with other chips
+    bool m_lockstep = false;
+
+    /// Clock without producing audio
+    bool m_silent = false;
+
+private:
+    void clockTo(event_clock_t time);
+
+    void runPendingWrites();
+
+    void clockGroup();
+
+    void ungroup();
+
+    void updateGroupSampling();
+
 public:
     static const char* getCredits();
 
@@ -75,6 +136,24 @@ public:
     void filter6581Range(double adjustment);
     void filter8580Curve(double filterCurve);
     void combinedWaveforms(SidConfig::sid_cw_t cws);
+    void lockstep(bool enable) { m_lockstep = enable; }
+
+    void oscillatorEvents(bool enable) override;
+    unsigned int getOscillatorEvents(OscillatorEvent* events, unsigned int count) override;
+
+    void stateSnapshots(unsigned int interval) override;
+    unsigned int getStateSnapshots(SidState* states, unsigned int count) override;
+
+    void waveformCapture(unsigned int decimation, bool minMax) override;
+    unsigned int getWaveformCapture(WaveformSample* samples, unsigned int count) override;
+
+    bool lockstep(const std::vector<sidemu*>& chips, const std::vector<float>& gains, unsigned int channels) override;
+
+    bool deferWrites(bool enable) override;
+
+    bool silent(bool enable) override;
+
+    bool recycle() override;
 };
 
 }
@@ -88,6 +88,21 @@ public:
      */
     void combinedWaveformsStrength(SidConfig::sid_cw_t cws);
 
+    /**
+     * Clock all the chips of multi SID tunes together
+     * and mix them before resampling, so only one resampler
+     * per output channel is run.
+     * Worth it with the RESAMPLE_INTERPOLATE sampling method,
+     * while with INTERPOLATE it's usually slower.
+     * Output is equivalent within rounding, except that
+     * sample indexes reported by the single chips
+     * count cycles instead of samples.
+     * Takes effect on the next configuration.
+     *
+     * @param enable (default false)
+     */
+    void lockstep(bool enable);
+
     //@}
 };
 
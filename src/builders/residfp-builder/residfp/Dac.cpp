@@ -24,6 +24,10 @@
 
 #include "sidcxx11.h"
 
+#ifdef RESIDFP_PREBUILT_TABLES
+#  include "PrebuiltTables.h"
+#endif
+
 namespace reSIDfp
 {
 // MOSFET_LEAKAGE_6581 = 0.0075;
@@ -32,6 +36,9 @@ namespace reSIDfp
 constexpr double MOSFET_LEAKAGE_6581 = 0;
 constexpr double MOSFET_LEAKAGE_8580 = 0;
 
+constexpr unsigned int ENV_DAC_BITS = 8;
+constexpr unsigned int OSC_DAC_BITS = 12;
+
 Dac::Dac(unsigned int bits) :
     dac(new double[bits]),
     dacLength(bits)
@@ -121,4 +128,74 @@ void Dac::kinkedDac(ChipModel chipModel)
     }
 }
 
+void Dac::buildEnvelopeTable(ChipModel chipModel, float table[])
+{
+    Dac dacBuilder(ENV_DAC_BITS);
+    dacBuilder.kinkedDac(chipModel);
+
+    for (unsigned int i = 0; i < (1 << ENV_DAC_BITS); i++)
+    {
+        table[i] = static_cast<float>(dacBuilder.getOutput(i));
+    }
+}
+
+void Dac::buildWaveformTable(ChipModel chipModel, float table[])
+{
+    Dac dacBuilder(OSC_DAC_BITS);
+    dacBuilder.kinkedDac(chipModel);
+
+    const double offset = dacBuilder.getOutput(0x7ff);
+
+    for (unsigned int i = 0; i < (1 << OSC_DAC_BITS); i++)
+    {
+        const double dacValue = dacBuilder.getOutput(i);
+        table[i] = static_cast<float>(dacValue - offset);
+    }
+}
+
+#ifdef RESIDFP_PREBUILT_TABLES
+const float* Dac::getEnvelopeTable(ChipModel chipModel)
+{
+    return prebuiltEnvDAC[chipModel == MOS6581 ? 0 : 1];
+}
+
+const float* Dac::getWaveformTable(ChipModel chipModel)
+{
+    return prebuiltOscDAC[chipModel == MOS6581 ? 0 : 1];
+}
+#else
+/**
+ * DAC tables for a chip model, built on first use.
+ */
+struct DacTables
+{
+    float env[256];
+    float osc[4096];
+
+    DacTables(ChipModel model)
+    {
+        Dac::buildEnvelopeTable(model, env);
+        Dac::buildWaveformTable(model, osc);
+    }
+};
+
+static const DacTables& getDacTables(ChipModel model)
+{
+    static const DacTables tables6581(MOS6581);
+    static const DacTables tables8580(MOS8580);
+
+    return (model == MOS6581) ? tables6581 : tables8580;
+}
+
+const float* Dac::getEnvelopeTable(ChipModel chipModel)
+{
+    return getDacTables(chipModel).env;
+}
+
+const float* Dac::getWaveformTable(ChipModel chipModel)
+{
+    return getDacTables(chipModel).osc;
+}
+#endif
+
 } // namespace reSIDfp
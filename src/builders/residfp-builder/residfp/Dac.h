@@ -113,6 +113,41 @@ public:
      * @return the analog output value
      */
     double getOutput(unsigned int input) const;
+
+    /**
+     * Build the envelope DAC table used by the voices.
+     *
+     * @param chipModel 6581 or 8580
+     * @param table the output table, 256 entries
+     */
+    static void buildEnvelopeTable(ChipModel chipModel, float table[]);
+
+    /**
+     * Build the waveform DAC table used by the voices,
+     * centered around the output of the midpoint value.
+     *
+     * @param chipModel 6581 or 8580
+     * @param table the output table, 4096 entries
+     */
+    static void buildWaveformTable(ChipModel chipModel, float table[]);
+
+    /**
+     * Get the envelope DAC table for a chip model,
+     * shared among all instances.
+     *
+     * @param chipModel 6581 or 8580
+     * @return the table, 256 entries
+     */
+    static const float* getEnvelopeTable(ChipModel chipModel);
+
+    /**
+     * Get the waveform DAC table for a chip model,
+     * shared among all instances.
+     *
+     * @param chipModel 6581 or 8580
+     * @return the table, 4096 entries
+     */
+    static const float* getWaveformTable(ChipModel chipModel);
 };
 
 } // namespace reSIDfp
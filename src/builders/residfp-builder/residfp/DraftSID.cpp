@@ -0,0 +1,452 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "DraftSID.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Dac.h"
+#include "SID.h"
+#include "WaveformCalculator.h"
+#include "resample/ZeroOrderResampler.h"
+
+#include "sidcxx11.h"
+
+namespace reSIDfp
+{
+
+#ifndef M_PI
+#  define M_PI 3.14159265358979323846
+#endif
+
+/// Maximum number of cycles between evaluations of the analog part
+constexpr unsigned int MAX_DIVISOR = 8;
+
+/// Output level, matched to the full emulation
+//@{
+constexpr float GAIN_6581 = 395.f;
+constexpr float GAIN_8580 = 195.f;
+//@}
+
+/// Output level with zero volume, matched to the full emulation
+//@{
+constexpr float OFFSET_6581 = -8470.f;
+constexpr float OFFSET_8580 = -2515.f;
+//@}
+
+/**
+ * Mixer DC offset relative to the voice output range,
+ * matched to the step caused by volume changes
+ * in the full emulation.
+ */
+//@{
+constexpr float DC_6581 = 1.36f;
+constexpr float DC_8580 = -0.27f;
+//@}
+
+/**
+ * Keeps the filter state away from denormals
+ * when there's no input.
+ */
+constexpr float ANTI_DENORMAL = 1e-18f;
+
+/**
+ * Approximate cutoff frequency curve of a typical 6581,
+ * as pairs of FC register value and frequency in Hz.
+ */
+static const float cutoff6581[][2] =
+{
+    {    0,   220 },
+    {  128,   230 },
+    {  256,   250 },
+    {  384,   300 },
+    {  512,   420 },
+    {  640,   780 },
+    {  768,  1600 },
+    {  832,  2300 },
+    {  896,  3200 },
+    {  960,  4300 },
+    {  992,  5000 },
+    { 1008,  5400 },
+    { 1016,  5700 },
+    { 1023,  6000 },
+    { 1024,  4600 },
+    { 1032,  4800 },
+    { 1056,  5300 },
+    { 1088,  6000 },
+    { 1120,  6600 },
+    { 1152,  7200 },
+    { 1280,  9500 },
+    { 1408, 12000 },
+    { 1536, 14500 },
+    { 1664, 16000 },
+    { 1792, 17100 },
+    { 1920, 17700 },
+    { 2047, 18000 },
+};
+
+/**
+ * Cutoff frequency of the 8580, roughly linear
+ * from 30Hz to 12.5kHz.
+ */
+static inline double getCutoff8580(unsigned int fc)
+{
+    return 30. + fc * ((12500. - 30.) / 2047.);
+}
+
+static double getCutoff6581(unsigned int fc)
+{
+    const int n = sizeof(cutoff6581) / sizeof(cutoff6581[0]);
+
+    int i = 1;
+    while ((i < n - 1) && (cutoff6581[i][0] < fc))
+        i++;
+
+    const double x0 = cutoff6581[i - 1][0];
+    const double x1 = cutoff6581[i][0];
+    const double y0 = cutoff6581[i - 1][1];
+    const double y1 = cutoff6581[i][1];
+
+    return y0 + (y1 - y0) * (fc - x0) / (x1 - x0);
+}
+
+DraftSID::DraftSID() :
+    resampler(nullptr),
+    clockFrequency(985248.),
+    divisor(MAX_DIVISOR),
+    nextOutput(MAX_DIVISOR),
+    fc(0),
+    resFilt(0),
+    modeVol(0),
+    busValue(0),
+    enabled(true),
+    w(0.f),
+    damping(1.f),
+    Vlp(0.f),
+    Vbp(0.f),
+    Ve(0.f),
+    dc(0.f),
+    gain(0.f),
+    offset(0.f)
+{
+    voice[0].setOtherVoices(voice[2], voice[1]);
+    voice[1].setOtherVoices(voice[0], voice[2]);
+    voice[2].setOtherVoices(voice[1], voice[0]);
+
+    setChipModel(MOS8580);
+    reset();
+}
+
+DraftSID::~DraftSID() = default;
+
+void DraftSID::setChipModel(ChipModel model)
+{
+    switch (model)
+    {
+    case MOS6581:
+        scaleFactor = 3;
+        break;
+
+    case MOS8580:
+        scaleFactor = 5;
+        break;
+
+    default:
+        throw SIDError("Unknown chip type");
+    }
+
+    this->model = model;
+
+    matrix_t* wavetables = WaveformCalculator::getInstance()->getWaveTable();
+    matrix_t* pulldowntables = WaveformCalculator::getInstance()->buildPulldownTable(model, AVERAGE);
+
+    const bool is6581 = model == MOS6581;
+
+    for (int i = 0; i < 3; i++)
+    {
+        voice[i].setEnvDAC(Dac::getEnvelopeTable(model));
+        voice[i].setWavDAC(Dac::getWaveformTable(model));
+        voice[i].wave()->setModel(is6581);
+        voice[i].wave()->setWaveformModels(wavetables);
+        voice[i].wave()->setPulldownModels(pulldowntables);
+    }
+
+    updateFilter();
+}
+
+void DraftSID::reset()
+{
+    for (int i = 0; i < 3; i++)
+    {
+        voice[i].reset();
+    }
+
+    externalFilter.reset();
+
+    if (resampler.get())
+    {
+        resampler->reset();
+    }
+
+    fc = 0;
+    resFilt = 0;
+    modeVol = 0;
+    busValue = 0;
+    Vlp = 0.f;
+    Vbp = 0.f;
+    nextOutput = divisor;
+
+    updateFilter();
+    voiceSync(false);
+}
+
+void DraftSID::input(int value)
+{
+    Ve = value / 32768.f;
+}
+
+void DraftSID::enableFilter(bool enable)
+{
+    enabled = enable;
+}
+
+void DraftSID::updateFilter()
+{
+    const bool is6581 = model == MOS6581;
+
+    const double cutoff = is6581 ? getCutoff6581(fc) : getCutoff8580(fc);
+    const double rate = clockFrequency / divisor;
+    w = static_cast<float>(2. * std::sin(M_PI * std::min(cutoff / rate, 0.25)));
+
+    // 1/Q ~ 2^((4 - res)/8), with a floor keeping
+    // the filter from self oscillating
+    const unsigned int res = resFilt >> 4;
+    damping = static_cast<float>(std::max(std::pow(2., (4. - res) / 8.), 0.1));
+
+    dc = is6581 ? DC_6581 : DC_8580;
+    offset = is6581 ? OFFSET_6581 : OFFSET_8580;
+    gain = (is6581 ? GAIN_6581 : GAIN_8580) * (modeVol & 0x0f);
+}
+
+void DraftSID::voiceSync(bool sync)
+{
+    if (sync)
+    {
+        // Synchronize the 3 waveform generators.
+        for (int i = 0; i < 3; i++)
+        {
+            voice[i].wave()->synchronize();
+        }
+    }
+
+    // Calculate the time to next voice sync
+    nextVoiceSync = std::numeric_limits<int>::max();
+
+    for (int i = 0; i < 3; i++)
+    {
+        WaveformGenerator* const wave = voice[i].wave();
+        const unsigned int freq = wave->readFreq();
+
+        if (wave->readTest() || freq == 0 || !voice[i].wave()->readFollowingVoiceSync())
+        {
+            continue;
+        }
+
+        const unsigned int accumulator = wave->readAccumulator();
+        const unsigned int thisVoiceSync = ((0x7fffff - accumulator) & 0xffffff) / freq + 1;
+
+        if (thisVoiceSync < nextVoiceSync)
+        {
+            nextVoiceSync = thisVoiceSync;
+        }
+    }
+}
+
+unsigned char DraftSID::read(int offset)
+{
+    switch (offset)
+    {
+    case 0x19: // X value of paddle
+    case 0x1a: // Y value of paddle
+        busValue = 0xff;
+        break;
+
+    case 0x1b: // Voice #3 waveform output
+        // The output is evaluated at the reduced rate, refresh it
+        voice[2].wave()->output();
+        busValue = voice[2].wave()->readOSC();
+        break;
+
+    case 0x1c: // Voice #3 ADSR output
+        busValue = voice[2].envelope()->readENV();
+        break;
+
+    default:
+        break;
+    }
+
+    return busValue;
+}
+
+void DraftSID::write(int offset, unsigned char value)
+{
+    busValue = value;
+
+    if (offset < 0x15)
+    {
+        Voice& v = voice[offset / 7];
+
+        switch (offset % 7)
+        {
+        case 0: v.wave()->writeFREQ_LO(value); break;
+        case 1: v.wave()->writeFREQ_HI(value); break;
+        case 2: v.wave()->writePW_LO(value); break;
+        case 3: v.wave()->writePW_HI(value); break;
+        case 4: v.writeCONTROL_REG(value); break;
+        case 5: v.envelope()->writeATTACK_DECAY(value); break;
+        case 6: v.envelope()->writeSUSTAIN_RELEASE(value); break;
+        }
+    }
+    else
+    {
+        switch (offset)
+        {
+        case 0x15: // Filter cut off frequency bits #0-#2
+            fc = (fc & 0x7f8) | (value & 0x007);
+            break;
+
+        case 0x16: // Filter cut off frequency bits #3-#10
+            fc = (value << 3 & 0x7f8) | (fc & 0x007);
+            break;
+
+        case 0x17: // Filter control
+            resFilt = value;
+            break;
+
+        case 0x18: // Volume and filter modes
+            modeVol = value;
+            break;
+
+        default:
+            break;
+        }
+
+        updateFilter();
+    }
+
+    // Update voicesync just in case.
+    voiceSync(false);
+}
+
+void DraftSID::setSamplingParameters(double clockFrequency, double samplingFrequency)
+{
+    // Keep the internal rate at least twice the output rate
+    const double ratio = clockFrequency / (2. * samplingFrequency);
+
+    if (ratio < 1.)
+    {
+        throw SIDError("Unsupported sampling frequency");
+    }
+
+    this->clockFrequency = clockFrequency;
+    divisor = std::min(static_cast<unsigned int>(ratio), MAX_DIVISOR);
+    nextOutput = divisor;
+
+    const double rate = clockFrequency / divisor;
+
+    externalFilter.setClockFrequency(rate);
+    resampler.reset(new ZeroOrderResampler(rate, samplingFrequency));
+
+    updateFilter();
+}
+
+int DraftSID::output()
+{
+    const unsigned int filt = enabled ? resFilt : 0;
+
+    float Vsum = ANTI_DENORMAL;
+    float Vmix = dc;
+
+    const float V1 = voice[0].output();
+    const float V2 = voice[1].output();
+    // Voice 3 is silenced by voice3off if it is not routed through the filter.
+    const float V3 = ((filt & 0x04) || !(modeVol & 0x80)) ? voice[2].output() : 0.f;
+
+    ((filt & 0x01) ? Vsum : Vmix) += V1;
+    ((filt & 0x02) ? Vsum : Vmix) += V2;
+    ((filt & 0x04) ? Vsum : Vmix) += V3;
+    ((filt & 0x08) ? Vsum : Vmix) += Ve;
+
+    // Chamberlin state variable filter
+    Vlp += w * Vbp;
+    const float Vhp = Vsum - Vlp - damping * Vbp;
+    Vbp += w * Vhp;
+
+    if (modeVol & 0x10) Vmix += Vlp;
+    if (modeVol & 0x20) Vmix += Vbp;
+    if (modeVol & 0x40) Vmix += Vhp;
+
+    return static_cast<int>(Vmix * gain + offset);
+}
+
+int DraftSID::clock(unsigned int cycles, short* buf)
+{
+    int s = 0;
+
+    while (cycles != 0)
+    {
+        const unsigned int delta_t = std::min(std::min(nextVoiceSync, nextOutput), cycles);
+
+        if (likely(delta_t > 0))
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                voice[i].wave()->clock(delta_t);
+                voice[i].envelope()->clock(delta_t);
+            }
+
+            cycles -= delta_t;
+            nextVoiceSync -= delta_t;
+            nextOutput -= delta_t;
+        }
+
+        if (unlikely(nextVoiceSync == 0))
+        {
+            voiceSync(true);
+        }
+
+        if (nextOutput == 0)
+        {
+            nextOutput = divisor;
+
+            const int c64Output = externalFilter.clock(output());
+            if (resampler->input(c64Output))
+            {
+                buf[s++] = resampler->getOutput(scaleFactor);
+            }
+        }
+    }
+
+    return s;
+}
+
+} // namespace reSIDfp
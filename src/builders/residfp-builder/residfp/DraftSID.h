@@ -0,0 +1,216 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef DRAFTSID_H
+#define DRAFTSID_H
+
+#include <memory>
+
+#include "siddefs-fp.h"
+#include "ExternalFilter.h"
+#include "Voice.h"
+
+#include "sidcxx11.h"
+
+namespace reSIDfp
+{
+
+class Resampler;
+
+/**
+ * Fast approximate MOS6581/MOS8580 emulation,
+ * meant for previews and analysis rather than listening.
+ *
+ * The digital part, oscillators and envelopes, is the same
+ * as in SID and is clocked exactly, skipping ahead between events.
+ * The analog part is evaluated only once every few cycles:
+ * the filter is an ideal linear state variable filter with an
+ * approximated cutoff curve, the mixer is linear and the output
+ * is decimated with the zero order resampler.
+ */
+class DraftSID
+{
+private:
+    /// Resampler used by audio generation code.
+    std::unique_ptr<Resampler> resampler;
+
+    /// External filter, clocked at the reduced rate.
+    ExternalFilter externalFilter;
+
+    /// SID voices
+    Voice voice[3];
+
+    /// Used to amplify the output by x/2 to get an adequate playback volume
+    int scaleFactor;
+
+    /// System clock frequency.
+    double clockFrequency;
+
+    /// Cycles between evaluations of the analog part.
+    unsigned int divisor;
+
+    /// Time until the next evaluation of the analog part.
+    unsigned int nextOutput;
+
+    /// Time until #voiceSync must be run.
+    unsigned int nextVoiceSync;
+
+    /// Currently active chip model.
+    ChipModel model;
+
+    /// Filter cutoff register value.
+    unsigned int fc;
+
+    /// Resonance/Filter register value.
+    unsigned char resFilt;
+
+    /// Mode/Volume register value.
+    unsigned char modeVol;
+
+    /// Last written value
+    unsigned char busValue;
+
+    /// Filter enabled.
+    bool enabled;
+
+    /// Filter coefficients
+    //@{
+    float w;
+    float damping;
+    //@}
+
+    /// Filter state
+    //@{
+    float Vlp;
+    float Vbp;
+    //@}
+
+    /// External input.
+    float Ve;
+
+    /// Mixer DC offset, driving the volume register digis on the 6581.
+    float dc;
+
+    /// Output gain, including the volume setting.
+    float gain;
+
+    /// Output level with zero volume.
+    float offset;
+
+private:
+    /**
+     * Calculate the number of cycles according to current parameters
+     * that it takes to reach sync.
+     *
+     * @param sync whether to do the actual voice synchronization
+     */
+    void voiceSync(bool sync);
+
+    /**
+     * Update the filter coefficients and the mixer gain
+     * from the register values.
+     */
+    void updateFilter();
+
+    /**
+     * Evaluate voices, filter and mixer.
+     *
+     * @return the mixer output, signed 16 bit
+     */
+    int output();
+
+public:
+    DraftSID();
+    ~DraftSID();
+
+    /**
+     * Set chip model.
+     *
+     * @param model chip model to use
+     * @throw SIDError
+     */
+    void setChipModel(ChipModel model);
+
+    /**
+     * Get currently emulated chip model.
+     */
+    ChipModel getChipModel() const { return model; }
+
+    /**
+     * SID reset.
+     */
+    void reset();
+
+    /**
+     * 16-bit input (EXT IN).
+     *
+     * @param value input level to set
+     */
+    void input(int value);
+
+    /**
+     * Read registers.
+     * Write only registers return the last written value,
+     * the bus value fading is not emulated.
+     *
+     * @param offset SID register to read
+     * @return value read from chip
+     */
+    unsigned char read(int offset);
+
+    /**
+     * Write registers.
+     *
+     * @param offset chip register to write
+     * @param value value to write
+     */
+    void write(int offset, unsigned char value);
+
+    /**
+     * Setting of SID sampling parameters.
+     * The analog part runs every 8 cycles, or more often
+     * if needed to stay above twice the sampling frequency.
+     *
+     * @param clockFrequency System clock frequency at Hz
+     * @param samplingFrequency Desired output sampling rate
+     * @throw SIDError
+     */
+    void setSamplingParameters(double clockFrequency, double samplingFrequency);
+
+    /**
+     * Clock SID forward.
+     *
+     * @param cycles c64 clocks to clock
+     * @param buf audio output buffer
+     * @return number of samples produced
+     */
+    int clock(unsigned int cycles, short* buf);
+
+    /**
+     * Enable filter emulation.
+     *
+     * @param enable false to turn off filter emulation
+     */
+    void enableFilter(bool enable);
+};
+
+} // namespace reSIDfp
+
+#endif
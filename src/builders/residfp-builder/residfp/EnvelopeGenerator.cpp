@@ -28,6 +28,57 @@
 namespace reSIDfp
 {
 
+/// Period of the 15 bit rate counter LFSR
+constexpr unsigned int LFSR_PERIOD = (1 << 15) - 1;
+
+/**
+ * Position of each state in the LFSR sequence and vice versa,
+ * used to skip ahead without stepping the register.
+ */
+struct LfsrTables
+{
+    unsigned short index[1 << 15];
+    unsigned short state[LFSR_PERIOD];
+
+    LfsrTables()
+    {
+        // State zero is never reached
+        index[0] = LFSR_PERIOD;
+
+        unsigned int lfsr = 0x7fff;
+
+        for (unsigned int i = 0; i < LFSR_PERIOD; i++)
+        {
+            index[lfsr] = i;
+            state[i] = lfsr;
+
+            const unsigned int feedback = ((lfsr << 14) ^ (lfsr << 13)) & 0x4000;
+            lfsr = (lfsr >> 1) | feedback;
+        }
+    }
+};
+
+static const LfsrTables lfsrTables;
+
+unsigned int EnvelopeGenerator::lfsrSkip(unsigned int cycles)
+{
+    const unsigned int to = lfsrTables.index[rate];
+
+    // The rate counter never matches, the LFSR free runs
+    if (unlikely(to == LFSR_PERIOD))
+        return cycles;
+
+    const unsigned int from = lfsrTables.index[lfsr];
+    const unsigned int distance = (to >= from) ? to - from : to + LFSR_PERIOD - from;
+
+    if (distance == 0)
+        return 0;
+
+    const unsigned int skip = (cycles < distance) ? cycles : distance;
+    lfsr = lfsrTables.state[from + skip - ((from + skip >= LFSR_PERIOD) ? LFSR_PERIOD : 0)];
+    return skip;
+}
+
 /**
  * Lookup table to convert from attack, decay, or release value to rate
  * counter period.
@@ -84,6 +135,19 @@ void EnvelopeGenerator::reset()
     rate = adsrtable[release];
 }
 
+void EnvelopeGenerator::powerUp()
+{
+    lfsr = 0x7fff;
+    exponential_pipeline = 0;
+    next_state = State::RELEASE;
+    envelope_counter = 0xaa;
+    env3 = 0;
+
+    reset();
+
+    resetLfsr = false;
+}
+
 void EnvelopeGenerator::writeCONTROL_REG(unsigned char control)
 {
     const bool gate_next = (control & 0x01) != 0;
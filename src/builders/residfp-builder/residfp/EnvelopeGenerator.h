@@ -118,24 +118,60 @@ private:
 
     void state_change();
 
+    /**
+     * Advance the LFSR up to the next match with the rate period,
+     * without running past the given number of cycles.
+     *
+     * @param cycles the maximum number of cycles to skip
+     * @return the number of cycles skipped
+     */
+    unsigned int lfsrSkip(unsigned int cycles);
+
 public:
    /**
      * SID clocking.
      */
     void clock();
 
-    bool use_eg;
+    /**
+     * SID clocking - multiple cycles.
+     * The stretches where only the rate counter is running
+     * are skipped in a single step, with the same result
+     * as calling clock() for each cycle.
+     *
+     * @param cycles the number of cycles to clock
+     */
+    void clock(unsigned int cycles);
+
+    bool use_eg = true;
+
+    /**
+     * Get the Envelope Generator digital output.
+     */
+    unsigned int output() const { return output<true>(); }
 
     /**
      * Get the Envelope Generator digital output.
+     *
+     * @tparam EnvBypass if false the envelope bypass flag is
+     *                   assumed to be clear and is not checked
      */
+    template<bool EnvBypass>
     unsigned int output() const
     {
-        if (use_eg) {
-            return envelope_counter;
-        } else {
+        if (EnvBypass && !use_eg)
             return 0xff;
-        }
+
+        return envelope_counter;
+    }
+
+    /**
+     * Check if the envelope is frozen at zero.
+     * Only a write to the control register can release it.
+     */
+    bool isSilent() const
+    {
+        return use_eg && (envelope_counter == 0) && !counter_enabled && (state_pipeline == 0);
     }
 
     /**
@@ -143,6 +179,11 @@ public:
      */
     void reset();
 
+    /**
+     * Restore the power up state, envelope counter included.
+     */
+    void powerUp();
+
     /**
      * Write control register.
      *
@@ -173,6 +214,13 @@ public:
      * @return envelope counter value
      */
     unsigned char readENV() const { return env3; }
+
+    /**
+     * Return the envelope state.
+     *
+     * @return 0 for attack, 1 for decay/sustain and 2 for release
+     */
+    unsigned int readState() const { return static_cast<unsigned int>(state); }
 };
 
 } // namespace reSIDfp
@@ -282,6 +330,30 @@ void EnvelopeGenerator::clock()
     }
 }
 
+RESID_INLINE
+void EnvelopeGenerator::clock(unsigned int cycles)
+{
+    while (cycles != 0)
+    {
+        if ((new_exponential_counter_period == 0) && (state_pipeline == 0)
+            && (envelope_pipeline == 0) && (exponential_pipeline == 0) && !resetLfsr)
+        {
+            // Nothing is pending, the LFSR just runs until it matches the rate
+            const unsigned int skip = lfsrSkip(cycles);
+
+            if (skip != 0)
+            {
+                env3 = envelope_counter;
+                cycles -= skip;
+                continue;
+            }
+        }
+
+        clock();
+        cycles--;
+    }
+}
+
 /**
  * This is what happens on chip during state switching,
  * based on die reverse engineering and transistor level
@@ -20,10 +20,10 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
-#define FILTER_CPP
-
 #include "Filter.h"
 
+#include <algorithm>
+
 namespace reSIDfp
 {
 
@@ -101,6 +101,16 @@ Filter::Filter(FilterModelConfig& fmc) :
     input(0);
 }
 
+bool Filter::checkSettled(const Integrator& hp, const Integrator& bp)
+{
+    const int state[6] = { Vbp, Vlp, hp.getVx(), hp.getVc(), bp.getVx(), bp.getVc() };
+
+    const bool settled = std::equal(std::begin(state), std::end(state), settleState);
+    std::copy(std::begin(state), std::end(state), settleState);
+
+    return settled;
+}
+
 void Filter::enable(bool enable)
 {
     enabled = enable;
@@ -115,6 +125,19 @@ void Filter::enable(bool enable)
     }
 }
 
+void Filter::discharge(Integrator& hp, Integrator& bp)
+{
+    hp.discharge();
+    bp.discharge();
+
+    Vhp = 0;
+    Vbp = 0;
+    Vlp = 0;
+
+    for (int& state: settleState)
+        state = 0;
+}
+
 void Filter::reset()
 {
     writeFC_LO(0);
@@ -24,6 +24,7 @@
 #define FILTER_H
 
 #include "FilterModelConfig.h"
+#include "Integrator.h"
 #include "Voice.h"
 
 #include "siddefs-fp.h"
@@ -102,10 +103,15 @@ private:
     /// Selects which inputs to route through filter.
     unsigned char filt = 0;
 
+    /// Filter state at the last settling check.
+    int settleState[6] = { 0, 0, 0, 0, 0, 0 };
+
 private:
+    template<bool Is6581, bool Pulldown, bool EnvBypass>
     inline int getNormalizedVoice(Voice& v) const
     {
-        return fmc.getNormalizedVoice(v.output(), v.envelope()->output());
+        const float out = v.output<Is6581, Pulldown, EnvBypass>();
+        return fmc.getNormalizedVoice(out, v.envelope()->output<EnvBypass>());
     }
 
 protected:
@@ -131,22 +137,48 @@ protected:
      */
     inline unsigned int getFC() const { return fc; }
 
-    virtual int solveIntegrators() = 0;
-
-public:
-    Filter(FilterModelConfig& fmc);
-
-    virtual ~Filter() = default;
-
     /**
-     * SID clocking - 1 cycle
+     * Route the voices and the external input either to the filter
+     * or directly to the mixer, and update the highpass output.
      *
      * @param v1 voice 1 in
      * @param v2 voice 2 in
      * @param v3 voice 3 in
+     * @return the unfiltered signal going to the mixer
+     */
+    template<bool Is6581, bool Pulldown, bool EnvBypass>
+    int clockInput(Voice& v1, Voice& v2, Voice& v3);
+
+    /**
+     * Apply the audio mixer and the volume amplifier.
+     *
+     * @param Vmix the mixer input
      * @return filtered output, unsigned 16 bit
      */
-    unsigned short clock(Voice& v1, Voice& v2, Voice& v3);
+    unsigned short clockOutput(int Vmix) const { return currentVolume[currentMixer[Vmix]]; }
+
+    /**
+     * Check if the filter state is unchanged since the previous call
+     * and record the current one.
+     *
+     * @param hp the highpass integrator
+     * @param bp the bandpass integrator
+     * @return true if the state didn't change
+     */
+    bool checkSettled(const Integrator& hp, const Integrator& bp);
+
+    /**
+     * Clear the filter state, as in a new filter.
+     *
+     * @param hp the highpass integrator
+     * @param bp the bandpass integrator
+     */
+    void discharge(Integrator& hp, Integrator& bp);
+
+public:
+    Filter(FilterModelConfig& fmc);
+
+    virtual ~Filter() = default;
 
     /**
      * Enable filter.
@@ -188,6 +220,29 @@ public:
      */
     void writeMODE_VOL(unsigned char mode_vol);
 
+    /**
+     * Read the cutoff frequency register value.
+     */
+    unsigned int readFC() const { return fc; }
+
+    /**
+     * Read the resonance/filter register value.
+     */
+    unsigned char readRES_FILT() const { return filt; }
+
+    /**
+     * Read the mode/volume register value.
+     */
+    unsigned char readMODE_VOL() const
+    {
+        return vol | (lp ? 0x10 : 0) | (bp ? 0x20 : 0) | (hp ? 0x40 : 0) | (voice3off ? 0x80 : 0);
+    }
+
+    /**
+     * Check if voice 3 reaches the filter or the mixer.
+     */
+    bool isVoice3Routed() const { return filt3 || !voice3off; }
+
     /**
      * Apply a signal to EXT-IN
      *
@@ -196,20 +251,13 @@ public:
     void input(short input) { Ve = fmc.getNormalizedVoice(input/32768.f, 0); }
 };
 
-} // namespace reSIDfp
-
-#if RESID_INLINING || defined(FILTER_CPP)
-
-namespace reSIDfp
+template<bool Is6581, bool Pulldown, bool EnvBypass>
+inline int Filter::clockInput(Voice& voice1, Voice& voice2, Voice& voice3)
 {
-
-RESID_INLINE
-unsigned short Filter::clock(Voice& voice1, Voice& voice2, Voice& voice3)
-{
-    const int V1 = getNormalizedVoice(voice1);
-    const int V2 = getNormalizedVoice(voice2);
+    const int V1 = getNormalizedVoice<Is6581, Pulldown, EnvBypass>(voice1);
+    const int V2 = getNormalizedVoice<Is6581, Pulldown, EnvBypass>(voice2);
     // Voice 3 is silenced by voice3off if it is not routed through the filter.
-    const int V3 = (filt3 || !voice3off) ? getNormalizedVoice(voice3) : 0;
+    const int V3 = (filt3 || !voice3off) ? getNormalizedVoice<Is6581, Pulldown, EnvBypass>(voice3) : 0;
 
     int Vsum = 0;
     int Vmix = 0;
@@ -221,13 +269,9 @@ unsigned short Filter::clock(Voice& voice1, Voice& voice2, Voice& voice3)
 
     Vhp = currentSummer[currentResonance[Vbp] + Vlp + Vsum];
 
-    Vmix += solveIntegrators();
-
-    return currentVolume[currentMixer[Vmix]];
+    return Vmix;
 }
 
-#endif
-
 } // namespace reSIDfp
 
 #endif
@@ -20,51 +20,51 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
+#define FILTER6581_CPP
+
 #include "Filter6581.h"
 
 #include "Integrator6581.h"
 
-namespace reSIDfp
-{
+#include <cmath>
 
-int Filter6581::solveIntegrators()
+namespace reSIDfp
 {
-    Vbp = hpIntegrator.solve(Vhp);
-    Vlp = bpIntegrator.solve(Vbp);
 
-    int Vfilt = 0;
-    if (lp) Vfilt += Vlp;
-    if (bp) Vfilt += Vbp;
-    if (hp) Vfilt += Vhp;
-
-    // The filter input resistors are slightly bigger than the voice ones
-    // Scale the values accordingly
-    constexpr int filterGain = static_cast<int>(0.93 * (1 << 12));
-    return (Vfilt * filterGain) >> 12;
-}
-
-Filter6581::~Filter6581()
-{
-    delete [] f0_dac;
-}
+Filter6581::~Filter6581() = default;
 
 void Filter6581::updateCenterFrequency()
 {
-    const unsigned short Vw = f0_dac[getFC()];
+    const unsigned short Vw = f0_dac.get()[getFC()];
     hpIntegrator.setVw(Vw);
     bpIntegrator.setVw(Vw);
 }
 
 void Filter6581::setFilterCurve(double curvePosition)
 {
-    delete [] f0_dac;
     f0_dac = FilterModelConfig6581::getInstance()->getDAC(curvePosition);
     updateCenterFrequency();
 }
 
 void Filter6581::setFilterRange(double adjustment)
 {
-    FilterModelConfig6581::getInstance()->setFilterRange(adjustment);
+    setRange(FilterModelConfig6581::getInstance()->getFilterRange(adjustment));
+}
+
+void Filter6581::setDefaultFilterRange()
+{
+    setRange(FilterModelConfig6581::getInstance()->getDefaultFilterRange());
+}
+
+void Filter6581::setRange(std::shared_ptr<const FilterRange6581> newRange)
+{
+    // Ignore small changes
+    if (std::abs(range->getUCox() - newRange->getUCox()) < 1e-12)
+        return;
+
+    range = newRange;
+    hpIntegrator.setRange(range.get());
+    bpIntegrator.setRange(range.get());
 }
 
 } // namespace reSIDfp
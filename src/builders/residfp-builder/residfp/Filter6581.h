@@ -27,6 +27,8 @@
 #include "FilterModelConfig6581.h"
 #include "Integrator6581.h"
 
+#include <memory>
+
 #include "sidcxx11.h"
 
 namespace reSIDfp
@@ -326,7 +328,16 @@ private:
     /// VCR + associated capacitor connected to bandpass output.
     Integrator6581 bpIntegrator;
 
-    const unsigned short* f0_dac;
+    /// Filter range parameters, shared with other instances
+    std::shared_ptr<const FilterRange6581> range;
+
+    /// Cutoff frequency DAC table, shared with other instances
+    std::shared_ptr<const unsigned short> f0_dac;
+
+private:
+    int solveIntegrators();
+
+    void setRange(std::shared_ptr<const FilterRange6581> newRange);
 
 protected:
     /**
@@ -334,18 +345,47 @@ protected:
      */
     void updateCenterFrequency() override;
 
-    int solveIntegrators() override;
-
 public:
     Filter6581() :
         Filter(*FilterModelConfig6581::getInstance()),
         hpIntegrator(*FilterModelConfig6581::getInstance()),
         bpIntegrator(*FilterModelConfig6581::getInstance()),
+        range(FilterModelConfig6581::getInstance()->getDefaultFilterRange()),
         f0_dac(FilterModelConfig6581::getInstance()->getDAC(0.5))
-    {}
+    {
+        hpIntegrator.setRange(range.get());
+        bpIntegrator.setRange(range.get());
+    }
 
     ~Filter6581() override;
 
+    /**
+     * SID clocking - 1 cycle
+     *
+     * @param v1 voice 1 in
+     * @param v2 voice 2 in
+     * @param v3 voice 3 in
+     * @return filtered output, unsigned 16 bit
+     */
+    template<bool Pulldown, bool EnvBypass>
+    unsigned short clock(Voice& v1, Voice& v2, Voice& v3)
+    {
+        const int Vmix = clockInput<true, Pulldown, EnvBypass>(v1, v2, v3);
+        return clockOutput(Vmix + solveIntegrators());
+    }
+
+    /**
+     * Check if the filter has settled, that is its state didn't change
+     * since the previous call. If this holds over one cycle with
+     * constant input the filter output won't change anymore.
+     */
+    bool isSettled() { return checkSettled(hpIntegrator, bpIntegrator); }
+
+    /**
+     * Discharge the integrators.
+     */
+    void discharge() { Filter::discharge(hpIntegrator, bpIntegrator); }
+
     /**
      * Set filter curve type based on single parameter.
      *
@@ -361,8 +401,39 @@ public:
      *                   This also affects the range. Default is 0.5
      */
     void setFilterRange(double adjustment);
+
+    /**
+     * Restore the filter offset and range of a new filter.
+     */
+    void setDefaultFilterRange();
 };
 
 } // namespace reSIDfp
 
+#if RESID_INLINING || defined(FILTER6581_CPP)
+
+namespace reSIDfp
+{
+
+RESID_INLINE
+int Filter6581::solveIntegrators()
+{
+    Vbp = hpIntegrator.solve(Vhp);
+    Vlp = bpIntegrator.solve(Vbp);
+
+    int Vfilt = 0;
+    if (lp) Vfilt += Vlp;
+    if (bp) Vfilt += Vbp;
+    if (hp) Vfilt += Vhp;
+
+    // The filter input resistors are slightly bigger than the voice ones
+    // Scale the values accordingly
+    constexpr int filterGain = static_cast<int>(0.93 * (1 << 12));
+    return (Vfilt * filterGain) >> 12;
+}
+
+} // namespace reSIDfp
+
+#endif
+
 #endif
@@ -20,6 +20,8 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
+#define FILTER8580_CPP
+
 #include "Filter8580.h"
 
 #include "Integrator8580.h"
@@ -27,19 +29,6 @@
 namespace reSIDfp
 {
 
-int Filter8580::solveIntegrators()
-{
-    Vbp = hpIntegrator.solve(Vhp);
-    Vlp = bpIntegrator.solve(Vbp);
-
-    int Vfilt = 0;
-    if (lp) Vfilt += Vlp;
-    if (bp) Vfilt += Vbp;
-    if (hp) Vfilt += Vhp;
-
-    return Vfilt;
-}
-
 /**
  * W/L ratio of frequency DAC bit 0,
  * other bit are proportional.
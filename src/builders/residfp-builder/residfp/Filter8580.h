@@ -285,14 +285,15 @@ private:
 
     double cp;
 
+private:
+    int solveIntegrators();
+
 protected:
     /**
      * Set filter cutoff frequency.
      */
     void updateCenterFrequency() override;
 
-    int solveIntegrators() override;
-
 public:
     Filter8580() :
         Filter(*FilterModelConfig8580::getInstance()),
@@ -304,6 +305,33 @@ public:
 
     ~Filter8580() override;
 
+    /**
+     * SID clocking - 1 cycle
+     *
+     * @param v1 voice 1 in
+     * @param v2 voice 2 in
+     * @param v3 voice 3 in
+     * @return filtered output, unsigned 16 bit
+     */
+    template<bool Pulldown, bool EnvBypass>
+    unsigned short clock(Voice& v1, Voice& v2, Voice& v3)
+    {
+        const int Vmix = clockInput<false, Pulldown, EnvBypass>(v1, v2, v3);
+        return clockOutput(Vmix + solveIntegrators());
+    }
+
+    /**
+     * Check if the filter has settled, that is its state didn't change
+     * since the previous call. If this holds over one cycle with
+     * constant input the filter output won't change anymore.
+     */
+    bool isSettled() { return checkSettled(hpIntegrator, bpIntegrator); }
+
+    /**
+     * Discharge the integrators.
+     */
+    void discharge() { Filter::discharge(hpIntegrator, bpIntegrator); }
+
     /**
      * Set filter curve type based on single parameter.
      *
@@ -314,4 +342,27 @@ public:
 
 } // namespace reSIDfp
 
+#if RESID_INLINING || defined(FILTER8580_CPP)
+
+namespace reSIDfp
+{
+
+RESID_INLINE
+int Filter8580::solveIntegrators()
+{
+    Vbp = hpIntegrator.solve(Vhp);
+    Vlp = bpIntegrator.solve(Vbp);
+
+    int Vfilt = 0;
+    if (lp) Vfilt += Vlp;
+    if (bp) Vfilt += Vbp;
+    if (hp) Vfilt += Vhp;
+
+    return Vfilt;
+}
+
+} // namespace reSIDfp
+
+#endif
+
 #endif
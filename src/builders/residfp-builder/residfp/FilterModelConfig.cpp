@@ -22,12 +22,53 @@
 
 #include "FilterModelConfig.h"
 
+#include <cstring>
 #include <vector>
 
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#ifndef PACKAGE_VERSION
+#  define PACKAGE_VERSION VERSION
+#endif
+
 namespace reSIDfp
 {
 
+/**
+ * Total size of the lookup tables:
+ * opamp_rev, summer[5], mixer[8], volume[16] and resonance[16].
+ * Rounded up to a multiple of 8 bytes.
+ */
+constexpr size_t TABLES_SIZE = ((1 + 20 + 28 + 16 + 16) * (1 << 16) + 1 + 3) & ~3;
+
+/**
+ * Hash the parameters the lookup tables depend on.
+ * The library version is included so that tables
+ * written by a different build are never reused.
+ */
+static uint64_t tablesKey(
+    const char* name,
+    double vvr,
+    double c,
+    double vdd,
+    double vth,
+    double ucox,
+    const Spline::Point *opamp_voltage,
+    int opamp_size)
+{
+    const double params[] = { vvr, c, vdd, vth, ucox };
+
+    uint64_t key = TableCache::hash(PACKAGE_VERSION, std::strlen(PACKAGE_VERSION), 0);
+    key = TableCache::hash(name, std::strlen(name), key);
+    key = TableCache::hash(params, sizeof(params), key);
+    key = TableCache::hash(opamp_voltage, opamp_size * sizeof(Spline::Point), key);
+    return key;
+}
+
 FilterModelConfig::FilterModelConfig(
+    const char* name,
     double vvr,
     double c,
     double vdd,
@@ -45,10 +86,23 @@ FilterModelConfig::FilterModelConfig(
     denorm(vmax - vmin),
     norm(1.0 / denorm),
     N16(norm * ((1 << 16) - 1)),
-    voice_voltage_range(vvr)
+    voice_voltage_range(vvr),
+    cache(name, tablesKey(name, vvr, c, vdd, vth, ucox, opamp_voltage, opamp_size), TABLES_SIZE * sizeof(unsigned short)),
+    tables(nullptr)
 {
     setUCox(ucox);
 
+    // The cached tables are mapped read-only and never written
+    const void* cachedTables = cache.load();
+    if (cachedTables != nullptr)
+    {
+        setTables(const_cast<unsigned short*>(static_cast<const unsigned short*>(cachedTables)));
+        return;
+    }
+
+    tables = new unsigned short[TABLES_SIZE];
+    setTables(tables);
+
     // Convert op-amp voltage transfer to 16 bit values.
 
     std::vector<Spline::Point> scaled_voltage(opamp_size);
@@ -78,27 +132,48 @@ FilterModelConfig::FilterModelConfig(
 
 FilterModelConfig::~FilterModelConfig()
 {
+    delete [] tables;
+}
+
+void FilterModelConfig::setTables(unsigned short* data)
+{
+    opamp_rev = data;
+    data += 1 << 16;
+
+    for (int i = 0; i < 5; i++)
+    {
+        summer[i] = data;
+        data += (2 + i) << 16;
+    }
+
     for (int i = 0; i < 8; i++)
     {
-        delete [] mixer[i];
+        mixer[i] = data;
+        data += (i == 0) ? 1 : i << 16;
     }
 
-    for (int i = 0; i < 5; i++)
+    for (int i = 0; i < 16; i++)
     {
-        delete [] summer[i];
+        volume[i] = data;
+        data += 1 << 16;
     }
 
     for (int i = 0; i < 16; i++)
     {
-        delete [] volume[i];
-        delete [] resonance[i];
+        resonance[i] = data;
+        data += 1 << 16;
     }
 }
 
+void FilterModelConfig::storeTables() const
+{
+    cache.store(tables);
+}
+
 void FilterModelConfig::setUCox(double new_uCox)
 {
     uCox = new_uCox;
-    currFactorCoeff = denorm * (uCox / 2. * 1.0e-6 / C);
+    currFactorCoeff = getCurrFactorCoeff(uCox);
 }
 
 } // namespace reSIDfp
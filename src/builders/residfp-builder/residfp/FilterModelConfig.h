@@ -28,6 +28,7 @@
 
 #include "OpAmp.h"
 #include "Spline.h"
+#include "TableCache.h"
 
 #include "sidcxx11.h"
 
@@ -73,7 +74,14 @@ protected:
     //@}
 
     /// Reverse op-amp transfer function.
-    unsigned short opamp_rev[1 << 16]; //-V730_NOINIT this is initialized in the derived class constructor
+    unsigned short* opamp_rev;
+
+private:
+    /// On-disk cache of the lookup tables
+    TableCache cache;
+
+    /// Storage for the lookup tables if not loaded from the cache
+    unsigned short* tables;
 
 private:
     FilterModelConfig(const FilterModelConfig&) = delete;
@@ -84,8 +92,14 @@ private:
         return value * voice_voltage_range + getVoiceDC(env);
     }
 
+    /**
+     * Point the lookup tables into a single memory block.
+     */
+    void setTables(unsigned short* data);
+
 protected:
     /**
+     * @param name cache file name
      * @param vvr voice voltage range
      * @param c   capacitor value
      * @param vdd Vdd supply voltage
@@ -95,6 +109,7 @@ protected:
      * @param opamp_size opamp voltage array size
      */
     FilterModelConfig(
+        const char* name,
         double vvr,
         double c,
         double vdd,
@@ -106,8 +121,26 @@ protected:
 
     ~FilterModelConfig();
 
+    /**
+     * Check if the lookup tables have been loaded from the cache.
+     * If not the derived class must build them and then call storeTables().
+     */
+    bool isCached() const { return tables == nullptr; }
+
+    /**
+     * Save the freshly built lookup tables to the cache.
+     */
+    void storeTables() const;
+
     void setUCox(double new_uCox);
 
+    /**
+     * Current factor coefficient for a given transconductance coefficient.
+     *
+     * @param ucox u*Cox
+     */
+    inline double getCurrFactorCoeff(double ucox) const { return denorm * (ucox / 2. * 1.0e-6 / C); }
+
     virtual double getVoiceDC(unsigned int env) const = 0;
 
     /**
@@ -130,7 +163,6 @@ protected:
             const double n = idiv;
             const double r_idiv = 1. / idiv;
             opampModel.reset();
-            summer[i] = new unsigned short[size];
 
             for (int vi = 0; vi < size; vi++)
             {
@@ -159,7 +191,6 @@ protected:
             const double n = i * nRatio;
             const double r_idiv = 1. / idiv;
             opampModel.reset();
-            mixer[i] = new unsigned short[size];
 
             for (int vi = 0; vi < size; vi++)
             {
@@ -185,7 +216,6 @@ protected:
             const int size = 1 << 16;
             const double n = n8 / nDivisor;
             opampModel.reset();
-            volume[n8] = new unsigned short[size];
 
             for (int vi = 0; vi < size; vi++)
             {
@@ -210,7 +240,6 @@ protected:
         {
             const int size = 1 << 16;
             opampModel.reset();
-            resonance[n8] = new unsigned short[size];
 
             for (int vi = 0; vi < size; vi++)
             {
@@ -242,7 +271,13 @@ public:
     template<int N>
     inline unsigned short getNormalizedCurrentFactor(double wl) const
     {
-        const double tmp = (1 << N) * currFactorCoeff * wl;
+        return getNormalizedCurrentFactor<N>(wl, currFactorCoeff);
+    }
+
+    template<int N>
+    static inline unsigned short getNormalizedCurrentFactor(double wl, double coeff)
+    {
+        const double tmp = (1 << N) * coeff * wl;
         assert(tmp > -0.5 && tmp < 65535.5);
         return static_cast<unsigned short>(tmp + 0.5);
     }
@@ -83,6 +83,23 @@ constexpr Spline::Point opamp_voltage[OPAMP_SIZE] =
 std::unique_ptr<FilterModelConfig6581> FilterModelConfig6581::instance(nullptr);
 
 std::mutex Instance6581_Lock;
+std::mutex Tables6581_Lock;
+
+/**
+ * Drop the cache entries whose tables are no longer used.
+ * Must be called with Tables6581_Lock held.
+ */
+template<typename T>
+static void purgeExpired(std::map<double, std::weak_ptr<T>>& tables)
+{
+    for (auto it = tables.begin(); it != tables.end();)
+    {
+        if (it->second.expired())
+            it = tables.erase(it);
+        else
+            ++it;
+    }
+}
 
 FilterModelConfig6581* FilterModelConfig6581::getInstance()
 {
@@ -96,7 +113,7 @@ FilterModelConfig6581* FilterModelConfig6581::getInstance()
     return instance.get();
 }
 
-void FilterModelConfig6581::setFilterRange(double adjustment)
+std::shared_ptr<const FilterRange6581> FilterModelConfig6581::getFilterRange(double adjustment)
 {
     // clamp into allowed range
 #ifdef HAVE_CXX17
@@ -106,17 +123,40 @@ void FilterModelConfig6581::setFilterRange(double adjustment)
 #endif
 
      // Get the new uCox value, in the range [1,40]
-     const double new_uCox = (1. + 39. * adjustment) * 1e-6;
+     return getRange((1. + 39. * adjustment) * 1e-6);
+}
 
-    // Ignore small changes
-    if (std::abs(uCox - new_uCox) < 1e-12)
-        return;
+std::shared_ptr<const FilterRange6581> FilterModelConfig6581::getRange(double ucox)
+{
+    std::lock_guard<std::mutex> lock(Tables6581_Lock);
+
+    std::shared_ptr<const FilterRange6581> range = ranges[ucox].lock();
+
+    if (!range)
+    {
+        purgeExpired(ranges);
+
+        FilterRange6581* newRange = new FilterRange6581(ucox);
 
-    setUCox(new_uCox);
+        newRange->n_snake = getNormalizedCurrentFactor<13>(WL_snake, getCurrFactorCoeff(ucox));
+
+        for (int i = 0; i < (1 << 16); i++)
+        {
+            const double tmp = vcr_n_Ids_term[i] * ucox;
+            assert(tmp > -0.5 && tmp < 65535.5);
+            newRange->vcr_n_Ids_term[i] = static_cast<unsigned short>(tmp + 0.5);
+        }
+
+        range.reset(newRange);
+        ranges[ucox] = range;
+    }
+
+    return range;
 }
 
 FilterModelConfig6581::FilterModelConfig6581() :
     FilterModelConfig(
+        "residfp-6581.cache",
         1.5,                    // voice voltage range FIXME should theoretically be ~3,571V
         470e-12,                // capacitor value
         12. * VOLTAGE_SKEW,     // Vdd
@@ -256,36 +296,60 @@ FilterModelConfig6581::FilterModelConfig6581() :
     using sidThread = std::thread;
 #endif
 
-    sidThread thdSummer(filterSummer);
-    sidThread thdMixer(filterMixer);
-    sidThread thdGain(filterGain);
-    sidThread thdResonance(filterResonance);
-    sidThread thdVcrVg(filterVcrVg);
-    sidThread thdVcrIds(filterVcrIds);
+    if (isCached())
+    {
+        // only the VCR tables are left to build
+        filterVcrVg();
+        filterVcrIds();
+        return;
+    }
+
+    {
+        sidThread thdSummer(filterSummer);
+        sidThread thdMixer(filterMixer);
+        sidThread thdGain(filterGain);
+        sidThread thdResonance(filterResonance);
+        sidThread thdVcrVg(filterVcrVg);
+        sidThread thdVcrIds(filterVcrIds);
 
 #if !defined(HAVE_CXX20) || !defined(__cpp_lib_jthread)
-    thdSummer.join();
-    thdMixer.join();
-    thdGain.join();
-    thdResonance.join();
-    thdVcrVg.join();
-    thdVcrIds.join();
+        thdSummer.join();
+        thdMixer.join();
+        thdGain.join();
+        thdResonance.join();
+        thdVcrVg.join();
+        thdVcrIds.join();
 #endif
+    }
+
+    storeTables();
 }
 
-unsigned short* FilterModelConfig6581::getDAC(double adjustment) const
+std::shared_ptr<const unsigned short> FilterModelConfig6581::getDAC(double adjustment)
 {
-    const double dac_zero = getDacZero(adjustment);
+    std::lock_guard<std::mutex> lock(Tables6581_Lock);
 
-    unsigned short* f0_dac = new unsigned short[1 << DAC_BITS];
+    std::shared_ptr<const unsigned short> table = dacs[adjustment].lock();
 
-    for (unsigned int i = 0; i < (1 << DAC_BITS); i++)
+    if (!table)
     {
-        const double fcd = dac.getOutput(i);
-        f0_dac[i] = getNormalizedValue(dac_zero + fcd * dac_scale);
+        purgeExpired(dacs);
+
+        const double dac_zero = getDacZero(adjustment);
+
+        unsigned short* f0_dac = new unsigned short[1 << DAC_BITS];
+
+        for (unsigned int i = 0; i < (1 << DAC_BITS); i++)
+        {
+            const double fcd = dac.getOutput(i);
+            f0_dac[i] = getNormalizedValue(dac_zero + fcd * dac_scale);
+        }
+
+        table.reset(f0_dac, std::default_delete<unsigned short[]>());
+        dacs[adjustment] = table;
     }
 
-    return f0_dac;
+    return table;
 }
 
 } // namespace reSIDfp
@@ -25,6 +25,7 @@
 
 #include "FilterModelConfig.h"
 
+#include <map>
 #include <memory>
 
 #include "Dac.h"
@@ -36,8 +37,46 @@ namespace reSIDfp
 
 class Integrator6581;
 
+/**
+ * Filter range dependent parameters for 6581 filter emulation.
+ *
+ * Instances are immutable and shared among all the filters
+ * using the same range, see FilterModelConfig6581::getFilterRange(double).
+ */
+class FilterRange6581
+{
+    friend class FilterModelConfig6581;
+
+private:
+    /// Transconductance coefficient: u*Cox
+    const double uCox;
+
+    /// Normalized current factor of the "snake"
+    unsigned short n_snake;
+
+    /// VCR current term scaled by u*Cox
+    unsigned short vcr_n_Ids_term[1 << 16];
+
+private:
+    FilterRange6581(double ucox) : uCox(ucox) {}
+
+    FilterRange6581(const FilterRange6581&) = delete;
+    FilterRange6581& operator= (const FilterRange6581&) = delete;
+
+public:
+    inline double getUCox() const { return uCox; }
+
+    inline unsigned short getNormalizedSnakeCurrentFactor() const { return n_snake; }
+
+    inline unsigned short getVcr_n_Ids_term(int i) const { return vcr_n_Ids_term[i]; }
+};
+
 /**
  * Calculate parameters for 6581 filter emulation.
+ *
+ * The instance only holds tables that do not depend on the
+ * filter parameters; range and curve dependent tables are built
+ * on request and shared among the filters using the same values.
  */
 class FilterModelConfig6581 final : public FilterModelConfig
 {
@@ -78,9 +117,17 @@ private:
     // Voice DC offset LUT
     double voiceDC[256];
 
+    /// Filter ranges in use, indexed by u*Cox
+    std::map<double, std::weak_ptr<const FilterRange6581>> ranges;
+
+    /// Cutoff frequency DAC tables in use, indexed by curve position
+    std::map<double, std::weak_ptr<const unsigned short>> dacs;
+
 private:
     double getDacZero(double adjustment) const { return dac_zero + (1. - adjustment); }
 
+    std::shared_ptr<const FilterRange6581> getRange(double ucox);
+
     FilterModelConfig6581();
     ~FilterModelConfig6581() = default;
 
@@ -97,27 +144,37 @@ protected:
 public:
     static FilterModelConfig6581* getInstance();
 
-    void setFilterRange(double adjustment);
+    /**
+     * Get the parameters for the given filter range.
+     * Tables are built on first request and shared
+     * as long as someone holds a reference.
+     * This method is thread safe.
+     *
+     * @param adjustment the filter range in the range [0,1]
+     * @return the filter range parameters
+     */
+    std::shared_ptr<const FilterRange6581> getFilterRange(double adjustment);
+
+    /**
+     * Get the parameters for the default filter range.
+     * This method is thread safe.
+     */
+    std::shared_ptr<const FilterRange6581> getDefaultFilterRange() { return getRange(uCox); }
 
     /**
-     * Construct an 11 bit cutoff frequency DAC output voltage table.
-     * Ownership is transferred to the requester which becomes responsible
-     * of freeing the object when done.
+     * Get an 11 bit cutoff frequency DAC output voltage table.
+     * Tables are built on first request and shared
+     * as long as someone holds a reference.
+     * This method is thread safe.
      *
-     * @param adjustment
+     * @param adjustment the curve position
      * @return the DAC table
      */
-    unsigned short* getDAC(double adjustment) const;
+    std::shared_ptr<const unsigned short> getDAC(double adjustment);
 
     inline double getWL_snake() const { return WL_snake; }
 
     inline unsigned short getVcr_nVg(int i) const { return vcr_nVg[i]; }
-    inline unsigned short getVcr_n_Ids_term(int i) const
-    {
-        const double tmp = vcr_n_Ids_term[i] * uCox;
-        assert(tmp > -0.5 && tmp < 65535.5);
-        return static_cast<unsigned short>(tmp + 0.5);
-    }
     // only used if SLOPE_FACTOR is defined
     inline constexpr double getUt() const { return Ut; }
     inline double getN16() const { return N16; }
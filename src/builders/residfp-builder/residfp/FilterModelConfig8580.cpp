@@ -130,6 +130,7 @@ FilterModelConfig8580* FilterModelConfig8580::getInstance()
 
 FilterModelConfig8580::FilterModelConfig8580() :
     FilterModelConfig(
+        "residfp-8580.cache",
         0.24,               // voice voltage range FIXME should theoretically be ~0,474V
         22e-9,              // capacitor value
         9. * VOLTAGE_SKEW,  // Vdd
@@ -139,6 +140,9 @@ FilterModelConfig8580::FilterModelConfig8580() :
         OPAMP_SIZE
     )
 {
+    if (isCached())
+        return;
+
     // Create lookup tables for gains / summers.
 
     //
@@ -202,17 +206,21 @@ FilterModelConfig8580::FilterModelConfig8580() :
     using sidThread = std::thread;
 #endif
 
-    sidThread thdSummer(filterSummer);
-    sidThread thdMixer(filterMixer);
-    sidThread thdGain(filterGain);
-    sidThread thdResonance(filterResonance);
+    {
+        sidThread thdSummer(filterSummer);
+        sidThread thdMixer(filterMixer);
+        sidThread thdGain(filterGain);
+        sidThread thdResonance(filterResonance);
 
 #if !defined(HAVE_CXX20) || !defined(__cpp_lib_jthread)
-    thdSummer.join();
-    thdMixer.join();
-    thdGain.join();
-    thdResonance.join();
+        thdSummer.join();
+        thdMixer.join();
+        thdGain.join();
+        thdResonance.join();
 #endif
+    }
+
+    storeTables();
 }
 
 } // namespace reSIDfp
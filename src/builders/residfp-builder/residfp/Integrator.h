@@ -39,6 +39,21 @@ protected:
 public:
     virtual int solve(int vi) const = 0;
 
+    /**
+     * Get the op-amp input voltage.
+     */
+    int getVx() const { return vx; }
+
+    /**
+     * Get the capacitor charge.
+     */
+    int getVc() const { return vc; }
+
+    /**
+     * Discharge the capacitor.
+     */
+    void discharge() { vx = 0; vc = 0; }
+
     virtual ~Integrator() = default;
 };
 
@@ -164,8 +164,6 @@ namespace reSIDfp
 class Integrator6581 : public Integrator
 {
 private:
-    const double wlSnake;
-
 #ifdef SLOPE_FACTOR
     // Slope factor n = 1/k
     // where k is the gate coupling coefficient
@@ -181,9 +179,11 @@ private:
 
     FilterModelConfig6581& fmc;
 
+    /// Parameters for the current filter range
+    const FilterRange6581* range;
+
 public:
     Integrator6581(FilterModelConfig6581& fmc) :
-        wlSnake(fmc.getWL_snake()),
 #ifdef SLOPE_FACTOR
         n(1.4),
 #endif
@@ -191,13 +191,101 @@ public:
         nVddt(fmc.getNormalizedValue(fmc.getVddt())),
         nVt(fmc.getNormalizedValue(fmc.getVth())),
         nVmin(fmc.getNVmin()),
-        fmc(fmc) {}
+        fmc(fmc),
+        range(nullptr) {}
 
     void setVw(unsigned short Vw) { nVddt_Vw_2 = ((nVddt - Vw) * (nVddt - Vw)) >> 1; }
 
+    /**
+     * Set the filter range parameters.
+     * The object must outlive the integrator or be replaced.
+     */
+    void setRange(const FilterRange6581* r) { range = r; }
+
     int solve(int vi) const override;
 };
 
 } // namespace reSIDfp
 
+#if RESID_INLINING || defined(INTEGRATOR6581_CPP)
+
+#ifdef SLOPE_FACTOR
+#  include <cmath>
+#  include "sidcxx11.h"
+#endif
+
+namespace reSIDfp
+{
+
+RESID_INLINE
+int Integrator6581::solve(int vi) const
+{
+    // Make sure Vgst>0 so we're not in subthreshold mode
+    assert(vx < nVddt);
+
+    // Check that transistor is actually in triode mode
+    // Vds < Vgs - Vth
+    assert(vi < nVddt);
+
+    // "Snake" voltages for triode mode calculation.
+    const unsigned int Vgst = nVddt - vx;
+    const unsigned int Vgdt = nVddt - vi;
+
+    const unsigned int Vgst_2 = Vgst * Vgst;
+    const unsigned int Vgdt_2 = Vgdt * Vgdt;
+
+    // "Snake" current, scaled by (1/m)*2^13*m*2^16*m*2^16*2^-15 = m*2^30
+    const int n_I_snake = range->getNormalizedSnakeCurrentFactor() * (static_cast<int>(Vgst_2 - Vgdt_2) >> 15);
+
+    // VCR gate voltage.       // Scaled by m*2^16
+    // Vg = Vddt - sqrt(((Vddt - Vw)^2 + Vgdt^2)/2)
+    const int nVg = static_cast<int>(fmc.getVcr_nVg((nVddt_Vw_2 + (Vgdt_2 >> 1)) >> 16));
+#ifdef SLOPE_FACTOR
+    const double nVp = static_cast<double>(nVg - nVt) / n; // Pinch-off voltage
+    const int kVgt = static_cast<int>(nVp + 0.5) - nVmin;
+#else
+    const int kVgt = (nVg - nVt) - nVmin;
+#endif
+
+    // VCR voltages for EKV model table lookup.
+    const int kVgt_Vs = (kVgt - vx) + (1 << 15);
+    assert((kVgt_Vs >= 0) && (kVgt_Vs < (1 << 16)));
+    const int kVgt_Vd = (kVgt - vi) + (1 << 15);
+    assert((kVgt_Vd >= 0) && (kVgt_Vd < (1 << 16)));
+
+    // VCR current, scaled by m*2^15*2^15 = m*2^30
+    const unsigned int If = static_cast<unsigned int>(range->getVcr_n_Ids_term(kVgt_Vs)) << 15;
+    const unsigned int Ir = static_cast<unsigned int>(range->getVcr_n_Ids_term(kVgt_Vd)) << 15;
+#ifdef SLOPE_FACTOR
+    const double iVcr = static_cast<double>(If - Ir);
+    const int n_I_vcr = static_cast<int>(iVcr * n);
+#else
+    const int n_I_vcr = If - Ir;
+#endif
+
+#ifdef SLOPE_FACTOR
+    // estimate new slope factor based on gate voltage
+    constexpr double gamma = 1.0;   // body effect factor
+    constexpr double phi = 0.8;     // bulk Fermi potential
+    const double Vp = nVp / fmc.getN16();
+    n = 1. + (gamma / (2. * std::sqrt(Vp + phi + 4. * fmc.getUt())));
+    assert((n > 1.2) && (n < 1.8));
+#endif
+
+    // Change in capacitor charge.
+    vc += n_I_snake + n_I_vcr;
+
+    // vx = g(vc)
+    const int tmp = (vc >> 15) + (1 << 15);
+    assert(tmp < (1 << 16));
+    vx = fmc.getOpampRev(tmp);
+
+    // Return vo.
+    return vx - (vc >> 14);
+}
+
+} // namespace reSIDfp
+
+#endif
+
 #endif
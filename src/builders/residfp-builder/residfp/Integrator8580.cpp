@@ -18,36 +18,6 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
-#include "Integrator8580.h"
-
-namespace reSIDfp
-{
-
-int Integrator8580::solve(int vi) const
-{
-    // Make sure we're not in subthreshold mode
-    assert(vx < nVgt);
-
-    // DAC voltages
-    const unsigned int Vgst = nVgt - vx;
-    const unsigned int Vgdt = (vi < nVgt) ? nVgt - vi : 0;  // triode/saturation mode
-
-    const unsigned int Vgst_2 = Vgst * Vgst;
-    const unsigned int Vgdt_2 = Vgdt * Vgdt;
+#define INTEGRATOR8580_CPP
 
-    // DAC current, scaled by (1/m)*2^13*m*2^16*m*2^16*2^-15 = m*2^30
-    const int n_I_dac = (n_dac * (static_cast<int>(Vgst_2 - Vgdt_2) >> 15)) >> 4;
-
-    // Change in capacitor charge.
-    vc += n_I_dac;
-
-    // vx = g(vc)
-    const int tmp = (vc >> 15) + (1 << 15);
-    assert(tmp < (1 << 16));
-    vx = fmc.getOpampRev(tmp);
-
-    // Return vo.
-    return vx - (vc >> 14);
-}
-
-} // namespace reSIDfp
+#include "Integrator8580.h"
@@ -97,4 +97,41 @@ public:
 
 } // namespace reSIDfp
 
+#if RESID_INLINING || defined(INTEGRATOR8580_CPP)
+
+namespace reSIDfp
+{
+
+RESID_INLINE
+int Integrator8580::solve(int vi) const
+{
+    // Make sure we're not in subthreshold mode
+    assert(vx < nVgt);
+
+    // DAC voltages
+    const unsigned int Vgst = nVgt - vx;
+    const unsigned int Vgdt = (vi < nVgt) ? nVgt - vi : 0;  // triode/saturation mode
+
+    const unsigned int Vgst_2 = Vgst * Vgst;
+    const unsigned int Vgdt_2 = Vgdt * Vgdt;
+
+    // DAC current, scaled by (1/m)*2^13*m*2^16*m*2^16*2^-15 = m*2^30
+    const int n_I_dac = (n_dac * (static_cast<int>(Vgst_2 - Vgdt_2) >> 15)) >> 4;
+
+    // Change in capacitor charge.
+    vc += n_I_dac;
+
+    // vx = g(vc)
+    const int tmp = (vc >> 15) + (1 << 15);
+    assert(tmp < (1 << 16));
+    vx = fmc.getOpampRev(tmp);
+
+    // Return vo.
+    return vx - (vc >> 14);
+}
+
+} // namespace reSIDfp
+
+#endif
+
 #endif
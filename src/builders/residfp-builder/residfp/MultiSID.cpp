@@ -0,0 +1,170 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "MultiSID.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "SID.h"
+#include "resample/TwoPassSincResampler.h"
+#include "resample/ZeroOrderResampler.h"
+
+namespace reSIDfp
+{
+
+MultiSID::MultiSID() :
+    numChips(0),
+    numChannels(1) {}
+
+MultiSID::~MultiSID() = default;
+
+void MultiSID::setChips(SID* const* chips, unsigned int count, const float* gains, unsigned int channels)
+{
+    if ((count > MAX_CHIPS) || (channels == 0) || (channels > MAX_CHANNELS))
+    {
+        throw SIDError("Unsupported chip configuration");
+    }
+
+    numChips = count;
+    numChannels = channels;
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        this->chips[i] = chips[i];
+
+        for (unsigned int ch = 0; ch < channels; ch++)
+        {
+            this->gains[ch][i] = gains[ch * count + i];
+        }
+    }
+}
+
+void MultiSID::setSamplingParameters(double clockFrequency, SamplingMethod method, double samplingFrequency)
+{
+    // The chips' output is taken cycle by cycle, unfiltered
+    for (unsigned int i = 0; i < numChips; i++)
+    {
+        chips[i]->setSamplingParameters(clockFrequency, DECIMATE, clockFrequency);
+    }
+
+    for (unsigned int ch = 0; ch < MAX_CHANNELS; ch++)
+    {
+        if (resamplerCache[ch].select(resampler[ch], clockFrequency, method, samplingFrequency))
+            continue;
+
+        switch (method)
+        {
+        case DECIMATE:
+            resampler[ch].reset(new ZeroOrderResampler(clockFrequency, samplingFrequency));
+            break;
+
+        case RESAMPLE:
+            resampler[ch].reset(TwoPassSincResampler::create(clockFrequency, samplingFrequency));
+            break;
+
+        default:
+            throw SIDError("Unknown sampling method");
+        }
+    }
+}
+
+void MultiSID::reset()
+{
+    for (unsigned int ch = 0; ch < MAX_CHANNELS; ch++)
+    {
+        if (resampler[ch].get())
+        {
+            resampler[ch]->reset();
+        }
+        resamplerCache[ch].reset();
+    }
+}
+
+int MultiSID::clock(unsigned int cycles, short* const* buf)
+{
+    int s = 0;
+
+    while (cycles != 0)
+    {
+        const unsigned int n = std::min(cycles, BLOCK_SIZE);
+
+        for (unsigned int i = 0; i < numChips; i++)
+        {
+            const int samples = chips[i]->clock(n, chipOutput[i]);
+            assert(samples == static_cast<int>(n));
+            (void)samples;
+        }
+
+        if (numChannels == 1)
+        {
+            const float* const gain = gains[0];
+            Resampler* const r = resampler[0].get();
+
+            for (unsigned int j = 0; j < n; j++)
+            {
+                float mix = 0.f;
+                for (unsigned int i = 0; i < numChips; i++)
+                {
+                    mix += gain[i] * chipOutput[i][j];
+                }
+
+                if (unlikely(r->input(static_cast<int>(mix))))
+                {
+                    // The chips' scale factor has already been applied
+                    buf[0][s++] = r->getOutput(2);
+                }
+            }
+        }
+        else
+        {
+            const float* const gainL = gains[0];
+            const float* const gainR = gains[1];
+            Resampler* const rL = resampler[0].get();
+            Resampler* const rR = resampler[1].get();
+
+            for (unsigned int j = 0; j < n; j++)
+            {
+                float mixL = 0.f;
+                float mixR = 0.f;
+                for (unsigned int i = 0; i < numChips; i++)
+                {
+                    mixL += gainL[i] * chipOutput[i][j];
+                    mixR += gainR[i] * chipOutput[i][j];
+                }
+
+                // Both resamplers are in the same phase
+                rR->input(static_cast<int>(mixR));
+                if (unlikely(rL->input(static_cast<int>(mixL))))
+                {
+                    buf[0][s] = rL->getOutput(2);
+                    buf[1][s] = rR->getOutput(2);
+                    s++;
+                }
+            }
+        }
+
+        cycles -= n;
+    }
+
+    return s;
+}
+
+} // namespace reSIDfp
@@ -0,0 +1,127 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef MULTISID_H
+#define MULTISID_H
+
+#include <memory>
+
+#include "siddefs-fp.h"
+#include "resample/ResamplerCache.h"
+
+#include "sidcxx11.h"
+
+namespace reSIDfp
+{
+
+class SID;
+
+/**
+ * Clocks several chips in lockstep and mixes them
+ * before resampling.
+ *
+ * The chips are run over short blocks of cycles at the full
+ * clock rate, so their output stays in cache, then mixed
+ * into one or two channels, each with a single resampler.
+ * This replaces a resampler per chip with one per channel,
+ * the most expensive part of high quality resampling.
+ *
+ * The chips' sampling parameters are taken over:
+ * they produce one sample per cycle while in the group.
+ */
+class MultiSID
+{
+public:
+    /// Maximum number of chips
+    static constexpr unsigned int MAX_CHIPS = 8;
+
+    /// Maximum number of output channels
+    static constexpr unsigned int MAX_CHANNELS = 2;
+
+private:
+    /// Cycles clocked at once by each chip
+    static constexpr unsigned int BLOCK_SIZE = 512;
+
+private:
+    /// Resampler for each channel
+    std::unique_ptr<Resampler> resampler[MAX_CHANNELS];
+
+    /// Previous resampler for each channel, kept for switching back
+    ResamplerCache resamplerCache[MAX_CHANNELS];
+
+    /// The chips in the group
+    SID* chips[MAX_CHIPS];
+
+    /// Mixing gain of each chip for each channel
+    float gains[MAX_CHANNELS][MAX_CHIPS];
+
+    /// Chip output for the current block
+    short chipOutput[MAX_CHIPS][BLOCK_SIZE];
+
+    unsigned int numChips;
+
+    unsigned int numChannels;
+
+public:
+    MultiSID();
+    ~MultiSID();
+
+    /**
+     * Set the chips to clock and the mixing matrix.
+     * #setSamplingParameters must be called afterwards.
+     *
+     * @param chips the chips, at most #MAX_CHIPS
+     * @param count the number of chips
+     * @param gains the gain of each chip for each channel,
+     *              channel major
+     * @param channels the number of output channels, 1 or 2
+     * @throw SIDError
+     */
+    void setChips(SID* const* chips, unsigned int count, const float* gains, unsigned int channels);
+
+    /**
+     * Setting of the sampling parameters, for all the chips.
+     *
+     * @param clockFrequency System clock frequency at Hz
+     * @param method sampling method to use
+     * @param samplingFrequency Desired output sampling rate
+     * @throw SIDError
+     */
+    void setSamplingParameters(double clockFrequency, SamplingMethod method, double samplingFrequency);
+
+    /**
+     * Reset the resamplers.
+     * The chips are reset by their owners.
+     */
+    void reset();
+
+    /**
+     * Clock all the chips forward.
+     *
+     * @param cycles c64 clocks to clock
+     * @param buf audio output buffer for each channel
+     * @return number of samples produced for each channel
+     */
+    int clock(unsigned int cycles, short* const* buf);
+};
+
+} // namespace reSIDfp
+
+#endif
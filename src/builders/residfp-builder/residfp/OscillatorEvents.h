@@ -0,0 +1,141 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef OSCILLATOREVENTS_H
+#define OSCILLATOREVENTS_H
+
+#include <atomic>
+
+#include "siddefs-fp.h"
+
+#include "sidcxx11.h"
+
+namespace reSIDfp
+{
+
+/**
+ * Oscillator phase event, used to trigger scopes
+ * from the actual oscillator state.
+ */
+struct OscillatorEvent
+{
+    typedef enum
+    {
+        /// The accumulator MSB went high
+        MSB_RISING = 0,
+        /// The accumulator was reset by hard sync
+        SYNC,
+        /// The test bit was set
+        TEST_SET,
+        /// The test bit was cleared
+        TEST_CLEARED
+    } type_t;
+
+    /// Output sample index since the last reset
+    unsigned int sample;
+
+    /// Voice number, 0 to 2
+    unsigned char voice;
+
+    /// Event type
+    unsigned char type;
+};
+
+/**
+ * Fixed size lock-free ring buffer of oscillator events,
+ * with a single producer (the emulation) and a single consumer.
+ * Events are dropped if the buffer is full.
+ */
+class OscillatorEventBuffer
+{
+public:
+    /// Buffer size, must be a power of 2
+    static constexpr unsigned int SIZE = 4096;
+
+private:
+    OscillatorEvent events[SIZE];
+
+    /// Next slot to be written
+    std::atomic<unsigned int> head;
+
+    /// Next slot to be read
+    std::atomic<unsigned int> tail;
+
+    /// Number of events lost because the buffer was full
+    std::atomic<unsigned int> dropped;
+
+public:
+    OscillatorEventBuffer() :
+        head(0),
+        tail(0),
+        dropped(0) {}
+
+    /**
+     * Append an event, producer side.
+     */
+    void push(unsigned int sample, unsigned int voice, OscillatorEvent::type_t type)
+    {
+        const unsigned int h = head.load(std::memory_order_relaxed);
+
+        if (unlikely(h - tail.load(std::memory_order_acquire) == SIZE))
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        OscillatorEvent& event = events[h & (SIZE - 1)];
+        event.sample = sample;
+        event.voice = static_cast<unsigned char>(voice);
+        event.type = static_cast<unsigned char>(type);
+
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    /**
+     * Remove the pending events, consumer side.
+     *
+     * @param buf destination for the events
+     * @param count maximum number of events to read
+     * @return the number of events read
+     */
+    unsigned int read(OscillatorEvent* buf, unsigned int count)
+    {
+        unsigned int t = tail.load(std::memory_order_relaxed);
+        const unsigned int h = head.load(std::memory_order_acquire);
+
+        unsigned int n = 0;
+        while ((t != h) && (n < count))
+        {
+            buf[n++] = events[t++ & (SIZE - 1)];
+        }
+
+        tail.store(t, std::memory_order_release);
+        return n;
+    }
+
+    /**
+     * Get and reset the number of dropped events.
+     */
+    unsigned int readDropped() { return dropped.exchange(0, std::memory_order_relaxed); }
+};
+
+} // namespace reSIDfp
+
+#endif
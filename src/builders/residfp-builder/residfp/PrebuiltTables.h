@@ -0,0 +1,48 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef PREBUILTTABLES_H
+#define PREBUILTTABLES_H
+
+namespace reSIDfp
+{
+
+/**
+ * Tables generated at build time by gentables.
+ * Only available if RESIDFP_PREBUILT_TABLES is defined.
+ */
+//@{
+/// Waveform table, see WaveformCalculator::getWaveTable()
+extern const short prebuiltWaveTable[4][4096];
+
+/// Pulldown tables indexed by chip model and combined waveforms strength,
+/// see WaveformCalculator::buildPulldownTable()
+extern const short prebuiltPulldownTable[2][3][5][4096];
+
+/// Envelope DAC tables indexed by chip model, see Dac::buildEnvelopeTable()
+extern const float prebuiltEnvDAC[2][256];
+
+/// Waveform DAC tables indexed by chip model, see Dac::buildWaveformTable()
+extern const float prebuiltOscDAC[2][4096];
+//@}
+
+} // namespace reSIDfp
+
+#endif
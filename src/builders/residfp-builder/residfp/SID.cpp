@@ -24,6 +24,7 @@
 
 #include "SID.h"
 
+#include <algorithm>
 #include <limits>
 
 #include "sidcxx11.h"
@@ -33,15 +34,13 @@
 #include "Filter6581.h"
 #include "Filter8580.h"
 #include "WaveformCalculator.h"
+#include "resample/PassThroughResampler.h"
 #include "resample/TwoPassSincResampler.h"
 #include "resample/ZeroOrderResampler.h"
 
 namespace reSIDfp
 {
 
-constexpr unsigned int ENV_DAC_BITS = 8;
-constexpr unsigned int OSC_DAC_BITS = 12;
-
 /**
  * The waveform D/A converter introduces a DC offset in the signal
  * to the envelope multiplying D/A converter. The "zero" level of
@@ -137,7 +136,14 @@ SID::SID() :
     filter6581(new Filter6581()),
     filter8580(new Filter8580()),
     resampler(nullptr),
-    cws(AVERAGE)
+    cws(AVERAGE),
+    lastOutput(0),
+    sampleCounter(0),
+    samplesPerCycle(0.),
+    syncEventSample(0),
+    snapshotInterval(0),
+    nextSnapshot(0),
+    idle(false)
 {
     voice[0].setOtherVoices(voice[2], voice[1]);
     voice[1].setOtherVoices(voice[0], voice[2]);
@@ -156,33 +162,81 @@ SID::~SID()
 void SID::setFilter6581Curve(double filterCurve)
 {
     filter6581->setFilterCurve(filterCurve);
+    idle = false;
 }
 
 void SID::setFilter6581Range(double adjustment)
 {
     filter6581->setFilterRange(adjustment);
+    idle = false;
 }
 
 void SID::setFilter8580Curve(double filterCurve)
 {
     filter8580->setFilterCurve(filterCurve);
+    idle = false;
 }
 
 void SID::enableFilter(bool enable)
 {
     filter6581->enable(enable);
     filter8580->enable(enable);
+    idle = false;
+}
+
+void SID::restoreDefaults()
+{
+    filter6581->setFilterCurve(0.5);
+    filter6581->setDefaultFilterRange();
+    filter8580->setFilterCurve(0.5);
+    filter6581->discharge();
+    filter8580->discharge();
+    enableFilter(true);
+
+    for (int i = 0; i < 3; i++)
+    {
+        voice[i].powerUp();
+        voice[i].wave()->triggerwaves = false;
+        voice[i].envelope()->use_eg = true;
+    }
+
+    idle = false;
+    updateClockFunc();
+
+    if (cws != AVERAGE)
+        setCombinedWaveforms(AVERAGE);
+
+    enableOscillatorEvents(false);
+    enableStateSnapshots(0);
+    enableWaveformCapture(0, false);
 }
 
 void SID::voiceSync(bool sync)
 {
     if (sync)
     {
+        unsigned int accumulator[3];
+
+        if (unlikely(oscillatorEvents))
+        {
+            for (int i = 0; i < 3; i++)
+                accumulator[i] = voice[i].wave()->readAccumulator();
+        }
+
         // Synchronize the 3 waveform generators.
         for (int i = 0; i < 3; i++)
         {
             voice[i].wave()->synchronize();
         }
+
+        if (unlikely(oscillatorEvents))
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                if (voice[i].wave()->readAccumulator() != accumulator[i])
+                    oscillatorEvents->push(syncEventSample, i, OscillatorEvent::SYNC);
+            }
+        }
     }
 
     // Calculate the time to next voice sync
@@ -208,18 +262,198 @@ void SID::voiceSync(bool sync)
     }
 }
 
+void SID::recordOscillatorEvents(unsigned int cycles, int samples)
+{
+    const unsigned int start = sampleCounter + samples;
+
+    for (int i = 0; i < 3; i++)
+    {
+        const WaveformGenerator* const wave = voice[i].wave();
+        const unsigned int freq = wave->readFreq();
+
+        if (wave->readTest() || freq == 0)
+            continue;
+
+        // Same as the voice sync calculation, repeated
+        // for each MSB transition in the interval
+        unsigned int accumulator = wave->readAccumulator();
+        unsigned int t = 0;
+
+        for (;;)
+        {
+            const unsigned int msbRising = ((0x7fffff - accumulator) & 0xffffff) / freq + 1;
+
+            if (msbRising > cycles - t)
+                break;
+
+            t += msbRising;
+            accumulator = (accumulator + msbRising * freq) & 0xffffff;
+
+            oscillatorEvents->push(start + static_cast<unsigned int>(t * samplesPerCycle),
+                i, OscillatorEvent::MSB_RISING);
+        }
+    }
+
+    // Syncs only happen at the end of the interval
+    syncEventSample = start + static_cast<unsigned int>(cycles * samplesPerCycle);
+}
+
+void SID::recordTestEvent(int voiceNum, bool testPrev)
+{
+    const bool test = voice[voiceNum].wave()->readTest();
+
+    if (unlikely(oscillatorEvents) && (test != testPrev))
+    {
+        oscillatorEvents->push(sampleCounter, voiceNum,
+            test ? OscillatorEvent::TEST_SET : OscillatorEvent::TEST_CLEARED);
+    }
+}
+
+void SID::enableOscillatorEvents(bool enable)
+{
+    if (enable)
+    {
+        if (!oscillatorEvents)
+            oscillatorEvents.reset(new OscillatorEventBuffer());
+    }
+    else
+    {
+        oscillatorEvents.reset();
+    }
+}
+
+void SID::enableStateSnapshots(unsigned int interval)
+{
+    if (interval != 0)
+    {
+        if (!stateSnapshots)
+            stateSnapshots.reset(new SIDStateBuffer());
+    }
+    else
+    {
+        stateSnapshots.reset();
+    }
+
+    snapshotInterval = interval;
+    nextSnapshot = interval;
+}
+
+void SID::enableWaveformCapture(unsigned int decimation, bool minMax)
+{
+    if (decimation == 0)
+    {
+        waveformCapture.reset();
+        return;
+    }
+
+    if (!waveformCapture
+        || (waveformCapture->getDecimation() != decimation)
+        || (waveformCapture->isMinMax() != minMax))
+    {
+        waveformCapture.reset(new WaveformCaptureBuffer(decimation, minMax));
+    }
+}
+
+int SID::clockCapture(unsigned int cycles, short* buf)
+{
+    // Voice 3 output is not computed by the filter if it is not routed
+    const bool voice3 = (model == MOS6581)
+        ? filter6581->isVoice3Routed()
+        : filter8580->isVoice3Routed();
+
+    unsigned int wave[3];
+    unsigned int env[3];
+
+    int s = 0;
+
+    for (; cycles != 0; cycles--)
+    {
+        s += clockOutput(1, buf + s);
+
+        for (int v = 0; v < 3; v++)
+        {
+            wave[v] = voice[v].wave()->readWaveformOutput();
+            env[v] = voice[v].envelope()->output();
+        }
+
+        if (!voice3)
+            wave[2] = 0;
+
+        waveformCapture->input(wave, env);
+    }
+
+    return s;
+}
+
+void SID::takeSnapshot()
+{
+    const int i = stateSnapshots->beginWrite();
+
+    if (i < 0)
+        return;
+
+    SIDStateBuffer& b = *stateSnapshots;
+
+    b.sample[i] = sampleCounter;
+
+    for (int v = 0; v < 3; v++)
+    {
+        const WaveformGenerator* const wave = voice[v].wave();
+        const EnvelopeGenerator* const envelope = voice[v].envelope();
+
+        b.freq[v][i] = wave->readFreq();
+        b.pw[v][i] = wave->readPW();
+        b.waveform[v][i] = wave->readWaveform();
+        b.envelope[v][i] = envelope->readENV();
+        b.envelopeState[v][i] = envelope->readState();
+    }
+
+    const Filter* const filter = (model == MOS6581)
+        ? static_cast<const Filter*>(filter6581)
+        : static_cast<const Filter*>(filter8580);
+
+    b.fc[i] = filter->readFC();
+    b.resFilt[i] = filter->readRES_FILT();
+    b.modeVol[i] = filter->readMODE_VOL();
+
+    stateSnapshots->endWrite();
+}
+
+int SID::clockSnapshots(unsigned int cycles, short* buf)
+{
+    int s = 0;
+
+    while (cycles != 0)
+    {
+        const unsigned int delta_t = std::min(nextSnapshot, cycles);
+
+        s += waveformCapture
+            ? clockCapture(delta_t, buf + s)
+            : clockOutput(delta_t, buf + s);
+
+        cycles -= delta_t;
+        nextSnapshot -= delta_t;
+
+        if (nextSnapshot == 0)
+        {
+            takeSnapshot();
+            nextSnapshot = snapshotInterval;
+        }
+    }
+
+    return s;
+}
+
 void SID::setChipModel(ChipModel model)
 {
     switch (model)
     {
     case MOS6581:
-        filter = filter6581;
         scaleFactor = 3;
         modelTTL = BUS_TTL_6581;
         break;
 
     case MOS8580:
-        filter = filter8580;
         scaleFactor = 5;
         modelTTL = BUS_TTL_8580;
         break;
@@ -234,33 +468,16 @@ void SID::setChipModel(ChipModel model)
     matrix_t* wavetables = WaveformCalculator::getInstance()->getWaveTable();
     matrix_t* pulldowntables = WaveformCalculator::getInstance()->buildPulldownTable(model, cws);
 
-    // calculate envelope DAC table
-    {
-        Dac dacBuilder(ENV_DAC_BITS);
-        dacBuilder.kinkedDac(model);
-
-        for (unsigned int i = 0; i < (1 << ENV_DAC_BITS); i++)
-        {
-            envDAC[i] = static_cast<float>(dacBuilder.getOutput(i));
-        }
-    }
-
-    // calculate oscillator DAC table
     const bool is6581 = model == MOS6581;
 
-    {
-        Dac dacBuilder(OSC_DAC_BITS);
-        dacBuilder.kinkedDac(model);
-
-        //const double offset = dacBuilder.getOutput(is6581 ? OFFSET_6581 : OFFSET_8580);
-        const double offset = dacBuilder.getOutput(0x7ff);
+    // get the DAC tables
+    // note that the oscillator DAC is centered at 0x7ff
+    // instead of OFFSET_6581/OFFSET_8580
+    envDAC = Dac::getEnvelopeTable(model);
+    oscDAC = Dac::getWaveformTable(model);
 
-        for (unsigned int i = 0; i < (1 << OSC_DAC_BITS); i++)
-        {
-            const double dacValue = dacBuilder.getOutput(i);
-            oscDAC[i] = static_cast<float>(dacValue - offset);
-        }
-    }
+    // a zero envelope silences the voice only if the DAC has no leakage
+    silentEnvDAC = envDAC[0] == 0.f;
 
     // set voice tables
     for (int i = 0; i < 3; i++)
@@ -271,6 +488,9 @@ void SID::setChipModel(ChipModel model)
         voice[i].wave()->setWaveformModels(wavetables);
         voice[i].wave()->setPulldownModels(pulldowntables);
     }
+
+    idle = false;
+    updateClockFunc();
 }
 
 void SID::setCombinedWaveforms(CombinedWaveforms cws)
@@ -295,6 +515,8 @@ void SID::setCombinedWaveforms(CombinedWaveforms cws)
     {
         voice[i].wave()->setPulldownModels(pulldowntables);
     }
+
+    idle = false;
 }
 
 void SID::reset()
@@ -312,16 +534,24 @@ void SID::reset()
     {
         resampler->reset();
     }
+    resamplerCache.reset();
 
     busValue = 0;
     busValueTtl = 0;
+    lastOutput = 0;
+    sampleCounter = 0;
+    syncEventSample = 0;
+    nextSnapshot = snapshotInterval;
+    idle = false;
     voiceSync(false);
+    updateClockFunc();
 }
 
 void SID::input(int value)
 {
     filter6581->input(value);
     filter8580->input(value);
+    idle = false;
 }
 
 unsigned char SID::read(int offset)
@@ -363,6 +593,7 @@ void SID::write(int offset, unsigned char value)
 {
     busValue = value;
     busValueTtl = modelTTL;
+    idle = false;
 
     switch (offset)
     {
@@ -383,8 +614,13 @@ void SID::write(int offset, unsigned char value)
         break;
 
     case 0x04: // Voice #1 control register
+    {
+        const bool testPrev = voice[0].wave()->readTest();
         voice[0].writeCONTROL_REG(value);
+        recordTestEvent(0, testPrev);
+        updateClockFunc();
         break;
+    }
 
     case 0x05: // Voice #1 Attack and Decay length
         voice[0].envelope()->writeATTACK_DECAY(value);
@@ -411,8 +647,13 @@ void SID::write(int offset, unsigned char value)
         break;
 
     case 0x0b: // Voice #2 control register
+    {
+        const bool testPrev = voice[1].wave()->readTest();
         voice[1].writeCONTROL_REG(value);
+        recordTestEvent(1, testPrev);
+        updateClockFunc();
         break;
+    }
 
     case 0x0c: // Voice #2 Attack and Decay length
         voice[1].envelope()->writeATTACK_DECAY(value);
@@ -439,8 +680,13 @@ void SID::write(int offset, unsigned char value)
         break;
 
     case 0x12: // Voice #3 control register
+    {
+        const bool testPrev = voice[2].wave()->readTest();
         voice[2].writeCONTROL_REG(value);
+        recordTestEvent(2, testPrev);
+        updateClockFunc();
         break;
+    }
 
     case 0x13: // Voice #3 Attack and Decay length
         voice[2].envelope()->writeATTACK_DECAY(value);
@@ -519,16 +765,193 @@ void SID::sidvis(int offset, bool env_disable, bool tw_enable, bool kink_disable
     default:
         break;
     }
+
+    idle = false;
+    updateClockFunc();
+}
+
+void SID::updateClockFunc()
+{
+    static const clock_func_t clockFuncs[2][2][2] =
+    {
+        {
+            { &SID::clockChip<MOS6581, false, false>, &SID::clockChip<MOS6581, false, true> },
+            { &SID::clockChip<MOS6581, true, false>,  &SID::clockChip<MOS6581, true, true> },
+        },
+        {
+            { &SID::clockChip<MOS8580, false, false>, &SID::clockChip<MOS8580, false, true> },
+            { &SID::clockChip<MOS8580, true, false>,  &SID::clockChip<MOS8580, true, true> },
+        },
+    };
+
+    bool pulldown = false;
+    bool envBypass = false;
+
+    for (int i = 0; i < 3; i++)
+    {
+        pulldown |= voice[i].wave()->hasPulldown();
+        envBypass |= !voice[i].envelope()->use_eg;
+    }
+
+    clockFunc = clockFuncs[model == MOS8580 ? 1 : 0][pulldown ? 1 : 0][envBypass ? 1 : 0];
+}
+
+template<ChipModel Model, bool Pulldown, bool EnvBypass>
+int SID::clockChip(unsigned int cycles, short* buf)
+{
+    int s = 0;
+    int sidOutput = lastOutput;
+
+    while (cycles != 0)
+    {
+        unsigned int delta_t = std::min(nextVoiceSync, cycles);
+
+        if (likely(delta_t > 0))
+        {
+            if (unlikely(oscillatorEvents))
+            {
+                recordOscillatorEvents(delta_t, s);
+            }
+
+            for (unsigned int i = 0; i < delta_t; i++)
+            {
+                // clock waveform generators
+                voice[0].wave()->clock();
+                voice[1].wave()->clock();
+                voice[2].wave()->clock();
+
+                // clock envelope generators
+                voice[0].envelope()->clock();
+                voice[1].envelope()->clock();
+                voice[2].envelope()->clock();
+
+                sidOutput = (Model == MOS6581)
+                    ? filter6581->clock<Pulldown, EnvBypass>(voice[0], voice[1], voice[2])
+                    : filter8580->clock<Pulldown, EnvBypass>(voice[0], voice[1], voice[2]);
+                const int c64Output = externalFilter.clock(sidOutput - (1 << 15));
+                if (unlikely(resampler->input(c64Output)))
+                {
+                    buf[s++] = resampler->getOutput(scaleFactor);
+                }
+            }
+
+            cycles -= delta_t;
+            nextVoiceSync -= delta_t;
+        }
+
+        if (unlikely(nextVoiceSync == 0))
+        {
+            voiceSync(true);
+        }
+    }
+
+    lastOutput = sidOutput;
+    sampleCounter += s;
+
+    return s;
+}
+
+int SID::clockSettle(unsigned int cycles, short* buf)
+{
+    if (cycles == 0)
+    {
+        return 0;
+    }
+
+    const bool is6581 = model == MOS6581;
+
+    // Record the filter state, run a single cycle and check again:
+    // if nothing changed with constant input the filter has reached
+    // a fixed point and its output can be reused as is.
+    is6581 ? filter6581->isSettled() : filter8580->isSettled();
+
+    int s = (this->*clockFunc)(1, buf);
+
+    idle = voicesSilent()
+        && (is6581 ? filter6581->isSettled() : filter8580->isSettled());
+
+    s += idle
+        ? clockIdle(cycles - 1, buf + s)
+        : (this->*clockFunc)(cycles - 1, buf + s);
+
+    return s;
+}
+
+int SID::clockIdle(unsigned int cycles, short* buf)
+{
+    // Voice 3 output is not computed by the filter if it is not routed
+    const bool voice3 = (model == MOS6581)
+        ? filter6581->isVoice3Routed()
+        : filter8580->isVoice3Routed();
+
+    int s = 0;
+
+    while (cycles != 0)
+    {
+        unsigned int delta_t = std::min(nextVoiceSync, cycles);
+
+        if (likely(delta_t > 0))
+        {
+            if (unlikely(oscillatorEvents))
+            {
+                recordOscillatorEvents(delta_t, s);
+            }
+
+            for (unsigned int i = 0; i < delta_t; i++)
+            {
+                // clock waveform generators
+                voice[0].wave()->clock();
+                voice[1].wave()->clock();
+                voice[2].wave()->clock();
+
+                // clock envelope generators
+                voice[0].envelope()->clock();
+                voice[1].envelope()->clock();
+                voice[2].envelope()->clock();
+
+                // waveform output has side effects on the oscillator state
+                voice[0].wave()->output();
+                voice[1].wave()->output();
+                if (voice3)
+                    voice[2].wave()->output();
+
+                const int c64Output = externalFilter.clock(lastOutput - (1 << 15));
+                if (unlikely(resampler->input(c64Output)))
+                {
+                    buf[s++] = resampler->getOutput(scaleFactor);
+                }
+            }
+
+            cycles -= delta_t;
+            nextVoiceSync -= delta_t;
+        }
+
+        if (unlikely(nextVoiceSync == 0))
+        {
+            voiceSync(true);
+        }
+    }
+
+    sampleCounter += s;
+
+    return s;
 }
 
 void SID::setSamplingParameters(double clockFrequency, SamplingMethod method, double samplingFrequency)
 {
     externalFilter.setClockFrequency(clockFrequency);
+    samplesPerCycle = samplingFrequency / clockFrequency;
+
+    if (resamplerCache.select(resampler, clockFrequency, method, samplingFrequency))
+        return;
 
     switch (method)
     {
     case DECIMATE:
-        resampler.reset(new ZeroOrderResampler(clockFrequency, samplingFrequency));
+        if (samplingFrequency == clockFrequency)
+            resampler.reset(new PassThroughResampler());
+        else
+            resampler.reset(new ZeroOrderResampler(clockFrequency, samplingFrequency));
         break;
 
     case RESAMPLE:
@@ -27,18 +27,20 @@
 
 #include "siddefs-fp.h"
 #include "ExternalFilter.h"
+#include "OscillatorEvents.h"
 #include "Potentiometer.h"
+#include "SIDStateBuffer.h"
+#include "WaveformCaptureBuffer.h"
 #include "Voice.h"
+#include "resample/ResamplerCache.h"
 
 #include "sidcxx11.h"
 
 namespace reSIDfp
 {
 
-class Filter;
 class Filter6581;
 class Filter8580;
-class Resampler;
 
 /**
  * SID error exception.
@@ -60,8 +62,11 @@ public:
 class SID
 {
 private:
-    /// Currently active filter
-    Filter* filter;
+    typedef int (SID::*clock_func_t)(unsigned int cycles, short* buf);
+
+private:
+    /// Clock loop specialized for the current chip state
+    clock_func_t clockFunc;
 
     /// Filter used, if model is set to 6581
     Filter6581* const filter6581;
@@ -72,6 +77,18 @@ private:
     /// Resampler used by audio generation code.
     std::unique_ptr<Resampler> resampler;
 
+    /// Previous resampler, kept for switching back
+    ResamplerCache resamplerCache;
+
+    /// Oscillator events, only allocated when recording is enabled
+    std::unique_ptr<OscillatorEventBuffer> oscillatorEvents;
+
+    /// State snapshots, only allocated when enabled
+    std::unique_ptr<SIDStateBuffer> stateSnapshots;
+
+    /// Voice output capture, only allocated when enabled
+    std::unique_ptr<WaveformCaptureBuffer> waveformCapture;
+
     /**
      * External filter that provides high-pass and low-pass filtering
      * to adjust sound tone slightly.
@@ -105,22 +122,48 @@ private:
     /// Currently selected combined waveforms strength.
     CombinedWaveforms cws;
 
+    /// Last value produced by the filter and mixer
+    int lastOutput;
+
+    /// Number of samples produced since the last reset
+    unsigned int sampleCounter;
+
+    /// Output samples per clock cycle
+    double samplesPerCycle;
+
+    /// Timestamp of the next sync events
+    unsigned int syncEventSample;
+
+    /// Cycles between state snapshots
+    unsigned int snapshotInterval;
+
+    /// Time until the next state snapshot
+    unsigned int nextSnapshot;
+
     /// Last written value
     unsigned char busValue;
 
+    /// Whether a zero envelope silences the voices
+    bool silentEnvDAC;
+
+    /// Whether the chip is idle and the filter output is constant
+    bool idle;
+
     /**
-     * Emulated nonlinearity of the envelope DAC.
+     * Emulated nonlinearity of the envelope DAC,
+     * shared among all instances.
      *
      * @See Dac
      */
-    float envDAC[256];
+    const float* envDAC;
 
     /**
-     * Emulated nonlinearity of the oscillator DAC.
+     * Emulated nonlinearity of the oscillator DAC,
+     * shared among all instances.
      *
      * @See Dac
      */
-    float oscDAC[4096];
+    const float* oscDAC;
 
 private:
     /**
@@ -138,6 +181,103 @@ private:
      */
     void voiceSync(bool sync);
 
+    /**
+     * Record the oscillator events in the next cycles.
+     * The accumulators advance linearly between syncs
+     * so the MSB transitions can be found without
+     * checking every cycle.
+     *
+     * @param cycles the number of cycles that are going to be clocked
+     * @param samples samples produced so far in the current clock call
+     */
+    void recordOscillatorEvents(unsigned int cycles, int samples);
+
+    /**
+     * Record a test bit change after a control register write.
+     *
+     * @param voiceNum the voice number
+     * @param testPrev the previous test bit
+     */
+    void recordTestEvent(int voiceNum, bool testPrev);
+
+    /**
+     * Store the current state in the snapshot buffer.
+     */
+    void takeSnapshot();
+
+    /**
+     * Clock the chip taking state snapshots at regular intervals.
+     *
+     * @param cycles c64 clocks to clock
+     * @param buf audio output buffer
+     * @return number of samples produced
+     */
+    int clockSnapshots(unsigned int cycles, short* buf);
+
+    /**
+     * Clock the chip one cycle at a time capturing the voice outputs.
+     *
+     * @param cycles c64 clocks to clock
+     * @param buf audio output buffer
+     * @return number of samples produced
+     */
+    int clockCapture(unsigned int cycles, short* buf);
+
+    /**
+     * Clock the chip with the loop matching its current state.
+     *
+     * @param cycles c64 clocks to clock
+     * @param buf audio output buffer
+     * @return number of samples produced
+     */
+    int clockOutput(unsigned int cycles, short* buf);
+
+    /**
+     * Select the clock loop specialization matching
+     * the chip model and the voices' state.
+     * Must be called whenever any of them changes.
+     */
+    void updateClockFunc();
+
+    /**
+     * Clock loop specialized at compile time.
+     *
+     * @tparam Model the chip model
+     * @tparam Pulldown whether any voice has a combined waveforms pulldown table active
+     * @tparam EnvBypass whether any voice has the envelope bypassed
+     * @param cycles c64 clocks to clock
+     * @param buf audio output buffer
+     * @return number of samples produced
+     */
+    template<ChipModel Model, bool Pulldown, bool EnvBypass>
+    int clockChip(unsigned int cycles, short* buf);
+
+    /**
+     * Check if all voices are silenced by their envelopes.
+     */
+    bool voicesSilent();
+
+    /**
+     * Clock the chip while the voices are silent,
+     * entering the idle state if the filter has settled.
+     *
+     * @param cycles c64 clocks to clock
+     * @param buf audio output buffer
+     * @return number of samples produced
+     */
+    int clockSettle(unsigned int cycles, short* buf);
+
+    /**
+     * Clock loop for the idle state.
+     * The filter and mixer are skipped and their last output
+     * is fed to the external filter.
+     *
+     * @param cycles c64 clocks to clock
+     * @param buf audio output buffer
+     * @return number of samples produced
+     */
+    int clockIdle(unsigned int cycles, short* buf);
+
 public:
     SID();
     ~SID();
@@ -231,6 +371,11 @@ public:
      * is limited to slightly below 20kHz.
      * This constraint ensures that the FIR table is not overfilled.
      *
+     * Decimating at the clock frequency outputs every cycle unchanged.
+     *
+     * The same parameters keep the current resampler, and switching back
+     * to the previous ones resumes with the resampler used for them.
+     *
      * @param clockFrequency System clock frequency at Hz
      * @param method sampling method to use
      * @param samplingFrequency Desired output sampling rate
@@ -252,6 +397,59 @@ public:
      */
     int clock(unsigned int cycles, short* buf);
 
+    /**
+     * Enable recording of the oscillator phase events.
+     * Each voice records when the accumulator MSB goes high,
+     * when it's hard synced and when the test bit changes,
+     * timestamped with the output sample index.
+     *
+     * @param enable true to start recording
+     */
+    void enableOscillatorEvents(bool enable);
+
+    /**
+     * Get the oscillator events buffer.
+     *
+     * @return the buffer or nullptr if recording is disabled
+     */
+    OscillatorEventBuffer* getOscillatorEvents() const { return oscillatorEvents.get(); }
+
+    /**
+     * Enable periodic snapshots of the chip state.
+     * Frequency, pulse width, waveform and envelope of each voice
+     * and the filter registers are stored every given number
+     * of cycles, timestamped with the output sample index.
+     *
+     * @param interval cycles between snapshots, 0 to disable
+     */
+    void enableStateSnapshots(unsigned int interval);
+
+    /**
+     * Get the state snapshots buffer.
+     *
+     * @return the buffer or nullptr if snapshots are disabled
+     */
+    SIDStateBuffer* getStateSnapshots() const { return stateSnapshots.get(); }
+
+    /**
+     * Enable capture of the digital waveform and envelope
+     * outputs of each voice at the clock rate or at an integer
+     * fraction of it, for oscilloscope rendering.
+     * The chip is clocked one cycle at a time while capturing.
+     *
+     * @param decimation cycles per captured entry, 0 to disable
+     * @param minMax true to keep the min and max values of each
+     *               entry's cycles instead of the last one
+     */
+    void enableWaveformCapture(unsigned int decimation, bool minMax);
+
+    /**
+     * Get the waveform capture buffer.
+     *
+     * @return the buffer or nullptr if capture is disabled
+     */
+    WaveformCaptureBuffer* getWaveformCapture() const { return waveformCapture.get(); }
+
     /**
      * Clock SID forward with no audio production.
      *
@@ -291,19 +489,20 @@ public:
      * @param enable false to turn off filter emulation
      */
     void enableFilter(bool enable);
+
+    /**
+     * Restore the filter and waveform settings of a new chip,
+     * the power up state of the voices and filter, and stop
+     * the oscillator event, snapshot and capture streams.
+     * Chip model and sampling parameters are kept.
+     */
+    void restoreDefaults();
 };
 
 } // namespace reSIDfp
 
 #if RESID_INLINING || defined(SID_CPP)
 
-#include <algorithm>
-
-#include "Filter.h"
-#include "ExternalFilter.h"
-#include "Voice.h"
-#include "resample/Resampler.h"
-
 namespace reSIDfp
 {
 
@@ -322,49 +521,47 @@ void SID::ageBusValue(unsigned int n)
     }
 }
 
+RESID_INLINE
+bool SID::voicesSilent()
+{
+    return silentEnvDAC
+        && voice[0].envelope()->isSilent()
+        && voice[1].envelope()->isSilent()
+        && voice[2].envelope()->isSilent();
+}
+
+RESID_INLINE
+int SID::clockOutput(unsigned int cycles, short* buf)
+{
+    if (idle)
+    {
+        return clockIdle(cycles, buf);
+    }
+
+    if (likely(!voicesSilent()))
+    {
+        return (this->*clockFunc)(cycles, buf);
+    }
+
+    return clockSettle(cycles, buf);
+}
+
 RESID_INLINE
 int SID::clock(unsigned int cycles, short* buf)
 {
     ageBusValue(cycles);
-    int s = 0;
 
-    while (cycles != 0)
+    if (unlikely(stateSnapshots))
     {
-        unsigned int delta_t = std::min(nextVoiceSync, cycles);
-
-        if (likely(delta_t > 0))
-        {
-            for (unsigned int i = 0; i < delta_t; i++)
-            {
-                // clock waveform generators
-                voice[0].wave()->clock();
-                voice[1].wave()->clock();
-                voice[2].wave()->clock();
-
-                // clock envelope generators
-                voice[0].envelope()->clock();
-                voice[1].envelope()->clock();
-                voice[2].envelope()->clock();
-
-                const int sidOutput = static_cast<int>(filter->clock(voice[0], voice[1], voice[2]));
-                const int c64Output = externalFilter.clock(sidOutput - (1 << 15));
-                if (unlikely(resampler->input(c64Output)))
-                {
-                    buf[s++] = resampler->getOutput(scaleFactor);
-                }
-            }
-
-            cycles -= delta_t;
-            nextVoiceSync -= delta_t;
-        }
+        return clockSnapshots(cycles, buf);
+    }
 
-        if (unlikely(nextVoiceSync == 0))
-        {
-            voiceSync(true);
-        }
+    if (unlikely(waveformCapture))
+    {
+        return clockCapture(cycles, buf);
     }
 
-    return s;
+    return clockOutput(cycles, buf);
 }
 
 } // namespace reSIDfp
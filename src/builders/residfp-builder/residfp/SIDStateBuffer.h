@@ -0,0 +1,134 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SIDSTATEBUFFER_H
+#define SIDSTATEBUFFER_H
+
+#include <atomic>
+
+#include "siddefs-fp.h"
+
+#include "sidcxx11.h"
+
+namespace reSIDfp
+{
+
+/**
+ * Fixed size lock-free ring buffer of chip state snapshots,
+ * with a single producer (the emulation) and a single consumer.
+ *
+ * Each parameter is stored in its own array so that consumers
+ * interested in a single parameter, e.g. a piano roll reading
+ * only the frequencies, touch as little memory as possible.
+ * Snapshots are dropped if the buffer is full.
+ */
+class SIDStateBuffer
+{
+public:
+    /// Buffer size, must be a power of 2
+    static constexpr unsigned int SIZE = 1024;
+
+    /// Output sample index at the time of the snapshot
+    unsigned int sample[SIZE];
+
+    /// Voice parameters
+    //@{
+    unsigned short freq[3][SIZE];
+    unsigned short pw[3][SIZE];
+    unsigned char waveform[3][SIZE];
+    unsigned char envelope[3][SIZE];
+    unsigned char envelopeState[3][SIZE];
+    //@}
+
+    /// Filter parameters
+    //@{
+    unsigned short fc[SIZE];
+    unsigned char resFilt[SIZE];
+    unsigned char modeVol[SIZE];
+    //@}
+
+private:
+    /// Next slot to be written
+    std::atomic<unsigned int> head;
+
+    /// Next slot to be read
+    std::atomic<unsigned int> tail;
+
+public:
+    SIDStateBuffer() :
+        head(0),
+        tail(0) {}
+
+    /**
+     * Get the slot for the next snapshot, producer side.
+     *
+     * @return the slot index or -1 if the buffer is full
+     */
+    int beginWrite() const
+    {
+        const unsigned int h = head.load(std::memory_order_relaxed);
+
+        if (unlikely(h - tail.load(std::memory_order_acquire) == SIZE))
+            return -1;
+
+        return h & (SIZE - 1);
+    }
+
+    /**
+     * Publish the snapshot written in the slot returned by #beginWrite.
+     */
+    void endWrite()
+    {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * Get the number of snapshots available, consumer side.
+     */
+    unsigned int available() const
+    {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Get the slot of an available snapshot, consumer side.
+     *
+     * @param i the snapshot number, from 0 (the oldest) to #available() - 1
+     * @return the slot index in the parameter arrays
+     */
+    unsigned int index(unsigned int i) const
+    {
+        return (tail.load(std::memory_order_relaxed) + i) & (SIZE - 1);
+    }
+
+    /**
+     * Release the oldest snapshots, consumer side.
+     *
+     * @param count the number of snapshots to release
+     */
+    void consume(unsigned int count)
+    {
+        tail.store(tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+};
+
+} // namespace reSIDfp
+
+#endif
@@ -0,0 +1,255 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "TableCache.h"
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#if defined(HAVE_SYS_MMAN_H) && defined(HAVE_UNISTD_H)
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  define USE_MMAP
+#endif
+
+#ifdef _WIN32
+#  include <process.h>
+#  define getpid _getpid
+#elif defined(HAVE_UNISTD_H)
+#  include <unistd.h>
+#endif
+
+#include "sidcxx11.h"
+
+namespace reSIDfp
+{
+
+/**
+ * Bump whenever the layout or the content of the tables changes
+ * in a way not covered by the key.
+ */
+constexpr uint32_t CACHE_VERSION = 1;
+
+constexpr char CACHE_MAGIC[8] = { 'R', 'E', 'S', 'I', 'D', 'F', 'P', 0 };
+
+struct CacheHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t key;
+    uint64_t size;
+    uint64_t checksum;
+    uint64_t reserved[3];
+};
+
+static_assert(sizeof(CacheHeader) == 64, "Unexpected cache header size");
+
+/// Makes temporary file names unique across threads
+static std::atomic<unsigned int> tmpCounter(0);
+
+constexpr uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+/**
+ * FNV-1a variant working on 64 bit words, fast enough
+ * to validate the tables on every load.
+ */
+static uint64_t checksum(const void* data, size_t size)
+{
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t h = FNV_OFFSET;
+
+    for (size_t i = 0; i < size; i += sizeof(uint64_t))
+    {
+        uint64_t w;
+        std::memcpy(&w, p + i, sizeof(uint64_t));
+        h ^= w;
+        h *= FNV_PRIME;
+    }
+
+    return h;
+}
+
+uint64_t TableCache::hash(const void* data, size_t length, uint64_t seed)
+{
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t h = seed ? seed : FNV_OFFSET;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        h ^= p[i];
+        h *= FNV_PRIME;
+    }
+
+    return h;
+}
+
+TableCache::TableCache(const char* name, uint64_t key, size_t size) :
+    key(key),
+    size(size),
+    mapping(nullptr),
+    mappingSize(0)
+{
+    const char* dir = std::getenv("RESIDFP_CACHE_DIR");
+
+    if (dir && *dir)
+    {
+        path.append(dir).append("/").append(name);
+    }
+}
+
+TableCache::~TableCache()
+{
+    release();
+}
+
+void TableCache::release()
+{
+    if (mapping == nullptr)
+        return;
+
+#ifdef USE_MMAP
+    munmap(mapping, mappingSize);
+#else
+    delete [] static_cast<char*>(mapping);
+#endif
+    mapping = nullptr;
+    mappingSize = 0;
+}
+
+const void* TableCache::load()
+{
+    if (path.empty())
+        return nullptr;
+
+    release();
+
+    const size_t fileSize = sizeof(CacheHeader) + size;
+
+#ifdef USE_MMAP
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return nullptr;
+
+    struct stat st;
+    if ((fstat(fd, &st) != 0) || (static_cast<size_t>(st.st_size) != fileSize))
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    void* addr = mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (addr == MAP_FAILED)
+        return nullptr;
+
+    mapping = addr;
+    mappingSize = fileSize;
+#else
+    std::ifstream is(path.c_str(), std::ios::in | std::ios::binary);
+    if (is.fail())
+        return nullptr;
+
+    char* buffer = new char[fileSize];
+    is.read(buffer, fileSize);
+    if ((is.gcount() != static_cast<std::streamsize>(fileSize)) || (is.peek() != EOF))
+    {
+        delete [] buffer;
+        return nullptr;
+    }
+
+    mapping = buffer;
+    mappingSize = fileSize;
+#endif
+
+    const CacheHeader* header = static_cast<const CacheHeader*>(mapping);
+    const char* data = static_cast<const char*>(mapping) + sizeof(CacheHeader);
+
+    if ((std::memcmp(header->magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0)
+        || (header->version != CACHE_VERSION)
+        || (header->headerSize != sizeof(CacheHeader))
+        || (header->key != key)
+        || (header->size != size)
+        || (header->checksum != checksum(data, size)))
+    {
+        release();
+        return nullptr;
+    }
+
+    return data;
+}
+
+void TableCache::store(const void* data) const
+{
+    if (path.empty())
+        return;
+
+    CacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.headerSize = sizeof(CacheHeader);
+    header.key = key;
+    header.size = size;
+    header.checksum = checksum(data, size);
+
+    // Write to a private file and rename it so that
+    // concurrent readers never see a partial file
+    const std::string tmpPath = path + "." + std::to_string(getpid())
+        + "." + std::to_string(tmpCounter++) + ".tmp";
+
+    {
+        std::ofstream os(tmpPath.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (os.fail())
+            return;
+
+        os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        os.write(static_cast<const char*>(data), size);
+        os.close();
+
+        if (os.fail())
+        {
+            std::remove(tmpPath.c_str());
+            return;
+        }
+    }
+
+#ifdef _WIN32
+    // rename doesn't replace existing files
+    std::remove(path.c_str());
+#endif
+
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        std::remove(tmpPath.c_str());
+    }
+}
+
+} // namespace reSIDfp
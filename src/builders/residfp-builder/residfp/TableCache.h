@@ -0,0 +1,106 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef TABLECACHE_H
+#define TABLECACHE_H
+
+#include <cstddef>
+#include <string>
+
+#include <stdint.h>
+
+namespace reSIDfp
+{
+
+/**
+ * Persistent on-disk cache for precomputed lookup tables.
+ *
+ * The cache is enabled by setting the RESIDFP_CACHE_DIR environment
+ * variable to an existing writable directory.
+ * Each file holds a single blob of tables preceded by a header with
+ * a format version, a key identifying the parameters the tables were
+ * built with and a checksum of the data.
+ * Valid files are mapped read-only where supported so that
+ * the pages are shared among processes.
+ * A missing, corrupted or stale file is silently ignored
+ * and replaced when the tables are stored.
+ */
+class TableCache
+{
+private:
+    /// Full path of the cache file, empty if caching is disabled
+    std::string path;
+
+    /// Key of the expected content
+    const uint64_t key;
+
+    /// Size of the data in bytes
+    const size_t size;
+
+    /// Start of the file mapping or of the buffer holding the file
+    void* mapping;
+
+    /// Size of the mapping
+    size_t mappingSize;
+
+private:
+    TableCache(const TableCache&) = delete;
+    TableCache& operator= (const TableCache&) = delete;
+
+    void release();
+
+public:
+    /**
+     * Calculate the key for a set of parameters.
+     *
+     * @param data the parameters
+     * @param length size of the parameters in bytes
+     * @param seed the key to combine with, 0 to start a new one
+     * @return the new key
+     */
+    static uint64_t hash(const void* data, size_t length, uint64_t seed);
+
+    /**
+     * @param name the cache file name
+     * @param key hash of the parameters the tables depend on
+     * @param size size of the tables in bytes, must be a multiple of 8
+     */
+    TableCache(const char* name, uint64_t key, size_t size);
+    ~TableCache();
+
+    /**
+     * Load the tables from the cache file.
+     *
+     * @return pointer to the read-only tables or nullptr if not available
+     */
+    const void* load();
+
+    /**
+     * Write the tables to the cache file.
+     * Failures are ignored.
+     *
+     * @param data the tables
+     */
+    void store(const void* data) const;
+};
+
+} // namespace reSIDfp
+
+#endif
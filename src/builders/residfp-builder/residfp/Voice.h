@@ -41,10 +41,10 @@ private:
     EnvelopeGenerator envelopeGenerator;
 
     /// The DAC LUT for analog waveform output
-    float* wavDAC; //-V730_NOINIT this is initialized in the SID constructor
+    const float* wavDAC; //-V730_NOINIT this is initialized in the SID constructor
 
     /// The DAC LUT for analog envelope output
-    float* envDAC; //-V730_NOINIT this is initialized in the SID constructor
+    const float* envDAC; //-V730_NOINIT this is initialized in the SID constructor
 
 public:
     /**
@@ -72,13 +72,30 @@ public:
         return wavDAC[wav] * envDAC[env];
     }
 
+    /**
+     * Amplitude modulated waveform output, specialized on chip model,
+     * combined waveforms pulldown and envelope bypass.
+     *
+     * @see WaveformGenerator::output()
+     * @see EnvelopeGenerator::output()
+     * @return the voice analog output
+     */
+    template<bool Is6581, bool Pulldown, bool EnvBypass>
+    float output()
+    {
+        unsigned int const wav = waveformGenerator.output<Is6581, Pulldown>();
+        unsigned int const env = envelopeGenerator.output<EnvBypass>();
+
+        return wavDAC[wav] * envDAC[env];
+    }
+
     /**
      * Set the analog DAC emulation for waveform generator.
      * Must be called before any operation.
      *
      * @param dac
      */
-    void setWavDAC(float* dac) { wavDAC = dac; }
+    void setWavDAC(const float* dac) { wavDAC = dac; }
 
     /**
      * Set the analog DAC emulation for envelope.
@@ -86,7 +103,7 @@ public:
      *
      * @param dac
      */
-    void setEnvDAC(float* dac) { envDAC = dac; }
+    void setEnvDAC(const float* dac) { envDAC = dac; }
 
     /**
      * Set the modulator voice.
@@ -121,6 +138,16 @@ public:
         waveformGenerator.reset();
         envelopeGenerator.reset();
     }
+
+    /**
+     * Restore the power up state, including
+     * what SID reset leaves alone.
+     */
+    void powerUp()
+    {
+        waveformGenerator.powerUp();
+        envelopeGenerator.powerUp();
+    }
 };
 
 } // namespace reSIDfp
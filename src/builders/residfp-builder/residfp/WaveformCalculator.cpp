@@ -21,6 +21,10 @@
 
 #include "WaveformCalculator.h"
 
+#ifdef RESIDFP_PREBUILT_TABLES
+#  include "PrebuiltTables.h"
+#endif
+
 #include "sidcxx11.h"
 
 #include <map>
@@ -170,11 +174,13 @@ const CombinedWaveformConfig configStrong[2][5] =
     },
 };
 
+#ifndef RESIDFP_PREBUILT_TABLES
 /// Calculate triangle waveform
 static unsigned int triXor(unsigned int val)
 {
     return (((val & 0x800) == 0) ? val : (val ^ 0xfff)) << 1;
 }
+#endif
 
 /**
  * Generate bitstate based on emulation of combined waves pulldown.
@@ -231,6 +237,11 @@ short calculatePulldown(float distancetable[], float topbit, float pulsestrength
     return value;
 }
 
+#ifdef RESIDFP_PREBUILT_TABLES
+WaveformCalculator::WaveformCalculator() :
+    wftable(&prebuiltWaveTable[0][0], 4, 4096)
+{}
+#else
 WaveformCalculator::WaveformCalculator() :
     wftable(4, 4096)
 {
@@ -246,6 +257,7 @@ WaveformCalculator::WaveformCalculator() :
         wftable[3][idx] = saw & (saw << 1);
     }
 }
+#endif
 
 matrix_t* WaveformCalculator::buildPulldownTable(ChipModel model, CombinedWaveforms cws)
 {
@@ -275,6 +287,10 @@ matrix_t* WaveformCalculator::buildPulldownTable(ChipModel model, CombinedWavefo
         return &(lb->second);
     }
 
+#ifdef RESIDFP_PREBUILT_TABLES
+    const int cwsIdx = (cws == WEAK) ? 1 : (cws == STRONG) ? 2 : 0;
+    matrix_t pdTable(&prebuiltPulldownTable[modelIdx][cwsIdx][0][0], 5, 4096);
+#else
     matrix_t pdTable(5, 4096);
 
     for (int wav = 0; wav < 5; wav++)
@@ -296,6 +312,7 @@ matrix_t* WaveformCalculator::buildPulldownTable(ChipModel model, CombinedWavefo
             pdTable[wav][idx] = calculatePulldown(distancetable, cfg.topbit, cfg.pulsestrength, cfg.threshold, idx);
         }
     }
+#endif
 
     return &(PULLDOWN_CACHE.emplace_hint(lb, cw_cache_t::value_type(cfgArray, pdTable))->second);
 }
@@ -0,0 +1,233 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef WAVEFORMCAPTUREBUFFER_H
+#define WAVEFORMCAPTUREBUFFER_H
+
+#include <atomic>
+#include <memory>
+
+#include "siddefs-fp.h"
+
+#include "sidcxx11.h"
+
+namespace reSIDfp
+{
+
+/**
+ * Lock-free ring buffer of the digital voice outputs,
+ * with a single producer (the emulation) and a single consumer.
+ *
+ * The 12 bit waveform and the 8 bit envelope of each voice
+ * are captured every cycle and reduced to one entry
+ * every #decimation cycles, either by taking the last value
+ * or by keeping the minimum and the maximum in the bucket.
+ * Each value is stored in its own array; without the min/max
+ * reduction the max arrays alias the min ones.
+ * Entries are dropped if the buffer is full.
+ */
+class WaveformCaptureBuffer
+{
+public:
+    /// Buffer size, must be a power of 2
+    static constexpr unsigned int SIZE = 1 << 16;
+
+private:
+    std::unique_ptr<unsigned short[]> waveData;
+    std::unique_ptr<unsigned char[]> envData;
+
+public:
+    /// Waveform output in the bucket, 12 bits
+    //@{
+    unsigned short* waveMin[3];
+    unsigned short* waveMax[3];
+    //@}
+
+    /// Envelope output in the bucket, 8 bits
+    //@{
+    unsigned char* envMin[3];
+    unsigned char* envMax[3];
+    //@}
+
+private:
+    /// Cycles per entry
+    const unsigned int decimation;
+
+    /// Keep the min and max values instead of the last one
+    const bool minMax;
+
+    /// Cycles accumulated in the current bucket
+    unsigned int count;
+
+    /// Current bucket
+    //@{
+    unsigned int curWaveMin[3];
+    unsigned int curWaveMax[3];
+    unsigned int curEnvMin[3];
+    unsigned int curEnvMax[3];
+    //@}
+
+    /// Next slot to be written
+    std::atomic<unsigned int> head;
+
+    /// Next slot to be read
+    std::atomic<unsigned int> tail;
+
+    /// Number of entries lost because the buffer was full
+    std::atomic<unsigned int> dropped;
+
+private:
+    void resetBucket()
+    {
+        count = 0;
+
+        for (int v = 0; v < 3; v++)
+        {
+            curWaveMin[v] = 0xfff;
+            curWaveMax[v] = 0;
+            curEnvMin[v] = 0xff;
+            curEnvMax[v] = 0;
+        }
+    }
+
+    void store(const unsigned int wave[3], const unsigned int env[3])
+    {
+        const unsigned int h = head.load(std::memory_order_relaxed);
+
+        if (unlikely(h - tail.load(std::memory_order_acquire) == SIZE))
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        const unsigned int i = h & (SIZE - 1);
+
+        for (int v = 0; v < 3; v++)
+        {
+            if (minMax)
+            {
+                waveMin[v][i] = static_cast<unsigned short>(curWaveMin[v]);
+                waveMax[v][i] = static_cast<unsigned short>(curWaveMax[v]);
+                envMin[v][i] = static_cast<unsigned char>(curEnvMin[v]);
+                envMax[v][i] = static_cast<unsigned char>(curEnvMax[v]);
+            }
+            else
+            {
+                waveMin[v][i] = static_cast<unsigned short>(wave[v]);
+                envMin[v][i] = static_cast<unsigned char>(env[v]);
+            }
+        }
+
+        head.store(h + 1, std::memory_order_release);
+    }
+
+public:
+    /**
+     * @param decimation cycles per entry, at least 1
+     * @param minMax true to keep the min and max values in each bucket
+     */
+    WaveformCaptureBuffer(unsigned int decimation, bool minMax) :
+        waveData(new unsigned short[SIZE * 3 * (minMax ? 2 : 1)]),
+        envData(new unsigned char[SIZE * 3 * (minMax ? 2 : 1)]),
+        decimation(decimation),
+        minMax(minMax),
+        head(0),
+        tail(0),
+        dropped(0)
+    {
+        for (int v = 0; v < 3; v++)
+        {
+            waveMin[v] = waveData.get() + v * SIZE;
+            envMin[v] = envData.get() + v * SIZE;
+            waveMax[v] = minMax ? waveMin[v] + 3 * SIZE : waveMin[v];
+            envMax[v] = minMax ? envMin[v] + 3 * SIZE : envMin[v];
+        }
+
+        resetBucket();
+    }
+
+    unsigned int getDecimation() const { return decimation; }
+
+    bool isMinMax() const { return minMax; }
+
+    /**
+     * Add the outputs of one cycle, producer side.
+     *
+     * @param wave the waveform output of the voices
+     * @param env the envelope output of the voices
+     */
+    void input(const unsigned int wave[3], const unsigned int env[3])
+    {
+        if (minMax)
+        {
+            for (int v = 0; v < 3; v++)
+            {
+                if (wave[v] < curWaveMin[v]) curWaveMin[v] = wave[v];
+                if (wave[v] > curWaveMax[v]) curWaveMax[v] = wave[v];
+                if (env[v] < curEnvMin[v]) curEnvMin[v] = env[v];
+                if (env[v] > curEnvMax[v]) curEnvMax[v] = env[v];
+            }
+        }
+
+        if (++count == decimation)
+        {
+            store(wave, env);
+            resetBucket();
+        }
+    }
+
+    /**
+     * Get the number of entries available, consumer side.
+     */
+    unsigned int available() const
+    {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Get the slot of an available entry, consumer side.
+     *
+     * @param i the entry number, from 0 (the oldest) to #available() - 1
+     * @return the slot index in the value arrays
+     */
+    unsigned int index(unsigned int i) const
+    {
+        return (tail.load(std::memory_order_relaxed) + i) & (SIZE - 1);
+    }
+
+    /**
+     * Release the oldest entries, consumer side.
+     *
+     * @param n the number of entries to release
+     */
+    void consume(unsigned int n)
+    {
+        tail.store(tail.load(std::memory_order_relaxed) + n, std::memory_order_release);
+    }
+
+    /**
+     * Get and reset the number of dropped entries.
+     */
+    unsigned int readDropped() { return dropped.exchange(0, std::memory_order_relaxed); }
+};
+
+} // namespace reSIDfp
+
+#endif
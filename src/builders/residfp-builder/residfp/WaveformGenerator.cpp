@@ -325,12 +325,12 @@ void WaveformGenerator::set_noise_output()
     set_no_noise_or_noise_output();
 }
 
-void WaveformGenerator::setWaveformModels(matrix_t* models)
+void WaveformGenerator::setWaveformModels(const matrix_t* models)
 {
     model_wave = models;
 }
 
-void WaveformGenerator::setPulldownModels(matrix_t* models)
+void WaveformGenerator::setPulldownModels(const matrix_t* models)
 {
     model_pulldown = models;
 }
@@ -494,4 +494,15 @@ void WaveformGenerator::reset()
     floating_output_ttl = 0;
 }
 
+void WaveformGenerator::powerUp()
+{
+    accumulator = 0x555555;
+    tri_saw_pipeline = 0x555;
+    drive_msb_low = false;
+    noise_output = 0;
+    no_noise_or_noise_output = 0;
+
+    reset();
+}
+
 } // namespace reSIDfp
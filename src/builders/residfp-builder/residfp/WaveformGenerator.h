@@ -93,11 +93,11 @@ namespace reSIDfp
 class WaveformGenerator
 {
 private:
-    matrix_t* model_wave = nullptr;
-    matrix_t* model_pulldown = nullptr;
+    const matrix_t* model_wave = nullptr;
+    const matrix_t* model_pulldown = nullptr;
 
-    short* wave = nullptr;
-    short* pulldown = nullptr;
+    const short* wave = nullptr;
+    const short* pulldown = nullptr;
 
     // PWout = (PWn/40.95)%
     unsigned int pw = 0;
@@ -177,8 +177,8 @@ private:
     void shiftregBitfade();
 
 public:
-    void setWaveformModels(matrix_t* models);
-    void setPulldownModels(matrix_t* models);
+    void setWaveformModels(const matrix_t* models);
+    void setPulldownModels(const matrix_t* models);
 
     void setOtherWaveforms(const WaveformGenerator* prev, WaveformGenerator* next)
     {
@@ -199,6 +199,18 @@ public:
      */
     void clock();
 
+    /**
+     * SID clocking - multiple cycles.
+     * The accumulator is advanced in a single step up to the cycle
+     * before the noise shift register is clocked, with the same result
+     * as calling clock() for each cycle. The last cycle is always
+     * clocked normally so that the MSB state is correct for syncing.
+     * Note that the waveform output is not evaluated in between.
+     *
+     * @param cycles the number of cycles to clock
+     */
+    void clock(unsigned int cycles);
+
     /**
      * Synchronize oscillators.
      * This must be done after all the oscillators have been clock()'ed,
@@ -248,6 +260,11 @@ public:
      */
     void reset();
 
+    /**
+     * Restore the power up state, accumulator included.
+     */
+    void powerUp();
+
     /**
      * 12-bit waveform output.
      *
@@ -255,11 +272,32 @@ public:
      */
     unsigned int output();
 
+    /**
+     * 12-bit waveform output, specialized on chip model
+     * and combined waveforms pulldown.
+     *
+     * @tparam Is6581 must match the model set with setModel
+     * @tparam Pulldown if false no pulldown table must be active
+     * @return the waveform generator digital output
+     */
+    template<bool Is6581, bool Pulldown>
+    unsigned int output();
+
+    /**
+     * Check if a combined waveforms pulldown table is active.
+     */
+    bool hasPulldown() const { return pulldown != nullptr; }
+
     /**
      * Read OSC3 value.
      */
     unsigned char readOSC() const { return static_cast<unsigned char>(osc3 >> 4); }
 
+    /**
+     * Read the full 12 bit waveform output computed by the last #output call.
+     */
+    unsigned int readWaveformOutput() const { return waveform_output; }
+
     /**
      * Read accumulator value.
      */
@@ -270,6 +308,16 @@ public:
      */
     unsigned int readFreq() const { return freq; }
 
+    /**
+     * Read pulse width value.
+     */
+    unsigned int readPW() const { return pw; }
+
+    /**
+     * Read the selected waveform, control register bits 4-7.
+     */
+    unsigned int readWaveform() const { return waveform; }
+
     /**
      * Read test value.
      */
@@ -280,9 +328,72 @@ public:
      */
     bool readFollowingVoiceSync() const { return nextVoice->sync; }
 
-    bool triggerwaves;
+    bool triggerwaves = false;
 };
 
+template<bool Is6581, bool Pulldown>
+inline unsigned int WaveformGenerator::output()
+{
+    // Set output value.
+    if (likely(waveform != 0))
+    {
+        const unsigned int ix = (accumulator ^ (~prevVoice->accumulator & ring_msb_mask)) >> 12;
+
+        // The bit masks no_pulse and no_noise are used to achieve branch-free
+        // calculation of the output value.
+        waveform_output = wave[ix] & (no_pulse | pulse_output) & no_noise_or_noise_output;
+        if (Pulldown && (pulldown != nullptr))
+            waveform_output = pulldown[waveform_output];
+
+        // Triangle/Sawtooth output is delayed half cycle on 8580.
+        // This will appear as a one cycle delay on OSC3 as it is latched
+        // in the first phase of the clock.
+        if ((waveform & 3) && !Is6581)
+        {
+            osc3 = tri_saw_pipeline & (no_pulse | pulse_output) & no_noise_or_noise_output;
+            if (Pulldown && (pulldown != nullptr))
+                osc3 = pulldown[osc3];
+            tri_saw_pipeline = wave[ix];
+        }
+        else
+        {
+            osc3 = waveform_output;
+        }
+
+        if (drive_msb_low)
+        {
+            msb_rising = false;
+            accumulator &= 0x7fffff;
+        }
+
+        write_shift_register();
+    }
+    else
+    {
+        // Age floating DAC input.
+        if (likely(floating_output_ttl != 0) && unlikely(--floating_output_ttl == 0))
+        {
+            waveBitfade();
+        }
+    }
+
+    // The pulse level is defined as (accumulator >> 12) >= pw ? 0xfff : 0x000.
+    // The expression -((accumulator >> 12) >= pw) & 0xfff yields the same
+    // results without any branching (and thus without any pipeline stalls).
+    // NB! This expression relies on that the result of a boolean expression
+    // is either 0 or 1, and furthermore requires two's complement integer.
+    // A few more cycles may be saved by storing the pulse width left shifted
+    // 12 bits, and dropping the and with 0xfff (this is valid since pulse is
+    // used as a bit mask on 12 bit values), yielding the expression
+    // -(accumulator >= pw24). However this only results in negligible savings.
+
+    // The result of the pulse width compare is delayed one cycle.
+    // Push next pulse level into pulse level pipeline.
+    pulse_output = ((accumulator >> 12) >= pw) ? 0xfff : 0x000;
+
+    return waveform_output;
+}
+
 } // namespace reSIDfp
 
 #if RESID_INLINING || defined(WAVEFORMGENERATOR_CPP)
@@ -356,66 +467,39 @@ void WaveformGenerator::clock()
 }
 
 RESID_INLINE
-unsigned int WaveformGenerator::output()
+void WaveformGenerator::clock(unsigned int cycles)
 {
-    // Set output value.
-    if (likely(waveform != 0))
+    while (cycles != 0)
     {
-        const unsigned int ix = (accumulator ^ (~prevVoice->accumulator & ring_msb_mask)) >> 12;
-
-        // The bit masks no_pulse and no_noise are used to achieve branch-free
-        // calculation of the output value.
-        waveform_output = wave[ix] & (no_pulse | pulse_output) & no_noise_or_noise_output;
-        if (pulldown != nullptr)
-            waveform_output = pulldown[waveform_output];
-
-        // Triangle/Sawtooth output is delayed half cycle on 8580.
-        // This will appear as a one cycle delay on OSC3 as it is latched
-        // in the first phase of the clock.
-        if ((waveform & 3) && !is6581)
+        if (!test && (shift_pipeline == 0) && (cycles > 1))
         {
-            osc3 = tri_saw_pipeline & (no_pulse | pulse_output) & no_noise_or_noise_output;
-            if (pulldown != nullptr)
-                osc3 = pulldown[osc3];
-            tri_saw_pipeline = wave[ix];
-        }
-        else
-        {
-            osc3 = waveform_output;
-        }
+            // Cycles before accumulator bit 19 can be set high,
+            // the frequency is at most 16 bits so it can't skip a whole period
+            const unsigned int low = accumulator & 0xfffff;
+            const unsigned int room = ((low < 0x80000) ? 0x7ffff : 0x17ffff) - low;
+            unsigned int skip = cycles - 1;
+
+            // Avoid the division for short runs
+            if ((freq != 0) && ((skip > 0xffff) || (skip * freq > room)))
+            {
+                const unsigned int steps = room / freq;
+                if (steps < skip)
+                    skip = steps;
+            }
 
-        if (drive_msb_low)
-        {
-            msb_rising = false;
-            accumulator &= 0x7fffff;
+            accumulator = (accumulator + skip * freq) & 0xffffff;
+            cycles -= skip;
         }
 
-        write_shift_register();
+        clock();
+        cycles--;
     }
-    else
-    {
-        // Age floating DAC input.
-        if (likely(floating_output_ttl != 0) && unlikely(--floating_output_ttl == 0))
-        {
-            waveBitfade();
-        }
-    }
-
-    // The pulse level is defined as (accumulator >> 12) >= pw ? 0xfff : 0x000.
-    // The expression -((accumulator >> 12) >= pw) & 0xfff yields the same
-    // results without any branching (and thus without any pipeline stalls).
-    // NB! This expression relies on that the result of a boolean expression
-    // is either 0 or 1, and furthermore requires two's complement integer.
-    // A few more cycles may be saved by storing the pulse width left shifted
-    // 12 bits, and dropping the and with 0xfff (this is valid since pulse is
-    // used as a bit mask on 12 bit values), yielding the expression
-    // -(accumulator >= pw24). However this only results in negligible savings.
-
-    // The result of the pulse width compare is delayed one cycle.
-    // Push next pulse level into pulse level pipeline.
-    pulse_output = ((accumulator >> 12) >= pw) ? 0xfff : 0x000;
+}
 
-    return waveform_output;
+RESID_INLINE
+unsigned int WaveformGenerator::output()
+{
+    return is6581 ? output<true, true>() : output<false, true>();
 }
 
 } // namespace reSIDfp
@@ -44,6 +44,7 @@ public:
 
 /**
  * Reference counted pointer to matrix wrapper, for use with standard containers.
+ * May also wrap static read-only data, which is never freed nor written.
  */
 template<typename T>
 class matrix
@@ -60,13 +61,19 @@ public:
         x(x),
         y(y) {}
 
+    matrix(const T* staticData, unsigned int x, unsigned int y) :
+        data(const_cast<T*>(staticData)),
+        count(nullptr),
+        x(x),
+        y(y) {}
+
     matrix(const matrix& p) :
         data(p.data),
         count(p.count),
         x(p.x),
-        y(p.y) { count->increase(); }
+        y(p.y) { if (count) count->increase(); }
 
-    ~matrix() { if (count->decrease() == 0) { delete count; delete [] data; } }
+    ~matrix() { if (count && (count->decrease() == 0)) { delete count; delete [] data; } }
 
     unsigned int length() const { return x * y; }
 
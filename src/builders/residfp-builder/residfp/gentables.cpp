@@ -0,0 +1,114 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+/*
+ * Generate the source file with the tables declared in PrebuiltTables.h
+ * using the same code that would compute them at runtime.
+ */
+
+#include <cstdio>
+
+#include "Dac.h"
+#include "WaveformCalculator.h"
+
+using namespace reSIDfp;
+
+static void printShorts(const short* data, unsigned int length)
+{
+    for (unsigned int i = 0; i < length; i++)
+    {
+        std::printf("%d,%c", data[i], ((i % 16) == 15) ? '\n' : ' ');
+    }
+}
+
+static void printFloats(const float* data, unsigned int length)
+{
+    // 9 significant digits are enough to round-trip a float
+    for (unsigned int i = 0; i < length; i++)
+    {
+        std::printf("%.8ef,%c", data[i], ((i % 4) == 3) ? '\n' : ' ');
+    }
+}
+
+int main()
+{
+    const ChipModel models[2] = { MOS6581, MOS8580 };
+    const CombinedWaveforms strengths[3] = { AVERAGE, WEAK, STRONG };
+
+    std::printf("// Generated by gentables, do not edit.\n\n");
+    std::printf("#include \"PrebuiltTables.h\"\n\n");
+    std::printf("namespace reSIDfp\n{\n\n");
+
+    std::printf("const short prebuiltWaveTable[4][4096] =\n{\n");
+    const matrix_t* waveTable = WaveformCalculator::getInstance()->getWaveTable();
+    for (unsigned int wav = 0; wav < 4; wav++)
+    {
+        std::printf("{\n");
+        printShorts((*waveTable)[wav], 4096);
+        std::printf("},\n");
+    }
+    std::printf("};\n\n");
+
+    std::printf("const short prebuiltPulldownTable[2][3][5][4096] =\n{\n");
+    for (ChipModel model : models)
+    {
+        std::printf("{\n");
+        for (CombinedWaveforms cws : strengths)
+        {
+            std::printf("{\n");
+            const matrix_t* pulldownTable = WaveformCalculator::getInstance()->buildPulldownTable(model, cws);
+            for (unsigned int wav = 0; wav < 5; wav++)
+            {
+                std::printf("{\n");
+                printShorts((*pulldownTable)[wav], 4096);
+                std::printf("},\n");
+            }
+            std::printf("},\n");
+        }
+        std::printf("},\n");
+    }
+    std::printf("};\n\n");
+
+    std::printf("const float prebuiltEnvDAC[2][256] =\n{\n");
+    for (ChipModel model : models)
+    {
+        float table[256];
+        Dac::buildEnvelopeTable(model, table);
+        std::printf("{\n");
+        printFloats(table, 256);
+        std::printf("},\n");
+    }
+    std::printf("};\n\n");
+
+    std::printf("const float prebuiltOscDAC[2][4096] =\n{\n");
+    for (ChipModel model : models)
+    {
+        float table[4096];
+        Dac::buildWaveformTable(model, table);
+        std::printf("{\n");
+        printFloats(table, 4096);
+        std::printf("},\n");
+    }
+    std::printf("};\n\n");
+
+    std::printf("} // namespace reSIDfp\n");
+
+    return 0;
+}
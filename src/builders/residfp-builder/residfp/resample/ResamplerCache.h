@@ -0,0 +1,116 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef RESAMPLER_CACHE_H
+#define RESAMPLER_CACHE_H
+
+#include <memory>
+#include <utility>
+
+#include "Resampler.h"
+
+#include "siddefs-fp.h"
+
+#include "sidcxx11.h"
+
+namespace reSIDfp
+{
+
+/**
+ * Keep the resampler replaced by a change of the sampling parameters.
+ * Switching back to the previous parameters, as toggling fast forward does,
+ * then resumes with its filter history instead of restarting from silence,
+ * and setting the same parameters again keeps the current resampler.
+ */
+class ResamplerCache
+{
+private:
+    struct Parameters
+    {
+        double clockFrequency;
+        double samplingFrequency;
+        SamplingMethod method;
+
+        bool operator==(const Parameters& other) const
+        {
+            return (clockFrequency == other.clockFrequency)
+                && (samplingFrequency == other.samplingFrequency)
+                && (method == other.method);
+        }
+    };
+
+private:
+    /// Parameters of the resampler in use
+    Parameters current = { 0., 0., DECIMATE };
+
+    /// The previous resampler
+    std::unique_ptr<Resampler> spare;
+
+    /// Parameters of the previous resampler
+    Parameters spareParameters = { 0., 0., DECIMATE };
+
+public:
+    /**
+     * Switch to a resampler for the given parameters,
+     * keeping the one in use for later.
+     *
+     * @param resampler the resampler in use, replaced with a cached one if found
+     * @param clockFrequency System clock frequency at Hz
+     * @param method sampling method to use
+     * @param samplingFrequency Desired output sampling rate
+     * @return false if the caller has to create a new resampler
+     */
+    bool select(std::unique_ptr<Resampler>& resampler,
+        double clockFrequency, SamplingMethod method, double samplingFrequency)
+    {
+        const Parameters parameters = { clockFrequency, samplingFrequency, method };
+
+        if (resampler.get() && (parameters == current))
+            return true;
+
+        std::unique_ptr<Resampler> previous(std::move(resampler));
+        const Parameters previousParameters = current;
+
+        if (spare.get() && (parameters == spareParameters))
+            resampler = std::move(spare);
+
+        if (previous.get())
+        {
+            spare = std::move(previous);
+            spareParameters = previousParameters;
+        }
+
+        current = parameters;
+        return resampler.get() != nullptr;
+    }
+
+    /**
+     * Reset the kept resampler.
+     */
+    void reset()
+    {
+        if (spare.get())
+            spare->reset();
+    }
+};
+
+} // namespace reSIDfp
+
+#endif
@@ -28,7 +28,10 @@
 
 #include <algorithm>
 #include <iterator>
+#include <map>
+#include <mutex>
 #include <numeric>
+#include <tuple>
 #include <cassert>
 #include <cstring>
 #include <cmath>
@@ -54,6 +57,24 @@ constexpr double I0E = 1e-6;
 
 constexpr int BITS = 16;
 
+namespace
+{
+
+/// FIR tables are identified by filter length, resolution and clock/sampling ratio
+using firKey_t = std::tuple<int, int, double>;
+
+/**
+ * Cache of the FIR tables, shared by all the resamplers
+ * with the same parameters.
+ * Tables are never freed as the number of different
+ * configurations in a process is expected to be small.
+ */
+std::map<firKey_t, matrix_t> FIR_CACHE;
+
+std::mutex FIR_CACHE_Lock;
+
+}
+
 /**
  * Compute the 0th order modified Bessel function of the first kind.
  * This function is originally from resample-1.5/filterkit.c by J. O. Smith.
@@ -240,6 +261,13 @@ int convolve(const int* a, const short* b, int bLength)
 
 int SincResampler::fir(int subcycle)
 {
+    if (phases != 0)
+    {
+        // Exact phase, a single convolution is enough
+        const int sampleStart = sampleIndex - firN + RINGSIZE - 1;
+        return convolve(sample + sampleStart, (*firTable)[subcycle], firN);
+    }
+
     // Find the first of the nearest fir tables close to the phase
     int firTableFirst = (subcycle * firRES >> 10);
     const int firTableOffset = (subcycle * firRES) & 0x3ff;
@@ -267,8 +295,12 @@ int SincResampler::fir(int subcycle)
 SincResampler::SincResampler(
         double clockFrequency,
         double samplingFrequency,
-        double highestAccurateFrequency) :
-    cyclesPerSample(static_cast<int>(clockFrequency / samplingFrequency * 1024.))
+        double highestAccurateFrequency,
+        int phases) :
+    phases(phases),
+    offsetScale(phases != 0 ? phases : 1024),
+    cyclesPerSample(static_cast<int>(clockFrequency / samplingFrequency * offsetScale
+        + (phases != 0 ? 0.5 : 0.)))
 {
 #if defined(HAVE_CXX20) && defined(__cpp_lib_constexpr_cmath)
     constexpr double PI = std::numbers::pi;
@@ -312,7 +344,10 @@ SincResampler::SincResampler(
         assert(firN < RINGSIZE);
 
         // Error is bounded by err < 1.234 / L^2, so L = sqrt(1.234 / (2^-16)) = sqrt(1.234 * 2^16).
-        firRES = static_cast<int>(std::ceil(std::sqrt(1.234 * (1 << BITS)) * inv_cyclesPerSampleD));
+        // With exact phases there's no interpolation error at all.
+        firRES = (phases != 0)
+            ? phases
+            : static_cast<int>(std::ceil(std::sqrt(1.234 * (1 << BITS)) * inv_cyclesPerSampleD));
 
         // firN*firRES represent the total resolution of the sinc sampling. JOS
         // recommends a length of 2^BITS, but we don't quite use that good a filter.
@@ -320,8 +355,19 @@ SincResampler::SincResampler(
     }
 
     {
+        std::lock_guard<std::mutex> lock(FIR_CACHE_Lock);
+
+        const firKey_t key(firN, firRES, cyclesPerSampleD);
+        auto it = FIR_CACHE.find(key);
+        if (it != FIR_CACHE.end())
+        {
+            // Reuse the table built for an identical resampler.
+            firTable = new matrix_t(it->second);
+            return;
+        }
+
         // Allocate memory for FIR tables.
-        firTable = new matrix_t(firRES, firN);
+        firTable = new matrix_t(FIR_CACHE.emplace(key, matrix_t(firRES, firN)).first->second);
 
         // The cutoff frequency is midway through the transition band, in effect the same as nyquist.
         constexpr double wc = PI;
@@ -366,14 +412,14 @@ bool SincResampler::input(int input)
     sample[sampleIndex] = sample[sampleIndex + RINGSIZE] = input;
     sampleIndex = (sampleIndex + 1) & (RINGSIZE - 1);
 
-    if (sampleOffset < 1024)
+    if (sampleOffset < offsetScale)
     {
         outputValue = fir(sampleOffset);
         ready = true;
         sampleOffset += cyclesPerSample;
     }
 
-    sampleOffset -= 1024;
+    sampleOffset -= offsetScale;
 
     return ready;
 }
@@ -60,6 +60,15 @@ private:
     /// Filter resolution
     int firRES;
 
+    /**
+     * Number of exact filter phases for rational ratios,
+     * 0 if the phases are interpolated.
+     */
+    const int phases;
+
+    /// Resolution of the sample offset, one input sample
+    const int offsetScale;
+
     /// Filter length
     int firN;
 
@@ -69,7 +78,7 @@ private:
 
     int outputValue = 0;
 
-    int sample[RINGSIZE * 2];
+    int sample[RINGSIZE * 2] = {};
 
 private:
     int fir(int subcycle);
@@ -87,14 +96,21 @@ public:
      * A lower sample frequency would make the resampling code overfill
      * its 16k sample ring buffer.
      *
+     * If the ratio between the clock frequency and the sampling frequency
+     * is a rational number whose denominator is known, an exact polyphase
+     * filter is built instead, with one FIR table per output phase
+     * and a single convolution per output sample.
+     *
      * @param clockFrequency System clock frequency at Hz
      * @param samplingFrequency Desired output sampling rate
      * @param highestAccurateFrequency passband frequency limit
+     * @param phases denominator of the frequency ratio, 0 for arbitrary ratios
      */
     SincResampler(
         double clockFrequency,
         double samplingFrequency,
-        double highestAccurateFrequency);
+        double highestAccurateFrequency,
+        int phases = 0);
     ~SincResampler() override;
 
     bool input(int input) override;
@@ -22,6 +22,7 @@
 #ifndef TWOPASSSINCRESAMPLER_H
 #define TWOPASSSINCRESAMPLER_H
 
+#include <algorithm>
 #include <cmath>
 
 #include <memory>
@@ -43,12 +44,52 @@ private:
     std::unique_ptr<SincResampler> const s1;
     std::unique_ptr<SincResampler> const s2;
 
+private:
+    /// Largest denominator of the frequency ratio considered for exact decimation
+    static constexpr int MAX_RATIO_DENOMINATOR = 16;
+
+    /// Tolerance on the frequency ratio for exact decimation
+    static constexpr double RATIO_TOLERANCE = 1e-6;
+
 private:
     TwoPassSincResampler(double clockFrequency, double samplingFrequency, double highestAccurateFrequency, double intermediateFrequency) :
         s1(new SincResampler(clockFrequency, intermediateFrequency, highestAccurateFrequency)),
         s2(new SincResampler(intermediateFrequency, samplingFrequency, highestAccurateFrequency))
     {}
 
+    TwoPassSincResampler(double clockFrequency, double samplingFrequency, double highestAccurateFrequency,
+            double intermediateFrequency, int phases1, int phases2) :
+        s1(new SincResampler(clockFrequency, intermediateFrequency, highestAccurateFrequency, phases1)),
+        s2(new SincResampler(intermediateFrequency, samplingFrequency, highestAccurateFrequency, phases2))
+    {}
+
+    static int gcd(int a, int b)
+    {
+        while (b != 0)
+        {
+            const int t = a % b;
+            a = b;
+            b = t;
+        }
+        return a;
+    }
+
+    /**
+     * Find the smallest denominator of the clock to sampling frequency ratio.
+     *
+     * @return the denominator or 0 if the ratio is not a simple fraction
+     */
+    static int ratioDenominator(double ratio)
+    {
+        for (int den = 1; den <= MAX_RATIO_DENOMINATOR; den++)
+        {
+            const double num = ratio * den;
+            if (std::fabs(num - std::floor(num + 0.5)) < RATIO_TOLERANCE * num)
+                return den;
+        }
+        return 0;
+    }
+
 public:
     // Named constructor
     static TwoPassSincResampler* create(double clockFrequency, double samplingFrequency)
@@ -68,6 +109,24 @@ public:
             + std::sqrt(2. * halfFreq * clockFrequency
                 * (samplingFrequency - 2. * halfFreq) / samplingFrequency);
 
+        // If the sampling frequency is a simple fraction of the clock
+        // use an integer decimation factor for the first pass,
+        // rounded down to keep the intermediate frequency at least as high.
+        // Both passes can then use the exact filter phases.
+        const double ratio = clockFrequency / samplingFrequency;
+        const int den = ratioDenominator(ratio);
+
+        if (den != 0)
+        {
+            const int decimation = std::max(static_cast<int>(clockFrequency / intermediateFrequency), 1);
+            const int num = static_cast<int>(ratio * den + 0.5);
+            const int phases2 = den * decimation / gcd(num, den * decimation);
+
+            return new TwoPassSincResampler(
+                clockFrequency, samplingFrequency, halfFreq,
+                clockFrequency / decimation, 1, phases2);
+        }
+
         return new TwoPassSincResampler(
             clockFrequency, samplingFrequency, halfFreq, intermediateFrequency);
     }
@@ -25,6 +25,7 @@
 #include <iostream>
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
 
 #include "siddefs-fp.h"
 
@@ -43,12 +44,12 @@
  * Simple sin waveform in, power output measurement function.
  * It would be far better to use FFT.
  */
-int main(int, const char*[])
+static void measure(double samplingFrequency)
 {
     const double RATE = 985248.4;
     const int RINGSIZE = 2048;
 
-    std::unique_ptr<reSIDfp::TwoPassSincResampler> r(reSIDfp::TwoPassSincResampler::create(RATE, 48000.0, 20000.0));
+    std::unique_ptr<reSIDfp::TwoPassSincResampler> r(reSIDfp::TwoPassSincResampler::create(RATE, samplingFrequency));
 
     std::map<double, double> results;
     clock_t start = clock();
@@ -86,10 +87,36 @@ int main(int, const char*[])
 
     clock_t end = clock();
 
+    // Worst passband ripple and leakage of the frequencies
+    // that would alias into the passband, relative to 1kHz
+    const double passband = (samplingFrequency > 44000.) ? 20000. : samplingFrequency * 0.45;
+    const double reference = results.begin()->second;
+    double ripple = 0.;
+    double leakage = -200.;
+
     for (std::map<double, double>::iterator it = results.begin(); it != results.end(); ++it)
     {
         std::cout << std::fixed << std::setprecision(0) << std::setw(6) << (*it).first  << " Hz " << (*it).second << " dB" << std::endl;
+
+        const double level = (*it).second - reference;
+
+        if ((*it).first < passband)
+            ripple = std::max(ripple, std::fabs(level));
+        else if ((*it).first > samplingFrequency - passband)
+            leakage = std::max(leakage, level);
     }
 
+    std::cout << "Sampling frequency " << std::setprecision(1) << samplingFrequency << " Hz" << std::endl;
+    std::cout << "Passband ripple " << std::setprecision(2) << ripple << " dB" << std::endl;
+    std::cout << "Stopband leakage " << std::setprecision(1) << leakage << " dB" << std::endl;
     std::cout << "Filtering time " << (end - start) * 1000. / CLOCKS_PER_SEC << " ms" << std::endl;
 }
+
+int main(int, const char*[])
+{
+    // Arbitrary ratio, interpolated filter phases
+    measure(48000.0);
+
+    // Integer ratio, exact polyphase decimation
+    measure(985248.4 / 20.);
+}
@@ -98,6 +98,9 @@ private:
     /// Number of sources asserting IRQ
     int irqCount;
 
+    /// Number of times the IRQ line has been asserted
+    uint_least32_t irqTriggers = 0;
+
     /// BA state
     bool oldBAState;
 
@@ -258,6 +261,17 @@ public:
     sidmemory& getMemInterface() { return mmu; }
 
     uint_least16_t getCia1TimerA() const { return cia1.getTimerA(); }
+
+    /**
+     * Get the number of times the IRQ line has been asserted,
+     * usually once per call of the play routine.
+     */
+    uint_least32_t getIrqTriggers() const { return irqTriggers; }
+
+    /**
+     * Get the system RAM, for inspection only.
+     */
+    const uint8_t* getRam() const { return mmu.getRam(); }
 };
 
 void c64::interruptIRQ(bool state)
@@ -265,7 +279,10 @@ void c64::interruptIRQ(bool state)
     if (state)
     {
         if (irqCount == 0)
+        {
             cpu.triggerIRQ();
+            irqTriggers++;
+        }
 
         irqCount ++;
     }
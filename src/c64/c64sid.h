@@ -41,6 +41,16 @@ class c64sid : public Bank
 private:
     uint8_t lastpoke[0x20];
 
+    /// FNV-1a hash of the register writes since the last #getWrites
+    uint_least32_t writeHash = FNV_OFFSET;
+
+    /// Changes of the volume register since the last #getWrites
+    unsigned int volumeChanges = 0;
+
+private:
+    static constexpr uint_least32_t FNV_OFFSET = 2166136261u;
+    static constexpr uint_least32_t FNV_PRIME = 16777619u;
+
 protected:
     virtual ~c64sid() = default;
 
@@ -53,18 +63,42 @@ public:
     void reset()
     {
         std::fill(std::begin(lastpoke), std::end(lastpoke), 0);
+        writeHash = FNV_OFFSET;
+        volumeChanges = 0;
         reset(0);
     }
 
     // Bank functions
     void poke(uint_least16_t address, uint8_t value) override
     {
-        lastpoke[address & 0x1f] = value;
-        writeReg(address & 0x1f, value);
+        const uint_least8_t addr = address & 0x1f;
+
+        if ((addr == 0x18) && (lastpoke[addr] != value))
+            volumeChanges++;
+        writeHash = (writeHash ^ ((addr << 8) | value)) * FNV_PRIME;
+
+        lastpoke[addr] = value;
+        writeReg(addr, value);
     }
     uint8_t peek(uint_least16_t address) override { return read(address & 0x1f); }
 
     void getStatus(uint8_t regs[0x20]) const { std::memcpy(regs, lastpoke, 0x20); }
+
+    /**
+     * Get a hash of the register writes, values and order,
+     * since the last call.
+     *
+     * @param changes where to store the number of volume changes,
+     *        a hint for samples played through the volume register
+     */
+    uint_least32_t getWrites(unsigned int &changes)
+    {
+        const uint_least32_t hash = writeHash;
+        changes = volumeChanges;
+        writeHash = FNV_OFFSET;
+        volumeChanges = 0;
+        return hash;
+    }
 };
 
 }
@@ -107,6 +107,7 @@ public:
     void setChargen(const uint8_t* rom) override { characterRomBank.set(rom); }
 
     // RAM access methods
+    const uint8_t* getRam() const { return ramBank.ram; }
     uint8_t readMemByte(uint_least16_t addr) override { return ramBank.peek(addr); }
     uint_least16_t readMemWord(uint_least16_t addr) override { return endian_little16(ramBank.ram+addr); }
 
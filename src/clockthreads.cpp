@@ -0,0 +1,93 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "clockthreads.h"
+
+#include "sidemu.h"
+
+namespace libsidplayfp
+{
+
+ClockThreads::ClockThreads(const std::vector<sidemu*>& chips) :
+    m_chips(chips),
+    m_pending(0)
+{
+    for (size_t i = 1; i < m_chips.size(); i++)
+    {
+        m_threads.emplace_back(&ClockThreads::worker, this, m_chips[i]);
+    }
+}
+
+ClockThreads::~ClockThreads()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_quit = true;
+    }
+    m_start.notify_all();
+
+    for (std::thread& thread: m_threads)
+    {
+        thread.join();
+    }
+}
+
+void ClockThreads::worker(sidemu* chip)
+{
+    unsigned int round = 0;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_start.wait(lock, [this, round] { return m_quit || (m_round != round); });
+
+            if (m_quit)
+                return;
+
+            round = m_round;
+        }
+
+        chip->clock();
+
+        m_pending.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void ClockThreads::clock()
+{
+    m_pending.store(m_threads.size(), std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_round++;
+    }
+    m_start.notify_all();
+
+    m_chips.front()->clock();
+
+    // The workers usually finish at about the same time
+    while (m_pending.load(std::memory_order_acquire) != 0)
+    {
+        std::this_thread::yield();
+    }
+}
+
+}
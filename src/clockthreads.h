@@ -0,0 +1,87 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef CLOCKTHREADS_H
+#define CLOCKTHREADS_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "sidcxx11.h"
+
+namespace libsidplayfp
+{
+
+class sidemu;
+
+/**
+ * Clocks the SID chips in parallel, one worker thread for
+ * each chip after the first, which is clocked by the caller.
+ * The chips must defer their register writes so that
+ * they are independent from the rest of the machine
+ * and from each other while being clocked.
+ */
+class ClockThreads
+{
+private:
+    std::vector<std::thread> m_threads;
+
+    const std::vector<sidemu*> m_chips;
+
+    std::mutex m_lock;
+    std::condition_variable m_start;
+
+    /// Incremented at each round
+    unsigned int m_round = 0;
+
+    /// Chips still being clocked in the current round
+    std::atomic<unsigned int> m_pending;
+
+    bool m_quit = false;
+
+private:
+    void worker(sidemu* chip);
+
+public:
+    /**
+     * Start the worker threads.
+     *
+     * @param chips the chips to clock
+     */
+    ClockThreads(const std::vector<sidemu*>& chips);
+
+    /**
+     * Stop the worker threads.
+     */
+    ~ClockThreads();
+
+    /**
+     * Clock all the chips to the present moment
+     * and wait for them to finish.
+     */
+    void clock();
+};
+
+}
+
+#endif // CLOCKTHREADS_H
@@ -0,0 +1,182 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "loopDetector.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace libsidplayfp
+{
+
+namespace
+{
+
+/// Attack times in milliseconds, from the datasheet
+constexpr uint_least32_t ATTACK_MS[16] =
+{
+    2, 8, 16, 24, 38, 56, 68, 80, 100, 250, 500, 800, 1000, 3000, 5000, 8000
+};
+
+/// Decay and release times in milliseconds, from the datasheet
+constexpr uint_least32_t RELEASE_MS[16] =
+{
+    6, 24, 48, 72, 114, 168, 204, 240, 300, 750, 1500, 2400, 3000, 9000, 15000, 24000
+};
+
+constexpr uint_least64_t FNV_PRIME = 0x100000001b3ull;
+
+}
+
+loopDetector::loopDetector(uint_least32_t silenceMs) :
+    silenceMs(silenceMs)
+{
+    for (auto &sid: voices)
+    {
+        for (voice_t &voice: sid)
+        {
+            voice.gate = false;
+            voice.since = 0;
+        }
+    }
+}
+
+bool loopDetector::voicesSilent(unsigned int sid, const uint8_t regs[0x20], uint_least32_t timeMs)
+{
+    bool silent = true;
+
+    for (unsigned int i = 0; i < 3; i++)
+    {
+        const uint8_t* const voiceRegs = regs + i * 7;
+        voice_t &voice = voices[sid][i];
+
+        const bool gate = voiceRegs[4] & 0x01;
+        if (gate != voice.gate)
+        {
+            voice.gate = gate;
+            voice.since = timeMs;
+        }
+
+        const uint_least32_t elapsed = timeMs - voice.since;
+        const unsigned int attack = voiceRegs[5] >> 4;
+        const unsigned int decay = voiceRegs[5] & 0x0f;
+        const unsigned int sustain = voiceRegs[6] >> 4;
+        const unsigned int release = voiceRegs[6] & 0x0f;
+
+        if (gate)
+        {
+            // Sustain level zero fades out after the decay
+            if ((sustain != 0) || (elapsed < ATTACK_MS[attack] + RELEASE_MS[decay]))
+                silent = false;
+        }
+        else if (elapsed < RELEASE_MS[release])
+        {
+            silent = false;
+        }
+    }
+
+    // Master volume off
+    return silent || ((regs[0x18] & 0x0f) == 0);
+}
+
+loopDetector::result_t loopDetector::frame(uint_least64_t fingerprint, bool silent, uint_least32_t timeMs)
+{
+    const uint_least32_t idx = static_cast<uint_least32_t>(frames.size());
+    frames.push_back({fingerprint, timeMs});
+
+    if (!silent)
+    {
+        silenceStart = NO_SILENCE;
+    }
+    else if (silenceMs != 0)
+    {
+        if (silenceStart == NO_SILENCE)
+            silenceStart = timeMs;
+
+        if (timeMs - silenceStart >= silenceMs)
+        {
+            m_end = silenceStart;
+            return result_t::SILENCE;
+        }
+    }
+
+    if (period != 0)
+    {
+        if (frames[idx - period].fingerprint != fingerprint)
+        {
+            period = 0;
+        }
+        else
+        {
+            const uint_least32_t repeatTime = frames[repeatStart].time;
+            const uint_least32_t periodTime = repeatTime - frames[repeatStart - period].time;
+
+            if (timeMs - repeatTime >= std::max(periodTime, MIN_CONFIRM_MS))
+            {
+                // Move the start back as far as the repetition goes
+                uint_least32_t start = repeatStart - period;
+                while ((start > 0) && (frames[start - 1].fingerprint == frames[start - 1 + period].fingerprint))
+                    start--;
+
+                m_loopStart = frames[start].time;
+                m_loopLength = frames[start + period].time - m_loopStart;
+                m_end = m_loopStart + m_loopLength;
+                return result_t::LOOP;
+            }
+        }
+    }
+
+    auto it = lastSeen.find(fingerprint);
+    if (it != lastSeen.end())
+    {
+        if (period == 0)
+        {
+            period = idx - it->second;
+            repeatStart = idx;
+        }
+        it->second = idx;
+    }
+    else
+    {
+        lastSeen.emplace(fingerprint, idx);
+    }
+
+    return result_t::NONE;
+}
+
+uint_least64_t loopDetector::hash(uint_least64_t h, const uint8_t* data, unsigned int length)
+{
+    while (length >= 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, data, 8);
+        h = (h ^ word) * FNV_PRIME;
+        h ^= h >> 32;
+        data += 8;
+        length -= 8;
+    }
+
+    while (length-- > 0)
+        h = (h ^ *data++) * FNV_PRIME;
+
+    return h;
+}
+
+}
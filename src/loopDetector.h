@@ -0,0 +1,150 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LOOPDETECTOR_H
+#define LOOPDETECTOR_H
+
+#include <stdint.h>
+
+#include <unordered_map>
+#include <vector>
+
+#include "sidcxx11.h"
+
+namespace libsidplayfp
+{
+
+/**
+ * Find where a tune repeats or falls silent.
+ *
+ * The detector is fed a fingerprint of the machine state
+ * at each call of the play routine. A loop is found when
+ * the sequence of fingerprints repeats with a fixed period
+ * for a whole period, and at least MIN_CONFIRM_MS.
+ * Silence is guessed from the SID registers, as the chips
+ * don't produce audio while detecting.
+ */
+class loopDetector
+{
+public:
+    enum class result_t
+    {
+        NONE,
+        LOOP,
+        SILENCE
+    };
+
+    /// Maximum number of SIDs
+    static constexpr unsigned int MAX_SIDS = 3;
+
+    /// Initial value for #hash
+    static constexpr uint_least64_t HASH_SEED = 0xcbf29ce484222325ull;
+
+private:
+    /// Minimum time a repetition must hold to be accepted as the loop
+    static constexpr uint_least32_t MIN_CONFIRM_MS = 10000;
+
+    static constexpr uint_least32_t NO_SILENCE = UINT32_MAX;
+
+    struct frame_t
+    {
+        uint_least64_t fingerprint;
+        uint_least32_t time;
+    };
+
+    /// Envelope phase of a voice, as seen from the registers
+    struct voice_t
+    {
+        bool gate;
+
+        /// Time of the last gate change
+        uint_least32_t since;
+    };
+
+private:
+    std::vector<frame_t> frames;
+
+    /// Last frame with a given fingerprint
+    std::unordered_map<uint_least64_t, uint_least32_t> lastSeen;
+
+    /// Period in frames of the candidate loop, 0 if none
+    uint_least32_t period = 0;
+
+    /// First frame repeating the candidate loop
+    uint_least32_t repeatStart = 0;
+
+    /// Minimum duration of a silence, 0 to not detect silence
+    const uint_least32_t silenceMs;
+
+    /// Start of the current silence
+    uint_least32_t silenceStart = NO_SILENCE;
+
+    voice_t voices[MAX_SIDS][3];
+
+    uint_least32_t m_loopStart = 0;
+    uint_least32_t m_loopLength = 0;
+    uint_least32_t m_end = 0;
+
+public:
+    /**
+     * @param silenceMs minimum duration of a silence ending the tune, 0 to disable
+     */
+    loopDetector(uint_least32_t silenceMs);
+
+    /**
+     * Check if the voices of a chip are silent,
+     * tracking the envelopes from the register values.
+     * Call once per chip at each frame.
+     *
+     * @param sid the chip
+     * @param regs the last values written to the registers
+     * @param timeMs the time of the frame
+     */
+    bool voicesSilent(unsigned int sid, const uint8_t regs[0x20], uint_least32_t timeMs);
+
+    /**
+     * Add a frame.
+     *
+     * @param fingerprint the hash of the machine state
+     * @param silent true if no audio is produced
+     * @param timeMs the time of the frame
+     * @return what ended the tune, NONE to keep going
+     */
+    result_t frame(uint_least64_t fingerprint, bool silent, uint_least32_t timeMs);
+
+    uint_least32_t loopStart() const { return m_loopStart; }
+    uint_least32_t loopLength() const { return m_loopLength; }
+
+    /// Where the tune can be cut or faded out
+    uint_least32_t end() const { return m_end; }
+
+    /**
+     * Add a block of data to a hash.
+     *
+     * @param h the hash so far, HASH_SEED to start
+     * @param data the data
+     * @param length the size of the data
+     */
+    static uint_least64_t hash(uint_least64_t h, const uint8_t* data, unsigned int length);
+};
+
+}
+
+#endif // LOOPDETECTOR_H
@@ -25,14 +25,29 @@
 #include <cassert>
 #include <cstring>
 
+#include "clockthreads.h"
 #include "sidemu.h"
 
 
 namespace libsidplayfp
 {
 
+Mixer::Mixer() :
+    m_rand(257254)
+{
+    m_mix.push_back(&Mixer::mono<1>);
+}
+
+Mixer::~Mixer() = default;
+
 void Mixer::clockChips()
 {
+    if (m_threads)
+    {
+        m_threads->clock();
+        return;
+    }
+
     for (sidemu* chip: m_chips)
         chip->clock();
 }
@@ -61,7 +76,8 @@ void Mixer::doMix()
     {
         // This is a crude boxcar low-pass filter to
         // reduce aliasing during fast forward.
-        for (size_t k = 0; k < m_chips.size(); k++)
+        const size_t buffers = m_lockstep ? m_mix.size() : m_chips.size();
+        for (size_t k = 0; k < buffers; k++)
         {
             int_least32_t sample = 0;
             const short *buffer = m_chips[k]->buffer() + i;
@@ -132,10 +148,57 @@ void Mixer::updateParams()
         if (m_stereo) m_mix[1] = &Mixer::stereo_ch2_ThreeChips;
         break;
      }
+
+    updateLockstep();
+    updateThreads();
+}
+
+void Mixer::updateLockstep()
+{
+    const size_t chips = m_chips.size();
+
+    if (chips < 2)
+    {
+        m_lockstep = false;
+        return;
+    }
+
+    // Same matrix as the mixing functions
+    std::vector<float> gains(m_mix.size() * chips, 1.f);
+    if (m_stereo)
+    {
+        gains[chips - 1] = 0.5f;
+        gains[chips] = 0.5f;
+    }
+
+    const float scale = static_cast<float>(SCALE[chips-1]) / SCALE_FACTOR;
+    for (float& gain: gains)
+        gain *= scale;
+
+    m_lockstep = m_chips.front()->lockstep(m_chips, gains, m_mix.size());
+
+    if (m_lockstep)
+    {
+        m_mix[0] = &Mixer::premixed_ch1;
+        if (m_stereo) m_mix[1] = &Mixer::premixed_ch2;
+    }
 }
 
 void Mixer::clearSids()
 {
+    if (m_threads)
+    {
+        m_threads.reset();
+        for (sidemu* chip: m_chips)
+            chip->deferWrites(false);
+    }
+
+    if (m_lockstep)
+    {
+        m_chips.front()->lockstep(std::vector<sidemu*>(), std::vector<float>(), 0);
+        m_lockstep = false;
+    }
+
     m_chips.clear();
 }
 
@@ -164,6 +227,35 @@ void Mixer::setStereo(bool stereo)
     }
 }
 
+void Mixer::setParallel(bool enable)
+{
+    if (m_parallel != enable)
+    {
+        m_parallel = enable;
+
+        updateThreads();
+    }
+}
+
+void Mixer::updateThreads()
+{
+    m_threads.reset();
+
+    bool parallel = m_parallel && !m_lockstep && (m_chips.size() > 1);
+
+    for (sidemu* chip: m_chips)
+        parallel &= chip->deferWrites(true);
+
+    if (!parallel)
+    {
+        for (sidemu* chip: m_chips)
+            chip->deferWrites(false);
+        return;
+    }
+
+    m_threads.reset(new ClockThreads(m_chips));
+}
+
 void Mixer::setSamplerate(uint_least32_t rate)
 {
     m_sampleRate = rate;
@@ -28,12 +28,14 @@
 
 #include <stdint.h>
 
+#include <memory>
 #include <vector>
 
 namespace libsidplayfp
 {
 
 class sidemu;
+class ClockThreads;
 
 /**
  * This class implements the mixer.
@@ -93,6 +95,9 @@ public:
 private:
     std::vector<sidemu*> m_chips;
 
+    /// Worker threads clocking the chips, if enabled
+    std::unique_ptr<ClockThreads> m_threads;
+
     std::vector<int_least32_t> m_iSamples;
     std::vector<int_least32_t> m_volume;
 
@@ -113,11 +118,21 @@ private:
 
     bool m_wait = false;
 
+    /// The chips are clocked and mixed by the emulation
+    bool m_lockstep = false;
+
+    /// Clock the chips on separate threads
+    bool m_parallel = false;
+
     randomLCG<VOLUME_MAX> m_rand;
 
 private:
     void updateParams();
 
+    void updateLockstep();
+
+    void updateThreads();
+
     int triangularDithering()
     {
         const int prevValue = m_oldRandomValue;
@@ -152,6 +167,10 @@ private:
      * R 0.5   1.0   1.0
      */
 
+    // Already mixed by the emulation
+    int_least32_t premixed_ch1() const { return m_iSamples[0]; }
+    int_least32_t premixed_ch2() const { return m_iSamples[1]; }
+
     // Mono mixing
     template <int Chips>
     int_least32_t mono() const
@@ -187,11 +206,9 @@ public:
     /**
      * Create a new mixer.
      */
-    Mixer() :
-        m_rand(257254)
-    {
-        m_mix.push_back(&Mixer::mono<1>);
-    }
+    Mixer();
+
+    ~Mixer();
 
     /**
      * Do the mixing.
@@ -261,6 +278,14 @@ public:
      */
     void setStereo(bool stereo);
 
+    /**
+     * Clock the chips on separate threads if they support it.
+     * Ignored if the chips are clocked in lockstep.
+     *
+     * @param enable true to use a thread for each chip
+     */
+    void setParallel(bool enable);
+
     /**
      * Set sample rate.
      *
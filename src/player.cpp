@@ -27,6 +27,7 @@
 #include "sidplayfp/sidbuilder.h"
 
 #include "sidemu.h"
+#include "loopDetector.h"
 #include "psiddrv.h"
 #include "romCheck.h"
 
@@ -53,6 +54,7 @@ const char ERR_UNSUPPORTED_FREQ[]     = "SIDPLAYER ERROR: Unsupported sampling f
 const char ERR_UNSUPPORTED_SID_ADDR[] = "SIDPLAYER ERROR: Unsupported SID address.";
 const char ERR_UNSUPPORTED_SIZE[]     = "SIDPLAYER ERROR: Size of music data exceeds C64 memory.";
 const char ERR_INVALID_PERCENTAGE[]   = "SIDPLAYER ERROR: Percentage value out of range.";
+const char ERR_NO_TUNE[]              = "SIDPLAYER ERROR: No tune loaded.";
 
 /**
  * Configuration error exception.
@@ -117,12 +119,15 @@ void Player::setChargen(const uint8_t* rom)
 
 bool Player::fastForward(unsigned int percent)
 {
-    if (!m_mixer.setFastForward(percent / 100))
+    const int ff = percent / 100;
+    if (!m_mixer.setFastForward(ff))
     {
         m_errorString = ERR_INVALID_PERCENTAGE;
         return false;
     }
 
+    m_fastForward = ff;
+    sidParams(m_c64.getMainCpuSpeed(), m_cfg.frequency, m_cfg.samplingMethod, m_cfg.fastSampling);
     return true;
 }
 
@@ -246,6 +251,54 @@ void Player::nokinks(unsigned int sidNum, bool enable)
         s->nokinks(enable);
 }
 
+void Player::oscillatorEvents(unsigned int sidNum, bool enable)
+{
+    sidemu *s = m_mixer.getSid(sidNum);
+    if (s != nullptr)
+        s->oscillatorEvents(enable);
+}
+
+unsigned int Player::getOscillatorEvents(unsigned int sidNum, OscillatorEvent* events, unsigned int count)
+{
+    sidemu *s = m_mixer.getSid(sidNum);
+    if (s == nullptr)
+        return 0;
+
+    return s->getOscillatorEvents(events, count);
+}
+
+void Player::stateSnapshots(unsigned int sidNum, unsigned int interval)
+{
+    sidemu *s = m_mixer.getSid(sidNum);
+    if (s != nullptr)
+        s->stateSnapshots(interval);
+}
+
+unsigned int Player::getStateSnapshots(unsigned int sidNum, SidState* states, unsigned int count)
+{
+    sidemu *s = m_mixer.getSid(sidNum);
+    if (s == nullptr)
+        return 0;
+
+    return s->getStateSnapshots(states, count);
+}
+
+void Player::waveformCapture(unsigned int sidNum, unsigned int decimation, bool minMax)
+{
+    sidemu *s = m_mixer.getSid(sidNum);
+    if (s != nullptr)
+        s->waveformCapture(decimation, minMax);
+}
+
+unsigned int Player::getWaveformCapture(unsigned int sidNum, WaveformSample* samples, unsigned int count)
+{
+    sidemu *s = m_mixer.getSid(sidNum);
+    if (s == nullptr)
+        return 0;
+
+    return s->getWaveformCapture(samples, count);
+}
+
 /**
  * @throws MOS6510::haltInstruction
  */
@@ -347,6 +400,151 @@ void Player::stop()
     }
 }
 
+uint_least64_t Player::fingerprint(loopDetector &detector, uint_least32_t timeMs, bool &silent)
+{
+    uint_least64_t h = loopDetector::HASH_SEED;
+
+    for (unsigned int i = 0; i < loopDetector::MAX_SIDS; i++)
+    {
+        sidemu *s = m_mixer.getSid(i);
+        if (s == nullptr)
+            break;
+
+        uint8_t regs[0x20];
+        s->getStatus(regs);
+
+        unsigned int volumeChanges;
+        const uint_least32_t writes = s->getWrites(volumeChanges);
+
+        // Samples played through the volume register
+        if (volumeChanges != 0)
+            silent = false;
+
+        if (!detector.voicesSilent(i, regs, timeMs))
+            silent = false;
+
+        const uint8_t writesBytes[4] =
+        {
+            static_cast<uint8_t>(writes),
+            static_cast<uint8_t>(writes >> 8),
+            static_cast<uint8_t>(writes >> 16),
+            static_cast<uint8_t>(writes >> 24)
+        };
+        h = loopDetector::hash(h, regs, 0x19);
+        h = loopDetector::hash(h, writesBytes, 4);
+    }
+
+    const uint_least16_t timer = m_c64.getCia1TimerA();
+    const uint8_t timerBytes[2] = { static_cast<uint8_t>(timer), static_cast<uint8_t>(timer >> 8) };
+    h = loopDetector::hash(h, timerBytes, 2);
+
+    const uint8_t* ram = m_c64.getRam();
+
+    // Zero page without the processor port and the jiffy clock
+    h = loopDetector::hash(h, ram + 0x02, 0xa0 - 0x02);
+    h = loopDetector::hash(h, ram + 0xa3, 0x100 - 0xa3);
+
+    const SidTuneInfo* tuneInfo = m_tune->getInfo();
+    h = loopDetector::hash(h, ram + tuneInfo->loadAddr(), tuneInfo->c64dataLen());
+
+    return h;
+}
+
+bool Player::detectLength(uint_least32_t maxMs, uint_least32_t silenceMs, TuneLength &result)
+{
+    static constexpr unsigned int CYCLES = 3000;
+
+    result.end = TuneLength::UNKNOWN;
+    result.loopStart = 0;
+    result.loopLength = 0;
+    result.endMs = maxMs;
+
+    if (m_tune == nullptr)
+    {
+        m_errorString = ERR_NO_TUNE;
+        return false;
+    }
+
+    try
+    {
+        initialise();
+    }
+    catch (configError const &e)
+    {
+        m_errorString = e.message();
+        return false;
+    }
+
+    for (unsigned int i = 0; m_mixer.getSid(i) != nullptr; i++)
+        m_mixer.getSid(i)->silent(true);
+
+    loopDetector detector(silenceMs);
+
+    // Tunes playing without interrupts are sampled at 25 Hz
+    const event_clock_t maxFrameCycles = static_cast<event_clock_t>(m_c64.getMainCpuSpeed() / 25.);
+
+    EventScheduler &scheduler = *m_c64.getEventScheduler();
+    uint_least32_t irqTriggers = m_c64.getIrqTriggers();
+    event_clock_t frameStart = scheduler.getTime(EVENT_CLOCK_PHI1);
+
+    try
+    {
+        for (unsigned int events = 1; ; events++)
+        {
+            m_c64.clock();
+
+            if (events == CYCLES)
+            {
+                m_mixer.clockChips();
+                m_mixer.resetBufs();
+                events = 0;
+            }
+
+            // A new frame starts at each interrupt
+            const event_clock_t now = scheduler.getTime(EVENT_CLOCK_PHI1);
+            if ((m_c64.getIrqTriggers() == irqTriggers) && (now - frameStart < maxFrameCycles))
+                continue;
+
+            irqTriggers = m_c64.getIrqTriggers();
+            frameStart = now;
+
+            const uint_least32_t time = timeMs();
+            if (time >= maxMs)
+                break;
+
+            bool silent = true;
+            const uint_least64_t h = fingerprint(detector, time, silent);
+
+            const loopDetector::result_t found = detector.frame(h, silent, time);
+            if (found != loopDetector::result_t::NONE)
+            {
+                result.end = (found == loopDetector::result_t::LOOP) ? TuneLength::LOOP : TuneLength::SILENCE;
+                result.loopStart = detector.loopStart();
+                result.loopLength = detector.loopLength();
+                result.endMs = detector.end();
+                break;
+            }
+        }
+    }
+    catch (MOS6510::haltInstruction const &)
+    {
+        result.end = TuneLength::STOPPED;
+        result.endMs = timeMs();
+    }
+
+    for (unsigned int i = 0; m_mixer.getSid(i) != nullptr; i++)
+        m_mixer.getSid(i)->silent(false);
+
+    // Start playing from the beginning
+    try
+    {
+        initialise();
+    }
+    catch (configError const &) {}
+
+    return true;
+}
+
 c64::cia_model_t getCiaModel(SidConfig::cia_model_t model)
 {
     switch (model)
@@ -427,6 +625,7 @@ bool Player::config(const SidConfig &cfg, bool force)
     const bool isStereo = cfg.playback == SidConfig::STEREO;
     m_info.m_channels = isStereo ? 2 : 1;
 
+    m_mixer.setParallel(cfg.parallelChips);
     m_mixer.setStereo(isStereo);
     m_mixer.setSamplerate(cfg.frequency);
     m_mixer.setVolume(cfg.leftVolume, cfg.rightVolume);
@@ -630,13 +829,24 @@ void Player::sidCreate(sidbuilder *builder, SidConfig::sid_model_t defaultModel,
 void Player::sidParams(double cpuFreq, int frequency,
                         SidConfig::sampling_method_t sampling, bool fastSampling)
 {
+    // Let the chip resamplers do the fast forward decimation
+    // as far as the lowest supported frequency allows,
+    // the mixer averages the remaining factor
+    int chipFactor = m_fastForward;
+    while ((chipFactor > 1) && ((m_fastForward % chipFactor != 0) || (frequency / chipFactor < 8000)))
+        chipFactor--;
+
+    m_mixer.setFastForward(m_fastForward / chipFactor);
+
+    const float chipFrequency = static_cast<float>(frequency) / chipFactor;
+
     for (unsigned int i = 0; ; i++)
     {
         sidemu *s = m_mixer.getSid(i);
         if (s == nullptr)
             break;
 
-        s->sampling((float)cpuFreq, frequency, sampling, fastSampling);
+        s->sampling((float)cpuFreq, chipFrequency, sampling, fastSampling);
     }
 }
 
@@ -27,9 +27,13 @@
 #include <stdint.h>
 #include <cstdio>
 
+#include "sidplayfp/OscillatorEvent.h"
 #include "sidplayfp/siddefs.h"
 #include "sidplayfp/SidConfig.h"
+#include "sidplayfp/SidState.h"
+#include "sidplayfp/WaveformSample.h"
 #include "sidplayfp/SidTuneInfo.h"
+#include "sidplayfp/TuneLength.h"
 
 #include "SidInfoImpl.h"
 #include "sidrandom.h"
@@ -51,6 +55,8 @@ class sidbuilder;
 namespace libsidplayfp
 {
 
+class loopDetector;
+
 class Player
 {
 private:
@@ -86,6 +92,9 @@ private:
 
     uint_least32_t m_startTime = 0;
 
+    /// Fast forward factor
+    int m_fastForward = 1;
+
     /// PAL/NTSC switch value
     uint8_t videoSwitch;
 
@@ -120,6 +129,8 @@ private:
 
     /**
      * Set the SID emulation parameters.
+     * While fast forwarding the chips are resampled
+     * at a fraction of the output frequency.
      *
      * @param cpuFreq the CPU clock frequency
      * @param frequency the output sampling frequency
@@ -131,6 +142,17 @@ private:
 
     inline void run(unsigned int events);
 
+    /**
+     * Hash the machine state relevant to the tune:
+     * the SID registers and the writes since the last call,
+     * the zero page and the tune's memory.
+     *
+     * @param detector tracks the silence of the voices
+     * @param timeMs the current time
+     * @param silent set to false if any chip is playing
+     */
+    uint_least64_t fingerprint(loopDetector &detector, uint_least32_t timeMs, bool &silent);
+
 public:
     Player();
     ~Player() = default;
@@ -151,6 +173,8 @@ public:
 
     void stop();
 
+    bool detectLength(uint_least32_t maxMs, uint_least32_t silenceMs, TuneLength &result);
+
     uint_least32_t timeMs() const { return m_c64.getTimeMs() - m_startTime; }
 
     void debug(const bool enable, FILE *out) { m_c64.debug(enable, out); }
@@ -176,6 +200,18 @@ public:
     uint_least16_t getCia1TimerA() const { return m_c64.getCia1TimerA(); }
 
     bool getSidStatus(unsigned int sidNum, uint8_t regs[32]);
+
+    void oscillatorEvents(unsigned int sidNum, bool enable);
+
+    unsigned int getOscillatorEvents(unsigned int sidNum, OscillatorEvent* events, unsigned int count);
+
+    void stateSnapshots(unsigned int sidNum, unsigned int interval);
+
+    unsigned int getStateSnapshots(unsigned int sidNum, SidState* states, unsigned int count);
+
+    void waveformCapture(unsigned int sidNum, unsigned int decimation, bool minMax);
+
+    unsigned int getWaveformCapture(unsigned int sidNum, WaveformSample* samples, unsigned int count);
 };
 
 }
@@ -23,7 +23,10 @@
 #ifndef SIDEMU_H
 #define SIDEMU_H
 
+#include "sidplayfp/OscillatorEvent.h"
 #include "sidplayfp/SidConfig.h"
+#include "sidplayfp/SidState.h"
+#include "sidplayfp/WaveformSample.h"
 #include "sidplayfp/siddefs.h"
 #include "Event.h"
 #include "EventScheduler.h"
@@ -34,6 +37,7 @@
 
 #include <string>
 #include <bitset>
+#include <vector>
 
 class sidbuilder;
 
@@ -45,12 +49,14 @@ namespace libsidplayfp
  */
 class sidemu : public c64sid
 {
+    friend class ::sidbuilder;
+
 public:
     /// Buffer size. 5000 is roughly 5 ms at 96 kHz
     static constexpr unsigned int OUTPUTBUFFERSIZE = 5000;
 
 private:
-    sidbuilder* const m_builder;
+    sidbuilder* m_builder;
 
 protected:
     static const char ERR_UNSUPPORTED_FREQ[];
@@ -155,6 +161,99 @@ public:
     virtual void sampling(float systemfreq SID_UNUSED, float outputfreq SID_UNUSED,
         SidConfig::sampling_method_t method SID_UNUSED, bool fast SID_UNUSED) {}
 
+    /**
+     * Enable recording of the oscillator phase events.
+     *
+     * @param enable
+     */
+    virtual void oscillatorEvents(bool enable SID_UNUSED) {}
+
+    /**
+     * Get the oscillator phase events recorded since the last call.
+     *
+     * @param events the buffer to fill
+     * @param count the size of the buffer
+     * @return the number of events read
+     */
+    virtual unsigned int getOscillatorEvents(OscillatorEvent* events SID_UNUSED, unsigned int count SID_UNUSED) { return 0; }
+
+    /**
+     * Enable periodic snapshots of the chip state.
+     *
+     * @param interval cycles between snapshots, 0 to disable
+     */
+    virtual void stateSnapshots(unsigned int interval SID_UNUSED) {}
+
+    /**
+     * Get the state snapshots taken since the last call.
+     *
+     * @param states the buffer to fill
+     * @param count the size of the buffer
+     * @return the number of snapshots read
+     */
+    virtual unsigned int getStateSnapshots(SidState* states SID_UNUSED, unsigned int count SID_UNUSED) { return 0; }
+
+    /**
+     * Enable capture of the voices' digital output.
+     *
+     * @param decimation cycles per sample, 0 to disable
+     * @param minMax true to report min and max values instead of the last one
+     */
+    virtual void waveformCapture(unsigned int decimation SID_UNUSED, bool minMax SID_UNUSED) {}
+
+    /**
+     * Get the voice output captured since the last call.
+     *
+     * @param samples the buffer to fill
+     * @param count the size of the buffer
+     * @return the number of samples read
+     */
+    virtual unsigned int getWaveformCapture(WaveformSample* samples SID_UNUSED, unsigned int count SID_UNUSED) { return 0; }
+
+    /**
+     * Clock the given chips together and mix them in the emulation.
+     * The mixed channels are then found in the buffers
+     * of the first chips, one channel each.
+     * Called on the first chip, an empty list separates the chips.
+     *
+     * @param chips the chips to group, this one first
+     * @param gains the gain of each chip for each channel, channel major
+     * @param channels the number of output channels
+     * @return true if the chips are grouped
+     */
+    virtual bool lockstep(const std::vector<sidemu*>& chips SID_UNUSED,
+        const std::vector<float>& gains SID_UNUSED, unsigned int channels SID_UNUSED) { return false; }
+
+    /**
+     * Log the register writes and run them in #clock
+     * instead of clocking the chip at each write,
+     * so that #clock can be called from another thread
+     * while the rest of the machine is stopped.
+     *
+     * @param enable true to defer the writes
+     * @return true if supported
+     */
+    virtual bool deferWrites(bool enable SID_UNUSED) { return false; }
+
+    /**
+     * Clock the chip without producing audio,
+     * emulating only what can be read back by the CPU.
+     * The chip must be reset before producing audio again.
+     *
+     * @param enable true to stop the audio output
+     * @return true if supported
+     */
+    virtual bool silent(bool enable SID_UNUSED) { return false; }
+
+    /**
+     * Bring the emulation back to the state of a new instance
+     * so it can be handed to another builder.
+     * The sampling parameters may be kept.
+     *
+     * @return true if supported
+     */
+    virtual bool recycle() { return false; }
+
     /**
      * Get a detailed error message.
      */
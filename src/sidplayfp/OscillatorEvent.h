@@ -0,0 +1,50 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef OSCILLATOREVENT_H
+#define OSCILLATOREVENT_H
+
+#include <stdint.h>
+
+/**
+ * Oscillator phase event, reported by emulations that support it.
+ * Can be used to trigger scopes from the real oscillator phase.
+ */
+struct OscillatorEvent
+{
+    typedef enum
+    {
+        MSB_RISING = 0,     ///< The accumulator MSB went high
+        SYNC,               ///< The accumulator was reset by hard sync
+        TEST_SET,           ///< The test bit was set
+        TEST_CLEARED        ///< The test bit was cleared
+    } type_t;
+
+    /// Index of the output sample of the chip, counted from the last reset
+    uint_least32_t sample;
+
+    /// Voice number, 0 to 2
+    uint8_t voice;
+
+    /// Event type
+    type_t type;
+};
+
+#endif // OSCILLATOREVENT_H
@@ -42,7 +42,8 @@ SidConfig::SidConfig() :
     rightVolume(libsidplayfp::Mixer::VOLUME_MAX),
     powerOnDelay(DEFAULT_POWER_ON_DELAY),
     samplingMethod(RESAMPLE_INTERPOLATE),
-    fastSampling(false)
+    fastSampling(false),
+    parallelChips(false)
 {}
 
 bool SidConfig::compare(const SidConfig &config)
@@ -62,5 +63,6 @@ bool SidConfig::compare(const SidConfig &config)
         || rightVolume != config.rightVolume
         || powerOnDelay != config.powerOnDelay
         || samplingMethod != config.samplingMethod
-        || fastSampling != config.fastSampling;
+        || fastSampling != config.fastSampling
+        || parallelChips != config.parallelChips;
 }
@@ -178,6 +178,14 @@ public:
      */
     bool fastSampling;
 
+    /**
+     * Clock each SID chip of multi SID tunes
+     * on its own thread, available only for reSIDfp.
+     *
+     * @since 2.13
+     */
+    bool parallelChips;
+
     /**
      * Compare two config objects.
      *
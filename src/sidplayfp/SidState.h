@@ -0,0 +1,56 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SIDSTATE_H
+#define SIDSTATE_H
+
+#include <stdint.h>
+
+/**
+ * Snapshot of the internal state of a SID chip,
+ * reported by emulations that support it.
+ */
+struct SidState
+{
+    typedef enum
+    {
+        ATTACK = 0,
+        DECAY_SUSTAIN,
+        RELEASE
+    } env_state_t;
+
+    /// Index of the output sample of the chip, counted from the last reset
+    uint_least32_t sample;
+
+    struct
+    {
+        uint16_t freq;          ///< Oscillator frequency
+        uint16_t pw;            ///< Pulse width, 12 bits
+        uint8_t waveform;       ///< Selected waveforms, control register bits 4-7
+        uint8_t envelope;       ///< Envelope counter
+        env_state_t envState;   ///< Envelope state
+    } voice[3];
+
+    uint16_t fc;                ///< Filter cutoff, 11 bits
+    uint8_t resFilt;            ///< Resonance and filter routing register
+    uint8_t modeVol;            ///< Filter mode and volume register
+};
+
+#endif // SIDSTATE_H
@@ -20,7 +20,11 @@
 
 #include "SidTune.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "sidtune/SidTuneBase.h"
+#include "utils/md5Batch.h"
 
 #include "sidcxx11.h"
 
@@ -55,21 +59,34 @@ SidTune::SidTune(const char* fileName, const char **fileNameExt, bool separatorI
 }
 
 SidTune::SidTune(LoaderFunc loader, const char* fileName, const char **fileNameExt, bool separatorIsSlash) :
-    tune(nullptr)
+    tune(nullptr),
+    stream(nullptr)
 {
     setFileNameExtensions(fileNameExt);
     load(loader, fileName, separatorIsSlash);
 }
 
 SidTune::SidTune(const uint_least8_t* oneFileFormatSidtune, uint_least32_t sidtuneLength) :
-    tune(nullptr)
+    tune(nullptr),
+    stream(nullptr)
 {
     read(oneFileFormatSidtune, sidtuneLength);
 }
 
+SidTune::SidTune(const uint_least8_t* oneFileFormatSidtune, uint_least32_t sidtuneLength, bool borrowBuffer) :
+    tune(nullptr),
+    stream(nullptr)
+{
+    if (borrowBuffer)
+        borrow(oneFileFormatSidtune, sidtuneLength);
+    else
+        read(oneFileFormatSidtune, sidtuneLength);
+}
+
 SidTune::~SidTune()
 {
     delete tune;
+    delete stream;
 }
 
 void SidTune::setFileNameExtensions(const char **fileNameExt)
@@ -116,6 +133,91 @@ void SidTune::read(const uint_least8_t* sourceBuffer, uint_least32_t bufferLen)
     }
 }
 
+void SidTune::borrow(const uint_least8_t* sourceBuffer, uint_least32_t bufferLen)
+{
+    try
+    {
+        delete tune;
+        tune = SidTuneBase::borrow(sourceBuffer, bufferLen);
+        m_status = true;
+        m_statusString = MSG_NO_ERRORS;
+    }
+    catch (loadError const &e)
+    {
+        tune =  nullptr;
+        m_status = false;
+        m_statusString = e.message();
+    }
+}
+
+void SidTune::loadMapped(const char* fileName, bool separatorIsSlash)
+{
+    try
+    {
+        delete tune;
+        tune = SidTuneBase::loadMapped(fileName, fileNameExtensions, separatorIsSlash);
+        m_status = true;
+        m_statusString = MSG_NO_ERRORS;
+    }
+    catch (loadError const &e)
+    {
+        tune =  nullptr;
+        m_status = false;
+        m_statusString = e.message();
+    }
+}
+
+void SidTune::beginRead()
+{
+    delete tune;
+    tune = nullptr;
+    delete stream;
+    stream = new streamLoader();
+    m_status = true;
+    m_statusString = MSG_NO_ERRORS;
+}
+
+uint_least32_t SidTune::readChunk(const uint_least8_t* sourceBuffer, uint_least32_t bufferLen)
+{
+    if (stream == nullptr)
+        return 0;
+
+    try
+    {
+        return stream->append(sourceBuffer, bufferLen);
+    }
+    catch (loadError const &e)
+    {
+        delete stream;
+        stream = nullptr;
+        m_status = false;
+        m_statusString = e.message();
+        return 0;
+    }
+}
+
+void SidTune::endRead()
+{
+    if (stream == nullptr)
+        return;
+
+    try
+    {
+        tune = stream->finish();
+        m_status = true;
+        m_statusString = MSG_NO_ERRORS;
+    }
+    catch (loadError const &e)
+    {
+        tune =  nullptr;
+        m_status = false;
+        m_statusString = e.message();
+    }
+
+    delete stream;
+    stream = nullptr;
+}
+
 unsigned int SidTune::selectSong(unsigned int songNum)
 {
     return tune != nullptr ? tune->selectSong(songNum) : 0;
@@ -154,6 +256,92 @@ const char* SidTune::createMD5New(char *md5)
     return tune != nullptr ? tune->createMD5New(md5) : nullptr;
 }
 
+namespace
+{
+
+/// Tunes hashed per round, bounds the memory for trailers
+constexpr unsigned int MD5_BATCH_SIZE = 256;
+
+void toHex(const uint8_t* digest, char* md5)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    for (unsigned int i = 0; i < md5Batch::DIGEST_SIZE; i++)
+    {
+        md5[i * 2] = hex[digest[i] >> 4];
+        md5[i * 2 + 1] = hex[digest[i] & 0x0f];
+    }
+    md5[SidTune::MD5_LENGTH] = '\0';
+}
+
+}
+
+void SidTune::createMD5Batch(SidTune* const* tunes, unsigned int count,
+                             char* const* md5, char* const* md5New)
+{
+    std::vector<uint8_t> trailers(MD5_BATCH_SIZE * SidTuneBase::MD5_TRAILER_SIZE);
+    std::vector<uint8_t> digests(MD5_BATCH_SIZE * 2 * md5Batch::DIGEST_SIZE);
+    std::vector<md5Batch::job> jobs;
+    jobs.reserve(MD5_BATCH_SIZE * 2);
+
+    for (unsigned int first = 0; first < count; first += MD5_BATCH_SIZE)
+    {
+        const unsigned int n = std::min(count - first, MD5_BATCH_SIZE);
+
+        jobs.clear();
+        for (unsigned int i = 0; i < n; i++)
+        {
+            SidTuneBase* tune = tunes[first + i]->tune;
+            uint8_t* digest = &digests[i * 2 * md5Batch::DIGEST_SIZE];
+
+            if (md5 != nullptr)
+                *md5[first + i] = '\0';
+            if (md5New != nullptr)
+                *md5New[first + i] = '\0';
+
+            if (tune == nullptr)
+                continue;
+
+            uint8_t* trailer = &trailers[i * SidTuneBase::MD5_TRAILER_SIZE];
+            const int trailerLen = tune->md5Trailer(trailer);
+            if (trailerLen < 0)
+                continue;
+
+            if (md5 != nullptr)
+            {
+                md5Batch::job job;
+                job.data[0] = tune->c64Data();
+                job.size[0] = tune->getInfo()->c64dataLen();
+                job.data[1] = trailer;
+                job.size[1] = trailerLen;
+                job.digest = digest;
+                jobs.push_back(job);
+            }
+
+            if (md5New != nullptr)
+            {
+                md5Batch::job job;
+                job.data[0] = tune->fileData();
+                job.size[0] = tune->fileDataLen();
+                job.data[1] = nullptr;
+                job.size[1] = 0;
+                job.digest = digest + md5Batch::DIGEST_SIZE;
+                jobs.push_back(job);
+            }
+        }
+
+        md5Batch::run(jobs.data(), jobs.size());
+
+        for (const md5Batch::job &job : jobs)
+        {
+            const size_t offset = job.digest - digests.data();
+            const unsigned int i = first + offset / (2 * md5Batch::DIGEST_SIZE);
+            char* dest = (offset % (2 * md5Batch::DIGEST_SIZE)) ? md5New[i] : md5[i];
+            toHex(job.digest, dest);
+        }
+    }
+}
+
 const uint_least8_t* SidTune::c64Data() const
 {
     return tune != nullptr ? tune->c64Data() : nullptr;
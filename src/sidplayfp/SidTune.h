@@ -33,6 +33,7 @@ class SidTuneInfo;
 namespace libsidplayfp
 {
 class SidTuneBase;
+class streamLoader;
 class sidmemory;
 }
 
@@ -51,6 +52,9 @@ private:
 private:  // -------------------------------------------------------------
     libsidplayfp::SidTuneBase* tune;
 
+    /// Tune being received with #readChunk
+    libsidplayfp::streamLoader* stream;
+
     const char* m_statusString;
 
     bool m_status;
@@ -102,6 +106,17 @@ public:  // ----------------------------------------------------------------
      */
     SidTune(const uint_least8_t* oneFileFormatSidtune, uint_least32_t sidtuneLength);
 
+    /**
+     * Load a single-file sidtune from a memory buffer, optionally
+     * without copying it. See #borrow.
+     *
+     * @param oneFileFormatSidtune the buffer that contains song data
+     * @param sidtuneLength length of the buffer
+     * @param borrowBuffer reference the buffer instead of copying it
+     * @since 2.13
+     */
+    SidTune(const uint_least8_t* oneFileFormatSidtune, uint_least32_t sidtuneLength, bool borrowBuffer);
+
     ~SidTune();
 
     /**
@@ -140,6 +155,65 @@ public:  // ----------------------------------------------------------------
      */
     void read(const uint_least8_t* sourceBuffer, uint_least32_t bufferLen);
 
+    /**
+     * Load a sidtune into an existing object from a buffer
+     * without copying it.
+     * PSID files are parsed in place so the buffer must stay valid
+     * and unchanged as long as the tune is loaded, other formats
+     * are copied as with #read.
+     *
+     * @param sourceBuffer the buffer that contains song data
+     * @param bufferLen length of the buffer
+     * @since 2.13
+     */
+    void borrow(const uint_least8_t* sourceBuffer, uint_least32_t bufferLen);
+
+    /**
+     * Load a sidtune into an existing object from a file,
+     * mapping it into memory if large enough.
+     * PSID files are parsed in place and the data is only copied
+     * when placed into the C64 memory. Other formats are loaded as with #load.
+     *
+     * @param fileName
+     * @param separatorIsSlash
+     * @since 2.13
+     */
+    void loadMapped(const char* fileName, bool separatorIsSlash = false);
+
+    /**
+     * Start loading a single-file sidtune from data arriving
+     * in chunks, e.g. from a pipe or a socket.
+     * Currently supported: PSID format.
+     * The loaded tune, if any, is discarded.
+     *
+     * @since 2.13
+     */
+    void beginRead();
+
+    /**
+     * Append a chunk of data to the sidtune started with #beginRead.
+     * The header is checked as soon as it is complete, so invalid
+     * files are rejected without reading the rest; in that case
+     * #getStatus returns false and the load is aborted.
+     * The chunks are stored directly as the tune data.
+     *
+     * @param sourceBuffer the chunk
+     * @param bufferLen length of the chunk
+     * @return the minimum number of bytes still needed,
+     *         0 if the data received so far makes a complete tune
+     *         or in case of errors
+     * @since 2.13
+     */
+    uint_least32_t readChunk(const uint_least8_t* sourceBuffer, uint_least32_t bufferLen);
+
+    /**
+     * Complete the sidtune started with #beginRead,
+     * after the last chunk has been received.
+     *
+     * @since 2.13
+     */
+    void endRead();
+
     /**
      * Select sub-song.
      *
@@ -200,6 +274,22 @@ public:  // ----------------------------------------------------------------
      */
     const char *createMD5New(char *md5 = 0);
 
+    /**
+     * Calculates both MD5 hashes of several tunes at once.
+     * Each tune is read once and the hashes are computed
+     * in parallel lanes, which is faster than calling
+     * #createMD5 and #createMD5New on each tune.
+     * Tunes that are not loaded get empty hashes.
+     *
+     * @param tunes the tunes
+     * @param count number of tunes
+     * @param md5 count buffers of MD5_LENGTH + 1 for the old method hashes, may be 0
+     * @param md5New count buffers of MD5_LENGTH + 1 for the new method hashes, may be 0
+     * @since 2.13
+     */
+    static void createMD5Batch(SidTune* const* tunes, unsigned int count,
+                               char* const* md5, char* const* md5New);
+
     const uint_least8_t* c64Data() const;
 
 private:    // prevent copying
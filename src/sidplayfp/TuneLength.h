@@ -0,0 +1,54 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef TUNELENGTH_H
+#define TUNELENGTH_H
+
+#include <stdint.h>
+
+/**
+ * Length of a subtune as found by running it
+ * until it repeats, falls silent or stops.
+ * Times are in milliseconds from the start of the tune.
+ */
+struct TuneLength
+{
+    typedef enum
+    {
+        UNKNOWN = 0,    ///< No end found in the given time
+        LOOP,           ///< The tune repeats
+        SILENCE,        ///< The tune falls silent
+        STOPPED         ///< The emulation stopped, e.g. on a jam instruction
+    } end_t;
+
+    end_t end;
+
+    uint_least32_t loopStart;   ///< Start of the repeating part, for LOOP
+    uint_least32_t loopLength;  ///< Length of the repeating part, for LOOP
+
+    /**
+     * Where the tune can be cut or faded out:
+     * after the first pass through the loop,
+     * at the start of the silence or where the emulation stopped.
+     */
+    uint_least32_t endMs;
+};
+
+#endif // TUNELENGTH_H
@@ -0,0 +1,43 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef WAVEFORMSAMPLE_H
+#define WAVEFORMSAMPLE_H
+
+#include <stdint.h>
+
+/**
+ * Digital output of the voices of a SID chip over
+ * a number of cycles, for oscilloscope rendering.
+ * Without the min/max reduction only the last
+ * value is reported and min and max are equal.
+ */
+struct WaveformSample
+{
+    struct
+    {
+        uint16_t waveMin;   ///< Minimum waveform output, 12 bits
+        uint16_t waveMax;   ///< Maximum waveform output, 12 bits
+        uint8_t envMin;     ///< Minimum envelope output
+        uint8_t envMax;     ///< Maximum envelope output
+    } voice[3];
+};
+
+#endif // WAVEFORMSAMPLE_H
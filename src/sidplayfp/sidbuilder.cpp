@@ -22,10 +22,82 @@
 
 #include "sidbuilder.h"
 
+#include <map>
+#include <mutex>
+#include <typeindex>
+#include <typeinfo>
+#include <vector>
+
 #include "sidemu.h"
 
 #include "sidcxx11.h"
 
+namespace
+{
+
+/// Maximum number of idle emulations kept for each builder type
+constexpr std::size_t MAX_POOLED = 32;
+
+/**
+ * Idle SID emulations, grouped by the type of their builder.
+ */
+class EnginePool
+{
+private:
+    std::mutex m_lock;
+
+    std::map<std::type_index, std::vector<libsidplayfp::sidemu*>> m_engines;
+
+public:
+    ~EnginePool() { clear(); }
+
+    libsidplayfp::sidemu *get(std::type_index type)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+
+        auto it = m_engines.find(type);
+        if ((it == m_engines.end()) || it->second.empty())
+            return nullptr;
+
+        libsidplayfp::sidemu *sid = it->second.back();
+        it->second.pop_back();
+        return sid;
+    }
+
+    bool put(std::type_index type, libsidplayfp::sidemu *sid)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+
+        std::vector<libsidplayfp::sidemu*> &engines = m_engines[type];
+        if (engines.size() >= MAX_POOLED)
+            return false;
+
+        engines.push_back(sid);
+        return true;
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+
+        for (auto &engines: m_engines)
+        {
+            for (libsidplayfp::sidemu *sid: engines.second)
+                delete sid;
+        }
+
+        m_engines.clear();
+    }
+};
+
+EnginePool &idleEngines()
+{
+    static EnginePool pool;
+    return pool;
+}
+
+}
+
 libsidplayfp::sidemu *sidbuilder::lock(libsidplayfp::EventScheduler *env, SidConfig::sid_model_t model, bool digiboost)
 {
     m_status = true;
@@ -57,7 +129,33 @@ void sidbuilder::unlock(libsidplayfp::sidemu *device)
 void sidbuilder::remove()
 {
     for (auto sidobj: sidobjs)
+    {
+        if (m_pool && sidobj->recycle())
+        {
+            sidobj->m_builder = nullptr;
+            if (idleEngines().put(typeid(*this), sidobj))
+                continue;
+        }
+
         delete sidobj;
+    }
 
     sidobjs.clear();
 }
+
+libsidplayfp::sidemu *sidbuilder::fromPool()
+{
+    if (!m_pool)
+        return nullptr;
+
+    libsidplayfp::sidemu *sid = idleEngines().get(typeid(*this));
+    if (sid != nullptr)
+        sid->m_builder = this;
+
+    return sid;
+}
+
+void sidbuilder::clearEnginePool()
+{
+    idleEngines().clear();
+}
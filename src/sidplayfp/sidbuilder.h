@@ -52,11 +52,23 @@ protected:
 
     bool m_status;
 
+private:
+    bool m_pool;
+
+protected:
+    /**
+     * Take an idle instance from the engine pool, if enabled.
+     *
+     * @return the instance, or nullptr if none is available
+     */
+    libsidplayfp::sidemu *fromPool();
+
 public:
     sidbuilder(const char * const name) :
         m_name(name),
         m_errorBuffer("N/A"),
-        m_status(true) {}
+        m_status(true),
+        m_pool(false) {}
     virtual ~sidbuilder() {}
 
     /**
@@ -100,9 +112,31 @@ public:
 
     /**
      * Remove all SID emulations.
+     * With the engine pool enabled the emulations are reset
+     * and kept for the next builder of the same type.
      */
     void remove();
 
+    /**
+     * Share the SID emulations through a global pool.
+     * #create takes idle emulations from the pool
+     * and #remove returns them, saving the allocation
+     * and setup costs when builders are short lived.
+     * Pooled emulations come back with default settings.
+     * The pool is thread safe.
+     *
+     * @param enable (default false)
+     * @since 2.13
+     */
+    void enginePool(bool enable) { m_pool = enable; }
+
+    /**
+     * Delete the idle emulations kept in the global pool.
+     *
+     * @since 2.13
+     */
+    static void clearEnginePool();
+
     /**
      * Get the builder's name.
      *
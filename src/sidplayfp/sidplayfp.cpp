@@ -56,6 +56,11 @@ void sidplayfp::stop()
     sidplayer.stop();
 }
 
+bool sidplayfp::detectLength(uint_least32_t maxMs, uint_least32_t silenceMs, TuneLength &result)
+{
+    return sidplayer.detectLength(maxMs, silenceMs, result);
+}
+
 uint_least32_t sidplayfp::play(short *buffer, uint_least32_t count)
 {
     return sidplayer.play(buffer, count);
@@ -147,6 +152,36 @@ uint_least16_t sidplayfp::getCia1TimerA() const
     return sidplayer.getCia1TimerA();
 }
 
+void sidplayfp::oscillatorEvents(unsigned int sidNum, bool enable)
+{
+    sidplayer.oscillatorEvents(sidNum, enable);
+}
+
+unsigned int sidplayfp::getOscillatorEvents(unsigned int sidNum, OscillatorEvent* events, unsigned int count)
+{
+    return sidplayer.getOscillatorEvents(sidNum, events, count);
+}
+
+void sidplayfp::stateSnapshots(unsigned int sidNum, unsigned int interval)
+{
+    sidplayer.stateSnapshots(sidNum, interval);
+}
+
+unsigned int sidplayfp::getStateSnapshots(unsigned int sidNum, SidState* states, unsigned int count)
+{
+    return sidplayer.getStateSnapshots(sidNum, states, count);
+}
+
+void sidplayfp::waveformCapture(unsigned int sidNum, unsigned int decimation, bool minMax)
+{
+    sidplayer.waveformCapture(sidNum, decimation, minMax);
+}
+
+unsigned int sidplayfp::getWaveformCapture(unsigned int sidNum, WaveformSample* samples, unsigned int count)
+{
+    return sidplayer.getWaveformCapture(sidNum, samples, count);
+}
+
 bool sidplayfp::getSidStatus(unsigned int sidNum, uint8_t regs[32])
 {
     return sidplayer.getSidStatus(sidNum, regs);
@@ -26,6 +26,10 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include "sidplayfp/OscillatorEvent.h"
+#include "sidplayfp/SidState.h"
+#include "sidplayfp/TuneLength.h"
+#include "sidplayfp/WaveformSample.h"
 #include "sidplayfp/siddefs.h"
 #include "sidplayfp/sidversion.h"
 
@@ -84,6 +88,8 @@ public:
 
     /**
      * Set the fast-forward factor.
+     * The chips are resampled at a lower rate
+     * so the skipped audio is properly low-passed.
      *
      * @param percent
      */
@@ -122,6 +128,24 @@ public:
      */
     void stop();
 
+    /**
+     * Find the length of the loaded tune by running it,
+     * much faster than real time and with no audio output,
+     * until it repeats, falls silent or stops.
+     * A loop is reported once the machine state has repeated
+     * at each call of the play routine for a whole loop.
+     * The tune is then restarted from the beginning.
+     *
+     * @param maxMs the maximum time to run.
+     * @param silenceMs the minimum duration of a silence ending the tune,
+     *                  0 to only look for loops.
+     * @param result where to store the length.
+     * @return false if no tune is loaded or it can't be started,
+     *         use #error() to get a detailed message.
+     * @since 2.13
+     */
+    bool detectLength(uint_least32_t maxMs, uint_least32_t silenceMs, TuneLength &result);
+
     /**
      * Control debugging.
      * Only has effect if library have been compiled
@@ -209,6 +233,85 @@ public:
      * @since 2.2
      */
     bool getSidStatus(unsigned int sidNum, uint8_t regs[32]);
+
+    /**
+     * Enable recording of the oscillator phase events.
+     * Only supported by the ReSIDfp emulation.
+     * Must be called after #config or it has no effect.
+     *
+     * @param sidNum the SID chip, 0 for the first one, 1 for the second and 2 for the third.
+     * @param enable true to start recording, false to stop.
+     * @since 2.13
+     */
+    void oscillatorEvents(unsigned int sidNum, bool enable);
+
+    /**
+     * Get the oscillator phase events recorded since the last call,
+     * usually after each #play.
+     * Events are kept in a fixed size buffer and newer ones
+     * are dropped if it is not read often enough.
+     *
+     * @param sidNum the SID chip, 0 for the first one, 1 for the second and 2 for the third.
+     * @param events the buffer to fill.
+     * @param count the size of the buffer.
+     * @return the number of events read.
+     * @since 2.13
+     */
+    unsigned int getOscillatorEvents(unsigned int sidNum, OscillatorEvent* events, unsigned int count);
+
+    /**
+     * Subscribe to periodic snapshots of the chip internal state.
+     * Only supported by the ReSIDfp emulation.
+     * Must be called after #config or it has no effect.
+     *
+     * @param sidNum the SID chip, 0 for the first one, 1 for the second and 2 for the third.
+     * @param interval the number of cycles between snapshots, 0 to unsubscribe.
+     * @since 2.13
+     */
+    void stateSnapshots(unsigned int sidNum, unsigned int interval);
+
+    /**
+     * Get the state snapshots taken since the last call,
+     * usually after each #play.
+     * Snapshots are kept in a fixed size buffer and newer ones
+     * are dropped if it is not read often enough.
+     *
+     * @param sidNum the SID chip, 0 for the first one, 1 for the second and 2 for the third.
+     * @param states the buffer to fill.
+     * @param count the size of the buffer.
+     * @return the number of snapshots read.
+     * @since 2.13
+     */
+    unsigned int getStateSnapshots(unsigned int sidNum, SidState* states, unsigned int count);
+
+    /**
+     * Capture the digital waveform and envelope output of each voice
+     * at the SID clock rate, or at a fraction of it, for oscilloscope
+     * rendering without the smearing of the resampler.
+     * Only supported by the ReSIDfp emulation, which is then clocked
+     * one cycle at a time.
+     * Must be called after #config or it has no effect.
+     *
+     * @param sidNum the SID chip, 0 for the first one, 1 for the second and 2 for the third.
+     * @param decimation the number of cycles per sample, 0 to stop capturing.
+     * @param minMax true to report the min and max values of the cycles in each sample.
+     * @since 2.13
+     */
+    void waveformCapture(unsigned int sidNum, unsigned int decimation, bool minMax);
+
+    /**
+     * Get the voice output captured since the last call,
+     * usually after each #play.
+     * Samples are kept in a fixed size buffer and newer ones
+     * are dropped if it is not read often enough.
+     *
+     * @param sidNum the SID chip, 0 for the first one, 1 for the second and 2 for the third.
+     * @param samples the buffer to fill.
+     * @param count the size of the buffer.
+     * @return the number of samples read.
+     * @since 2.13
+     */
+    unsigned int getWaveformCapture(unsigned int sidNum, WaveformSample* samples, unsigned int count);
 };
 
 #endif // SIDPLAYFP_H
@@ -143,15 +143,15 @@ bool validateAddress(uint_least8_t address)
     return true;
 }
 
-SidTuneBase* PSID::load(buffer_t& dataBuf)
+SidTuneBase* PSID::load(const uint_least8_t* dataBuf, uint_least32_t dataLen)
 {
     // File format check
-    if (dataBuf.size() < 4)
+    if (dataLen < 4)
     {
         return nullptr;
     }
 
-    const uint32_t magic = endian_big32(&dataBuf[0]);
+    const uint32_t magic = endian_big32(dataBuf);
     if ((magic != PSID_ID)
         && (magic != RSID_ID))
     {
@@ -159,7 +159,7 @@ SidTuneBase* PSID::load(buffer_t& dataBuf)
     }
 
     psidHeader pHeader;
-    readHeader(dataBuf, pHeader);
+    readHeader(dataBuf, dataLen, pHeader);
 
     std::unique_ptr<PSID> tune(new PSID());
     tune->tryLoad(pHeader);
@@ -167,12 +167,34 @@ SidTuneBase* PSID::load(buffer_t& dataBuf)
     return tune.release();
 }
 
-void PSID::readHeader(const buffer_t &dataBuf, psidHeader &hdr)
+uint_least32_t PSID::headerSize(const uint_least8_t* dataBuf, uint_least32_t dataLen)
+{
+    // The version tells the header size
+    if (dataLen < 6)
+    {
+        if (dataLen < 4)
+            return 6;
+
+        const uint32_t magic = endian_big32(dataBuf);
+        return ((magic == PSID_ID) || (magic == RSID_ID)) ? 6 : 0;
+    }
+
+    const uint32_t magic = endian_big32(dataBuf);
+    if ((magic != PSID_ID)
+        && (magic != RSID_ID))
+    {
+        return 0;
+    }
+
+    return (endian_big16(&dataBuf[4]) >= 2) ? psidv2_headerSize + 2 : psid_headerSize + 2;
+}
+
+void PSID::readHeader(const uint_least8_t* dataBuf, uint_least32_t dataLen, psidHeader &hdr)
 {
     // Due to security concerns, input must be at least as long as version 1
     // header plus 16-bit C64 load address. That is the area which will be
     // accessed.
-    if (dataBuf.size() < (psid_headerSize + 2))
+    if (dataLen < (psid_headerSize + 2))
     {
         throw loadError(ERR_TRUNCATED);
     }
@@ -194,7 +216,7 @@ void PSID::readHeader(const buffer_t &dataBuf, psidHeader &hdr)
 
     if (hdr.version >= 2)
     {
-        if (dataBuf.size() < (psidv2_headerSize + 2))
+        if (dataLen < (psidv2_headerSize + 2))
         {
             throw loadError(ERR_TRUNCATED);
         }
@@ -359,6 +381,53 @@ void PSID::tryLoad(const psidHeader &pHeader)
         throw loadError("Compute!'s Sidplayer MUS data is not supported yet"); // TODO
 }
 
+int PSID::md5Trailer(uint8_t* trailer)
+{
+    uint8_t* ptr = trailer;
+
+    // Include INIT and PLAY address.
+    endian_little16(ptr, info->m_initAddr);
+    ptr += 2;
+    endian_little16(ptr, info->m_playAddr);
+    ptr += 2;
+
+    // Include number of songs.
+    endian_little16(ptr, info->m_songs);
+    ptr += 2;
+
+    {
+        // Include song speed for each song.
+        const unsigned int currentSong = info->m_currentSong;
+        for (unsigned int s = 1; s <= info->m_songs; s++)
+        {
+            selectSong(s);
+            *ptr++ = static_cast<uint8_t>(info->m_songSpeed);
+        }
+        // Restore old song
+        selectSong(currentSong);
+    }
+
+    // Deal with PSID v2NG clock speed flags: Let only NTSC
+    // clock speed change the MD5 fingerprint. That way the
+    // fingerprint of a PAL-speed sidtune in PSID v1, v2, and
+    // PSID v2NG format is the same.
+    if (info->m_clockSpeed == SidTuneInfo::CLOCK_NTSC)
+    {
+        *ptr++ = 2;
+    }
+
+    // NB! If the fingerprint is used as an index into a
+    // song-lengths database or cache, modify above code to
+    // allow for PSID v2NG files which have clock speed set to
+    // SIDTUNE_CLOCK_ANY. If the SID player program fully
+    // supports the SIDTUNE_CLOCK_ANY setting, a sidtune could
+    // either create two different fingerprints depending on
+    // the clock speed chosen by the player, or there could be
+    // two different values stored in the database/cache.
+
+    return ptr - trailer;
+}
+
 const char *PSID::createMD5(char *md5)
 {
     if (md5 == nullptr)
@@ -368,52 +437,13 @@ const char *PSID::createMD5(char *md5)
 
     try
     {
+        uint8_t trailer[MD5_TRAILER_SIZE];
+        const int trailerLen = md5Trailer(trailer);
+
         // Include C64 data.
         sidmd5 myMD5;
-        myMD5.append(&cache[fileOffset], info->m_c64dataLen);
-
-        uint8_t tmp[2];
-        // Include INIT and PLAY address.
-        endian_little16(tmp, info->m_initAddr);
-        myMD5.append(tmp, sizeof(tmp));
-        endian_little16(tmp, info->m_playAddr);
-        myMD5.append(tmp, sizeof(tmp));
-
-        // Include number of songs.
-        endian_little16(tmp, info->m_songs);
-        myMD5.append(tmp, sizeof(tmp));
-
-        {
-            // Include song speed for each song.
-            const unsigned int currentSong = info->m_currentSong;
-            for (unsigned int s = 1; s <= info->m_songs; s++)
-            {
-                selectSong(s);
-                const uint8_t songSpeed = static_cast<uint8_t>(info->m_songSpeed);
-                myMD5.append(&songSpeed, sizeof(songSpeed));
-            }
-            // Restore old song
-            selectSong(currentSong);
-        }
-
-        // Deal with PSID v2NG clock speed flags: Let only NTSC
-        // clock speed change the MD5 fingerprint. That way the
-        // fingerprint of a PAL-speed sidtune in PSID v1, v2, and
-        // PSID v2NG format is the same.
-        if (info->m_clockSpeed == SidTuneInfo::CLOCK_NTSC)
-        {
-            const uint8_t ntsc_val = 2;
-            myMD5.append(&ntsc_val, sizeof(ntsc_val));
-        }
-
-        // NB! If the fingerprint is used as an index into a
-        // song-lengths database or cache, modify above code to
-        // allow for PSID v2NG files which have clock speed set to
-        // SIDTUNE_CLOCK_ANY. If the SID player program fully
-        // supports the SIDTUNE_CLOCK_ANY setting, a sidtune could
-        // either create two different fingerprints depending on
-        // the clock speed chosen by the player, or there could be
-        // two different values stored in the database/cache.
+        myMD5.append(tuneData + fileOffset, info->m_c64dataLen);
+        myMD5.append(trailer, trailerLen);
 
         myMD5.finish();
 
@@ -441,7 +471,7 @@ const char *PSID::createMD5New(char *md5)
         // The calculation is now simplified
         // All the header + all the data
         sidmd5 myMD5;
-        myMD5.append(&cache[0], cache.size());
+        myMD5.append(tuneData, tuneDataLen);
 
         myMD5.finish();
 
@@ -52,7 +52,7 @@ private:
      *
      * @throw loadError
      */
-    static void readHeader(const buffer_t &dataBuf, psidHeader &hdr);
+    static void readHeader(const uint_least8_t* dataBuf, uint_least32_t dataLen, psidHeader &hdr);
 
 protected:
     PSID() {}
@@ -64,7 +64,18 @@ public:
      * @return pointer to a SidTune or 0 if not a PSID file
      * @throw loadError if PSID file is corrupt
      */
-    static SidTuneBase* load(buffer_t& dataBuf);
+    static SidTuneBase* load(const uint_least8_t* dataBuf, uint_least32_t dataLen);
+
+    /**
+     * Get the number of bytes needed to read the header,
+     * as far as it can be told from the available data.
+     *
+     * @return the header size including the C64 load address,
+     *         0 if not a PSID file
+     */
+    static uint_least32_t headerSize(const uint_least8_t* dataBuf, uint_least32_t dataLen);
+
+    int md5Trailer(uint8_t* trailer) override;
 
     const char *createMD5(char *md5) override;
 
@@ -49,7 +49,6 @@ namespace libsidplayfp
 const char ERR_EMPTY[]               = "SIDTUNE ERROR: No data to load";
 const char ERR_UNRECOGNIZED_FORMAT[] = "SIDTUNE ERROR: Could not determine file format";
 const char ERR_CANT_LOAD_FILE[]      = "SIDTUNE ERROR: Could not load input file";
-const char ERR_CANT_OPEN_FILE[]      = "SIDTUNE ERROR: Could not open file for binary input";
 const char ERR_FILE_TOO_LONG[]       = "SIDTUNE ERROR: Input data too long";
 const char ERR_DATA_TOO_LONG[]       = "SIDTUNE ERROR: Size of music data exceeds C64 memory";
 const char ERR_BAD_ADDR[]            = "SIDTUNE ERROR: Bad address data";
@@ -59,6 +58,7 @@ const char ERR_CORRUPT[]             = "SIDTUNE ERROR: File is incomplete or cor
 
 const char SidTuneBase::ERR_TRUNCATED[] = "SIDTUNE ERROR: File is most likely truncated";
 const char SidTuneBase::ERR_INVALID[]   = "SIDTUNE ERROR: File contains invalid data";
+const char SidTuneBase::ERR_CANT_OPEN_FILE[] = "SIDTUNE ERROR: Could not open file for binary input";
 
 /**
  * Petscii to Ascii conversion table (0x01 = no output).
@@ -119,6 +119,60 @@ SidTuneBase* SidTuneBase::read(const uint_least8_t* sourceBuffer, uint_least32_t
     return getFromBuffer(sourceBuffer, bufferLen);
 }
 
+SidTuneBase* SidTuneBase::borrow(const uint_least8_t* sourceBuffer, uint_least32_t bufferLen)
+{
+    if (sourceBuffer == nullptr || bufferLen == 0)
+    {
+        throw loadError(ERR_EMPTY);
+    }
+
+    if (bufferLen > MAX_FILELEN)
+    {
+        throw loadError(ERR_FILE_TOO_LONG);
+    }
+
+    std::unique_ptr<SidTuneBase> s(PSID::load(sourceBuffer, bufferLen));
+    if (s.get() == nullptr)
+        return getFromBuffer(sourceBuffer, bufferLen);
+
+    s->acceptData("-", "-", sourceBuffer, bufferLen, false);
+    return s.release();
+}
+
+SidTuneBase* SidTuneBase::loadMapped(const char* fileName, const char **fileNameExt, bool separatorIsSlash)
+{
+    if (fileName == nullptr)
+        return nullptr;
+
+#if !defined(SIDTUNE_NO_STDIN_LOADER)
+    if (strcmp(fileName, "-") == 0)
+        return getFromStdIn();
+#endif
+
+    mappedFile file;
+    if (!file.open(fileName))
+    {
+        throw loadError(ERR_CANT_OPEN_FILE);
+    }
+
+    if (file.size() == 0)
+    {
+        throw loadError(ERR_EMPTY);
+    }
+
+    std::unique_ptr<SidTuneBase> s;
+    if (file.size() <= MAX_FILELEN)
+        s.reset(PSID::load(file.data(), file.size()));
+
+    // Other formats may need a companion file, use the regular path
+    if (s.get() == nullptr)
+        return getFromFiles(nullptr, fileName, fileNameExt, separatorIsSlash);
+
+    s->acceptData(fileName, nullptr, file.data(), file.size(), separatorIsSlash);
+    s->mapping.swap(file);
+    return s.release();
+}
+
 const SidTuneInfo* SidTuneBase::getInfo() const
 {
     return info.get();
@@ -178,7 +232,7 @@ void SidTuneBase::placeSidTuneInC64mem(sidmemory& mem)
     mem.writeMemWord(0xae, end);
 
     // Copy data from cache to the correct destination.
-    mem.fillRam(info->m_loadAddr, &cache[fileOffset], info->m_c64dataLen);
+    mem.fillRam(info->m_loadAddr, tuneData + fileOffset, info->m_c64dataLen);
 }
 
 void SidTuneBase::loadFile(const char* fileName, buffer_t& bufferRef)
@@ -201,18 +255,19 @@ void SidTuneBase::loadFile(const char* fileName, buffer_t& bufferRef)
     inFile.seekg(0, inFile.beg);
 
     buffer_t fileBuf;
-    fileBuf.reserve(fileLen);
 
     try
     {
-        fileBuf.assign(std::istreambuf_iterator<char>(inFile), std::istreambuf_iterator<char>());
+        fileBuf.resize(fileLen);
     }
     catch (std::exception &ex)
     {
         throw loadError(ex.what());
     }
 
-    if (inFile.bad())
+    inFile.read(reinterpret_cast<char*>(fileBuf.data()), fileLen);
+
+    if (inFile.gcount() != fileLen)
     {
         throw loadError(ERR_CANT_LOAD_FILE);
     }
@@ -224,7 +279,9 @@ void SidTuneBase::loadFile(const char* fileName, buffer_t& bufferRef)
 
 SidTuneBase::SidTuneBase() :
     info(new SidTuneInfoImpl()),
-    fileOffset(0)
+    fileOffset(0),
+    tuneData(nullptr),
+    tuneDataLen(0)
 {
     // Initialize the object with some safe defaults.
     for (unsigned int si = 0; si < MAX_SONGS; si++)
@@ -268,7 +325,7 @@ SidTuneBase* SidTuneBase::getFromBuffer(const uint_least8_t* const buffer, uint_
     buffer_t buf1(buffer, buffer + bufferLen);
 
     // Here test for the possible single file formats.
-    std::unique_ptr<SidTuneBase> s(PSID::load(buf1));
+    std::unique_ptr<SidTuneBase> s(PSID::load(buf1.data(), buf1.size()));
     if (s.get() == nullptr) s.reset(MUS::load(buf1, true));
     if (s.get() == nullptr) throw loadError(ERR_UNRECOGNIZED_FORMAT);
 
@@ -278,6 +335,15 @@ SidTuneBase* SidTuneBase::getFromBuffer(const uint_least8_t* const buffer, uint_
 
 void SidTuneBase::acceptSidTune(const char* dataFileName, const char* infoFileName,
                             buffer_t& buf, bool isSlashedFileName)
+{
+    acceptData(dataFileName, infoFileName, buf.data(), buf.size(), isSlashedFileName);
+
+    // Swapping keeps the data in place
+    cache.swap(buf);
+}
+
+void SidTuneBase::acceptData(const char* dataFileName, const char* infoFileName,
+                            const uint_least8_t* data, uint_least32_t dataLen, bool isSlashedFileName)
 {
     // Make a copy of the data file name and path, if available.
     if (dataFileName != nullptr)
@@ -314,12 +380,12 @@ void SidTuneBase::acceptSidTune(const char* dataFileName, const char* infoFileNa
         info->m_startSong = 1;
     }
 
-    info->m_dataFileLen = buf.size();
-    info->m_c64dataLen = buf.size() - fileOffset;
+    info->m_dataFileLen = dataLen;
+    info->m_c64dataLen = dataLen - fileOffset;
 
     // Calculate any remaining addresses and then
     // confirm all the file details are correct
-    resolveAddrs(&buf[fileOffset]);
+    resolveAddrs(data + fileOffset);
 
     if (checkRelocInfo() == false)
     {
@@ -335,7 +401,7 @@ void SidTuneBase::acceptSidTune(const char* dataFileName, const char* infoFileNa
         // We only detect an offset of two. Some position independent
         // sidtunes contain a load address of 0xE000, but are loaded
         // to 0x0FFE and call player at 0x1000.
-        info->m_fixLoad = (endian_little16(&buf[fileOffset])==(info->m_loadAddr+2));
+        info->m_fixLoad = (endian_little16(data + fileOffset)==(info->m_loadAddr+2));
     }
 
     // Check the size of the data.
@@ -348,7 +414,8 @@ void SidTuneBase::acceptSidTune(const char* dataFileName, const char* infoFileNa
         throw loadError(ERR_EMPTY);
     }
 
-    cache.swap(buf);
+    tuneData = data;
+    tuneDataLen = dataLen;
 }
 
 void SidTuneBase::createNewFileName(std::string& destString,
@@ -377,7 +444,7 @@ SidTuneBase* SidTuneBase::getFromFiles(LoaderFunc loader, const char* fileName,
     loader(fileName, fileBuf1);
 
     // File loaded. Now check if it is in a valid single-file-format.
-    std::unique_ptr<SidTuneBase> s(PSID::load(fileBuf1));
+    std::unique_ptr<SidTuneBase> s(PSID::load(fileBuf1.data(), fileBuf1.size()));
     if (s.get() == nullptr)
     {
         // Try some native C64 file formats
@@ -600,4 +667,68 @@ std::string SidTuneBase::petsciiToAscii(SmartPtr_sidtt<const uint8_t>& spPet)
     return buffer;
 }
 
+
+// ------------------------------------------------- streamLoader
+
+streamLoader::streamLoader() :
+    minLen(0),
+    maxLen(MAX_FILELEN)
+{}
+
+void streamLoader::readHeader()
+{
+    const uint_least32_t headerLen = PSID::headerSize(buffer.data(), buffer.size());
+    if (headerLen == 0)
+    {
+        throw loadError(ERR_UNRECOGNIZED_FORMAT);
+    }
+
+    if (buffer.size() < headerLen)
+    {
+        minLen = headerLen;
+        return;
+    }
+
+    tune.reset(PSID::load(buffer.data(), buffer.size()));
+
+    // The load address may be stored in front of the C64 data
+    const uint_least32_t dataStart = tune->fileOffset + ((tune->info->m_loadAddr == 0) ? 2 : 0);
+    minLen = dataStart + 1;
+    maxLen = std::min(dataStart + MAX_MEMORY, MAX_FILELEN);
+
+    // Make room for the whole file so the data is never moved
+    buffer.reserve(maxLen);
+}
+
+uint_least32_t streamLoader::append(const uint_least8_t* data, uint_least32_t dataLen)
+{
+    if (dataLen > maxLen - buffer.size())
+    {
+        throw loadError((tune.get() != nullptr) ? ERR_DATA_TOO_LONG : ERR_FILE_TOO_LONG);
+    }
+
+    buffer.insert(buffer.end(), data, data + dataLen);
+
+    if (tune.get() == nullptr)
+        readHeader();
+
+    return (buffer.size() < minLen) ? minLen - buffer.size() : 0;
+}
+
+SidTuneBase* streamLoader::finish()
+{
+    if (buffer.empty())
+    {
+        throw loadError(ERR_EMPTY);
+    }
+
+    if (tune.get() == nullptr)
+    {
+        throw loadError(SidTuneBase::ERR_TRUNCATED);
+    }
+
+    tune->acceptSidTune("-", "-", buffer, false);
+    return tune.release();
+}
+
 }
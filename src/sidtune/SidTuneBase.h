@@ -33,6 +33,7 @@
 
 #include "SmartPtr.h"
 #include "SidTuneInfoImpl.h"
+#include "mappedFile.h"
 
 #include "sidcxx11.h"
 
@@ -59,6 +60,8 @@ public:
  */
 class SidTuneBase
 {
+    friend class streamLoader;
+
 protected:
     using buffer_t = std::vector<uint8_t>;
 
@@ -71,6 +74,12 @@ protected:
     static const char ERR_INVALID[];
 
 public:  // ----------------------------------------------------------------
+    /// Init and play address, number of songs, speeds and clock
+    static constexpr unsigned int MD5_TRAILER_SIZE = 2 + 2 + 2 + MAX_SONGS + 1;
+
+    /// Missing file, also reported by custom loaders
+    static const char ERR_CANT_OPEN_FILE[];
+
     virtual ~SidTuneBase() = default;
 
     using LoaderFunc = void (*)(const char* fileName, buffer_t& bufferRef);
@@ -120,6 +129,32 @@ public:  // ----------------------------------------------------------------
      */
     static SidTuneBase* read(const uint_least8_t* sourceBuffer, uint_least32_t bufferLen);
 
+    /**
+     * Load a single-file sidtune from a memory buffer without copying it.
+     * PSID files are parsed in place and the buffer must outlive the tune,
+     * other formats fall back to a private copy.
+     *
+     * @param sourceBuffer
+     * @param bufferLen
+     * @return the sid tune
+     * @throw loadError
+     */
+    static SidTuneBase* borrow(const uint_least8_t* sourceBuffer, uint_least32_t bufferLen);
+
+    /**
+     * Load a sidtune from a file, mapped into memory if large enough.
+     * PSID files are parsed in place and the data is only copied
+     * when placed into the C64 memory, other formats fall back
+     * to the regular loader.
+     *
+     * @param fileName
+     * @param fileNameExt
+     * @param separatorIsSlash
+     * @return the sid tune
+     * @throw loadError
+     */
+    static SidTuneBase* loadMapped(const char* fileName, const char **fileNameExt, bool separatorIsSlash);
+
     /**
      * Select sub-song (0 = default starting song)
      * and return active song number out of [1,2,..,SIDTUNE_MAX_SONGS].
@@ -167,10 +202,25 @@ public:  // ----------------------------------------------------------------
      */
     virtual const char *createMD5New(char *) { return nullptr; }
 
+    /**
+     * Get the data hashed after the C64 data by #createMD5.
+     *
+     * @param trailer buffer of at least MD5_TRAILER_SIZE bytes
+     * @return the size of the trailer, -1 if the MD5 is not supported
+     */
+    virtual int md5Trailer(uint8_t*) { return -1; }
+
+    /**
+     * Get the pointer to the whole file, as hashed by #createMD5New.
+     */
+    const uint_least8_t* fileData() const { return tuneData; }
+
+    uint_least32_t fileDataLen() const { return tuneDataLen; }
+
     /**
      * Get the pointer to the tune data.
      */
-    const uint_least8_t* c64Data() const { return &cache[fileOffset]; }
+    const uint_least8_t* c64Data() const { return tuneData + fileOffset; }
 
 protected:  // -------------------------------------------------------------
 
@@ -182,8 +232,15 @@ protected:  // -------------------------------------------------------------
     /// For files with header: offset to real data
     uint_least32_t fileOffset;
 
+    /// The whole file, either in cache, in mapping or borrowed
+    const uint_least8_t* tuneData;
+
+    uint_least32_t tuneDataLen;
+
     buffer_t cache;
 
+    mappedFile mapping;
+
 protected:
     SidTuneBase();
 
@@ -243,6 +300,15 @@ protected:
     virtual void acceptSidTune(const char* dataFileName, const char* infoFileName,
                         buffer_t& buf, bool isSlashedFileName);
 
+    /**
+     * Like acceptSidTune but referencing the data in place.
+     * The data must outlive the object.
+     *
+     * @throw loadError
+     */
+    void acceptData(const char* dataFileName, const char* infoFileName,
+                        const uint_least8_t* data, uint_least32_t dataLen, bool isSlashedFileName);
+
     /**
      * Petscii to Ascii converter.
      */
@@ -277,6 +343,62 @@ private:
     SidTuneBase& operator=(SidTuneBase&) = delete;
 };
 
+/**
+ * Loads a single-file sidtune from data arriving in chunks.
+ * Currently supported: PSID format.
+ *
+ * The chunks are appended to the buffer that becomes the tune data,
+ * and the header is checked as soon as it is complete.
+ */
+class streamLoader
+{
+private:
+    std::vector<uint8_t> buffer;
+
+    /// The tune, once the header has been read
+    std::unique_ptr<SidTuneBase> tune;
+
+    /// Minimum length of the complete file
+    uint_least32_t minLen;
+
+    /// Maximum length of the complete file
+    uint_least32_t maxLen;
+
+private:
+    /**
+     * Read the header if enough data is available.
+     *
+     * @throw loadError
+     */
+    void readHeader();
+
+public:
+    streamLoader();
+
+    /**
+     * Append a chunk of data.
+     *
+     * @param data
+     * @param dataLen
+     * @return the minimum number of bytes still needed
+     * @throw loadError
+     */
+    uint_least32_t append(const uint_least8_t* data, uint_least32_t dataLen);
+
+    /**
+     * Complete the tune with the data received so far.
+     *
+     * @return the sid tune
+     * @throw loadError
+     */
+    SidTuneBase* finish();
+
+private:
+    // prevent copying
+    streamLoader(const streamLoader&) = delete;
+    streamLoader& operator=(streamLoader&) = delete;
+};
+
 }
 
 #endif  /* SIDTUNEBASE_H */
@@ -0,0 +1,140 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "mappedFile.h"
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <fstream>
+
+#if defined(HAVE_SYS_MMAN_H) && defined(HAVE_UNISTD_H)
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#  define USE_MMAP
+#endif
+
+namespace libsidplayfp
+{
+
+#ifdef USE_MMAP
+/**
+ * Below this size setting up and tearing down the mapping
+ * costs more than reading the file.
+ */
+constexpr off_t MMAP_THRESHOLD = 64 * 1024;
+#endif
+
+void mappedFile::close()
+{
+    if (m_data == nullptr)
+        return;
+
+#ifdef USE_MMAP
+    if (m_mapped)
+        munmap(m_data, m_size);
+    else
+#endif
+        delete [] m_data;
+
+    m_data = nullptr;
+    m_mapped = false;
+    m_size = 0;
+}
+
+bool mappedFile::open(const char* fileName)
+{
+    close();
+
+#ifdef USE_MMAP
+    const int fd = ::open(fileName, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if ((fstat(fd, &st) != 0) || !S_ISREG(st.st_mode))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    if (st.st_size >= MMAP_THRESHOLD)
+    {
+        void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+
+        if (addr == MAP_FAILED)
+            return false;
+
+        m_data = static_cast<uint_least8_t*>(addr);
+        m_size = st.st_size;
+        m_mapped = true;
+        return true;
+    }
+
+    bool ok = true;
+    if (st.st_size > 0)
+    {
+        uint_least8_t* buffer = new uint_least8_t[st.st_size];
+        ok = read(fd, buffer, st.st_size) == st.st_size;
+        if (ok)
+        {
+            m_data = buffer;
+            m_size = st.st_size;
+        }
+        else
+        {
+            delete [] buffer;
+        }
+    }
+    ::close(fd);
+
+    return ok;
+#else
+    std::ifstream is(fileName, std::ios::in | std::ios::binary);
+    if (is.fail())
+        return false;
+
+    is.seekg(0, is.end);
+    const std::streamoff fileSize = is.tellg();
+    is.seekg(0, is.beg);
+
+    if (fileSize <= 0)
+        return fileSize == 0;
+
+    uint_least8_t* buffer = new uint_least8_t[fileSize];
+    is.read(reinterpret_cast<char*>(buffer), fileSize);
+    if (is.gcount() != fileSize)
+    {
+        delete [] buffer;
+        return false;
+    }
+
+    m_data = buffer;
+    m_size = fileSize;
+
+    return true;
+#endif
+}
+
+}
@@ -0,0 +1,85 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <utility>
+
+#include <stdint.h>
+
+namespace libsidplayfp
+{
+
+/**
+ * Read-only view of a whole file.
+ *
+ * Large files are mapped into memory where supported,
+ * others are read into a buffer in a single call.
+ */
+class mappedFile
+{
+private:
+    /// Start of the mapping or of the buffer holding the file
+    uint_least8_t* m_data = nullptr;
+
+    /// Size of the file
+    size_t m_size = 0;
+
+    /// True if m_data is a mapping rather than a buffer
+    bool m_mapped = false;
+
+private:
+    mappedFile(const mappedFile&) = delete;
+    mappedFile& operator=(const mappedFile&) = delete;
+
+public:
+    mappedFile() = default;
+    ~mappedFile() { close(); }
+
+    /**
+     * Map a file, releasing the current one.
+     *
+     * @param fileName
+     * @return false if the file can't be opened
+     */
+    bool open(const char* fileName);
+
+    /**
+     * Release the file.
+     */
+    void close();
+
+    void swap(mappedFile& other)
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_mapped, other.m_mapped);
+    }
+
+    const uint_least8_t* data() const { return m_data; }
+
+    size_t size() const { return m_size; }
+};
+
+}
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,302 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "BatchRenderer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "SidDatabase.h"
+
+#include "sidplayfp/sidplayfp.h"
+#include "sidplayfp/SidConfig.h"
+#include "sidplayfp/SidTune.h"
+
+#include "builders/residfp-builder/residfp.h"
+
+#include "sidcxx11.h"
+
+const char ERR_JOB_CANCELLED[] = "BATCH RENDERER ERROR: Job cancelled.";
+const char ERR_NO_SINK[]       = "BATCH RENDERER ERROR: No sink.";
+
+namespace libsidplayfp
+{
+
+/**
+ * The job list and the resources shared by the workers.
+ */
+class renderQueue
+{
+public:
+    struct job_t
+    {
+        std::string fileName;
+        unsigned int song;
+        uint_least32_t lengthMs;
+        SidConfig config;
+        bool hasConfig;
+        BatchRenderer::Sink *sink;
+
+        std::atomic<bool> cancelled;
+        std::atomic<bool> finished;
+        std::atomic<uint_least32_t> progress;
+    };
+
+public:
+    /// Samples rendered per call to sidplayfp::play
+    static constexpr uint_least32_t BUFFER_SIZE = 8192;
+
+    /// Maximum number of SIDs a tune can use
+    static constexpr unsigned int MAX_SIDS = 3;
+
+public:
+    std::vector<std::unique_ptr<job_t>> jobs;
+
+    /// Next job to be picked up
+    std::atomic<unsigned int> next;
+
+    /// Set if any job didn't complete
+    std::atomic<bool> failed;
+
+    SidConfig config;
+
+    const SidDatabase *database = nullptr;
+
+    uint_least32_t defaultLength = 3 * 60 * 1000;
+
+    const uint8_t *kernal = nullptr;
+    const uint8_t *basic = nullptr;
+    const uint8_t *chargen = nullptr;
+
+private:
+    const char *render(sidplayfp &engine, sidbuilder &builder, job_t &job, unsigned int idx, short *buffer);
+
+public:
+    void worker();
+};
+
+const char *renderQueue::render(sidplayfp &engine, sidbuilder &builder, job_t &job, unsigned int idx, short *buffer)
+{
+    if (job.cancelled)
+        return ERR_JOB_CANCELLED;
+
+    if (job.sink == nullptr)
+        return ERR_NO_SINK;
+
+    SidTune tune(nullptr);
+    tune.loadMapped(job.fileName.c_str());
+    if (!tune.getStatus())
+        return tune.statusString();
+
+    tune.selectSong(job.song);
+
+    uint_least32_t lengthMs = job.lengthMs;
+    if ((lengthMs == 0) && (database != nullptr))
+    {
+        const int_least32_t dbLength = database->lengthMs(tune, nullptr);
+        if (dbLength > 0)
+            lengthMs = dbLength;
+    }
+    if (lengthMs == 0)
+        lengthMs = defaultLength;
+
+    SidConfig cfg = job.hasConfig ? job.config : config;
+    cfg.sidEmulation = &builder;
+
+    if (!engine.config(cfg) || !engine.load(&tune))
+        return engine.error();
+
+    const uint_least32_t channels = cfg.playback;
+    const uint_least64_t samplesPerSecond = static_cast<uint_least64_t>(cfg.frequency) * channels;
+    uint_least64_t total = samplesPerSecond * lengthMs / 1000;
+    // Don't end with half a frame
+    total -= total % channels;
+
+    const char *error = nullptr;
+
+    uint_least64_t rendered = 0;
+    while (rendered < total)
+    {
+        if (job.cancelled)
+        {
+            error = ERR_JOB_CANCELLED;
+            break;
+        }
+
+        const uint_least32_t count = static_cast<uint_least32_t>(
+            std::min<uint_least64_t>(BUFFER_SIZE, total - rendered));
+        const uint_least32_t played = engine.play(buffer, count);
+
+        rendered += played;
+        job.progress = static_cast<uint_least32_t>(rendered * 1000 / samplesPerSecond);
+
+        if ((played != 0) && !job.sink->samples(idx, buffer, played))
+        {
+            error = ERR_JOB_CANCELLED;
+            break;
+        }
+
+        if ((played < count) && !engine.isPlaying())
+        {
+            error = engine.error();
+            break;
+        }
+    }
+
+    // The tune is going out of scope
+    engine.load(nullptr);
+
+    return error;
+}
+
+void renderQueue::worker()
+{
+    sidplayfp engine;
+    engine.setRoms(kernal, basic, chargen);
+
+    ReSIDfpBuilder builder("BatchRenderer");
+    builder.create(MAX_SIDS);
+
+    std::unique_ptr<short[]> buffer(new short[BUFFER_SIZE]);
+
+    for (;;)
+    {
+        const unsigned int idx = next++;
+        if (idx >= jobs.size())
+            break;
+
+        job_t &job = *jobs[idx];
+
+        const char *error = render(engine, builder, job, idx, buffer.get());
+
+        if (error != nullptr)
+            failed = true;
+
+        job.finished = true;
+
+        if (job.sink != nullptr)
+            job.sink->finished(idx, error);
+    }
+}
+
+}
+
+BatchRenderer::BatchRenderer() :
+    m_queue(new libsidplayfp::renderQueue())
+{}
+
+BatchRenderer::~BatchRenderer()
+{
+    delete m_queue;
+}
+
+void BatchRenderer::setRoms(const uint8_t* kernal, const uint8_t* basic, const uint8_t* character)
+{
+    m_queue->kernal = kernal;
+    m_queue->basic = basic;
+    m_queue->chargen = character;
+}
+
+void BatchRenderer::setConfig(const SidConfig &cfg)
+{
+    m_queue->config = cfg;
+}
+
+void BatchRenderer::setDatabase(const SidDatabase *database)
+{
+    m_queue->database = database;
+}
+
+void BatchRenderer::setDefaultLength(uint_least32_t lengthMs)
+{
+    m_queue->defaultLength = lengthMs;
+}
+
+unsigned int BatchRenderer::add(const char *fileName, unsigned int song, Sink *sink,
+                                uint_least32_t lengthMs, const SidConfig *config)
+{
+    std::unique_ptr<libsidplayfp::renderQueue::job_t> job(new libsidplayfp::renderQueue::job_t());
+    job->fileName = fileName;
+    job->song = song;
+    job->lengthMs = lengthMs;
+    job->hasConfig = config != nullptr;
+    if (job->hasConfig)
+        job->config = *config;
+    job->sink = sink;
+    job->cancelled = false;
+    job->finished = false;
+    job->progress = 0;
+
+    m_queue->jobs.push_back(std::move(job));
+    return static_cast<unsigned int>(m_queue->jobs.size() - 1);
+}
+
+unsigned int BatchRenderer::jobs() const
+{
+    return static_cast<unsigned int>(m_queue->jobs.size());
+}
+
+void BatchRenderer::clear()
+{
+    m_queue->jobs.clear();
+}
+
+bool BatchRenderer::run(unsigned int threads)
+{
+    if (threads == 0)
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    threads = std::min(threads, jobs());
+
+    m_queue->next = 0;
+    m_queue->failed = false;
+
+    std::vector<std::thread> workers;
+    for (unsigned int i = 1; i < threads; i++)
+        workers.emplace_back(&libsidplayfp::renderQueue::worker, m_queue);
+
+    // The calling thread is a worker too
+    if (threads != 0)
+        m_queue->worker();
+
+    for (std::thread &t : workers)
+        t.join();
+
+    return !m_queue->failed;
+}
+
+void BatchRenderer::cancel(unsigned int job)
+{
+    if (job < jobs())
+        m_queue->jobs[job]->cancelled = true;
+}
+
+uint_least32_t BatchRenderer::progress(unsigned int job) const
+{
+    return job < jobs() ? m_queue->jobs[job]->progress.load() : 0;
+}
+
+bool BatchRenderer::finished(unsigned int job) const
+{
+    return job < jobs() ? m_queue->jobs[job]->finished.load() : false;
+}
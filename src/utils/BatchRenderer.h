@@ -0,0 +1,182 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef BATCHRENDERER_H
+#define BATCHRENDERER_H
+
+#include <stdint.h>
+
+#include "sidplayfp/siddefs.h"
+
+class SidConfig;
+class SidDatabase;
+
+namespace libsidplayfp
+{
+class renderQueue;
+}
+
+/**
+ * BatchRenderer
+ * Render a list of subtunes on a pool of threads.
+ *
+ * Each worker thread owns an engine and a reSIDfp builder,
+ * reused for all the jobs it picks up, while immutable data
+ * is shared: the ROM images, the filter and waveform tables
+ * and the resampler FIR tables.
+ *
+ * Jobs are taken in order by the first idle worker, so long
+ * and short tunes balance across the pool by themselves.
+ *
+ * @since 2.13
+ */
+class SID_EXTERN BatchRenderer
+{
+public:
+    /**
+     * Receives the output of the jobs.
+     * Methods are called from the worker threads, one sink
+     * shared by several jobs must be thread safe.
+     */
+    class SID_EXTERN Sink
+    {
+    public:
+        virtual ~Sink() {}
+
+        /**
+         * Receive a block of rendered samples,
+         * interleaved for stereo playback.
+         *
+         * @param job the job index
+         * @param buffer the samples
+         * @param count the number of 16 bit samples
+         * @return false to stop the job
+         */
+        virtual bool samples(unsigned int job, const short *buffer, uint_least32_t count) = 0;
+
+        /**
+         * Called once when a job ends.
+         *
+         * @param job the job index
+         * @param error nullptr if the job was rendered completely,
+         *              the reason it stopped otherwise
+         */
+        virtual void finished(unsigned int job, const char *error) { (void)job; (void)error; }
+    };
+
+private:
+    libsidplayfp::renderQueue* m_queue;
+
+public:
+    BatchRenderer();
+    ~BatchRenderer();
+
+    /**
+     * Set the C64 ROM images used by all the engines.
+     * The images must stay valid until #run returns.
+     */
+    void setRoms(const uint8_t* kernal, const uint8_t* basic=0, const uint8_t* character=0);
+
+    /**
+     * Set the configuration of the jobs without their own.
+     * The emulation is always reSIDfp, SidConfig::sidEmulation is ignored.
+     */
+    void setConfig(const SidConfig &cfg);
+
+    /**
+     * Set the songlength database used for the jobs
+     * without an explicit length.
+     * The database must stay open until #run returns.
+     *
+     * @param database the database, nullptr to not use one
+     */
+    void setDatabase(const SidDatabase *database);
+
+    /**
+     * Set the length of the jobs without an explicit length
+     * and not found in the database.
+     *
+     * @param lengthMs the length in milliseconds (default 3 minutes)
+     */
+    void setDefaultLength(uint_least32_t lengthMs);
+
+    /**
+     * Add a job.
+     *
+     * @param fileName the tune file name with full path
+     * @param song the subtune, 0 for the start song
+     * @param sink where to send the output
+     * @param lengthMs the length in milliseconds, 0 for
+     *                 the database or default length
+     * @param config the configuration, nullptr for the one set with #setConfig
+     * @return the job index
+     */
+    unsigned int add(const char *fileName, unsigned int song, Sink *sink,
+                     uint_least32_t lengthMs = 0, const SidConfig *config = nullptr);
+
+    /**
+     * Get the number of jobs.
+     */
+    unsigned int jobs() const;
+
+    /**
+     * Remove all the jobs.
+     */
+    void clear();
+
+    /**
+     * Render all the jobs, returning when they are done.
+     *
+     * @param threads number of workers, 0 for one per hardware thread
+     * @return false if any job failed or was cancelled
+     */
+    bool run(unsigned int threads = 0);
+
+    /**
+     * Stop a job, or skip it if not started yet.
+     * Can be called from any thread, including sinks,
+     * while #run is executing.
+     *
+     * @param job the job index
+     */
+    void cancel(unsigned int job);
+
+    /**
+     * Get the progress of a job.
+     * Can be called from any thread while #run is executing.
+     *
+     * @param job the job index
+     * @return the rendered time in milliseconds
+     */
+    uint_least32_t progress(unsigned int job) const;
+
+    /**
+     * Check if a job has ended.
+     *
+     * @param job the job index
+     */
+    bool finished(unsigned int job) const;
+
+private:    // prevent copying
+    BatchRenderer(const BatchRenderer&);
+    BatchRenderer& operator=(BatchRenderer&);
+};
+
+#endif // BATCHRENDERER_H
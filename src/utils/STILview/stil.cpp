@@ -37,6 +37,7 @@
 #include <fstream>
 #include <sstream>
 #include <utility>
+#include <vector>
 
 #include "stringutils.h"
 
@@ -56,6 +57,34 @@ const char  _ARTIST_STR[] = " ARTIST: ";
 const char _COMMENT_STR[] = "COMMENT: ";
 //const char     _BUG_STR[] = "BUG: ";
 
+namespace
+{
+
+/**
+ * Searches for 'str' between 'start' and 'end'.
+ *
+ * @return pointer to the first occurrence, nullptr if not found
+ */
+template <size_t N>
+const char *findStr(const char *start, const char *end, const char (&str)[N])
+{
+    const char *found = std::search(start, end, str, str + N - 1);
+    return found != end ? found : nullptr;
+}
+
+/**
+ * Orders entries by pathname.
+ */
+int comparePath(const char *a, size_t aLen, const char *b, size_t bLen)
+{
+    const int result = memcmp(a, b, std::min(aLen, bLen));
+    if (result != 0)
+        return result;
+    return (aLen < bLen) ? -1 : (aLen > bLen) ? 1 : 0;
+}
+
+}
+
 const char *STIL::STIL_ERROR_STR[] =
 {
     "No error.",
@@ -99,8 +128,6 @@ STIL::STIL(const char *stilPath, const char *bugsPath) :
     PATH_TO_STIL(stilPath),
     PATH_TO_BUGLIST(bugsPath),
     STILVersion(0.0f),
-    STIL_EOL('\n'),
-    STIL_EOL2('\0'),
     lastError(NO_STIL_ERROR)
 {
     setVersionString();
@@ -143,9 +170,11 @@ STIL::setBaseDir(const char *pathToHVSC)
     // Temporary placeholder for STIL.txt's version number.
     const float tempSTILVersion = STILVersion;
 
-    // Temporary placeholders for lists of sections.
-    dirList tempStilDirs;
-    dirList tempBugDirs;
+    // Temporary placeholders for the files and their entries.
+    string tempStilText;
+    string tempBugText;
+    entryList tempStilEntries;
+    entryList tempBugEntries;
 
     lastError = NO_STIL_ERROR;
 
@@ -169,52 +198,51 @@ STIL::setBaseDir(const char *pathToHVSC)
         tempBaseDir.erase(lastChar);
     }
 
-    // Attempt to open STIL
+    // Attempt to read STIL
 
     // Create the full path+filename
     string tempName = tempBaseDir;
     tempName.append(PATH_TO_STIL);
     convertSlashes(tempName);
 
-    ifstream stilFile(tempName.c_str(), STILopenFlags);
-
-    if (stilFile.fail())
+    if (!readFile(tempName, tempStilText))
     {
-        CERR_STIL_DEBUG << "setBaseDir() open failed for " << tempName << endl;
-        lastError = STIL_OPEN;
+        if (tempStilText.empty())
+        {
+            CERR_STIL_DEBUG << "setBaseDir() open failed for " << tempName << endl;
+            lastError = STIL_OPEN;
+        }
+        else
+        {
+            CERR_STIL_DEBUG << "readFile() failed to determine EOL" << endl;
+            lastError = NO_EOL;
+        }
         return false;
     }
 
-    CERR_STIL_DEBUG << "setBaseDir(): open succeeded for " << tempName << endl;
+    CERR_STIL_DEBUG << "setBaseDir(): read succeeded for " << tempName << endl;
 
-    // Attempt to open BUGlist
+    // Attempt to read BUGlist
 
     // Create the full path+filename
     tempName = tempBaseDir;
     tempName.append(PATH_TO_BUGLIST);
     convertSlashes(tempName);
 
-    ifstream bugFile(tempName.c_str(), STILopenFlags);
+    const bool bugRead = readFile(tempName, tempBugText);
 
-    if (bugFile.fail())
+    if (!bugRead)
     {
         // This is not a critical error - some earlier versions of HVSC did
         // not have a BUGlist.txt file at all.
 
         CERR_STIL_DEBUG << "setBaseDir() open failed for " << tempName << endl;
         lastError = BUG_OPEN;
+        tempBugText.clear();
     }
     else
     {
-        CERR_STIL_DEBUG << "setBaseDir(): open succeeded for " << tempName << endl;
-    }
-
-    // Find out what the EOL really is
-    if (determineEOL(stilFile) != true)
-    {
-        CERR_STIL_DEBUG << "determinEOL() failed" << endl;
-        lastError = NO_EOL;
-        return false;
+        CERR_STIL_DEBUG << "setBaseDir(): read succeeded for " << tempName << endl;
     }
 
     // Save away the current string so we can restore it if needed.
@@ -226,11 +254,11 @@ STIL::setBaseDir(const char *pathToHVSC)
     // file, too.
     STILVersion = 0.0;
 
-    // These will populate the tempStilDirs and tempBugDirs maps (or not :)
+    // These will populate the tempStilEntries and tempBugEntries lists (or not :)
 
-    if (getDirs(stilFile, tempStilDirs, true) != true)
+    if (getEntries(tempStilText, tempStilEntries, true) != true)
     {
-        CERR_STIL_DEBUG << "getDirs() failed for stilFile" << endl;
+        CERR_STIL_DEBUG << "getEntries() failed for stilFile" << endl;
         lastError = NO_STIL_DIRS;
 
         // Clean up and restore things.
@@ -239,32 +267,28 @@ STIL::setBaseDir(const char *pathToHVSC)
         return false;
     }
 
-    if (bugFile.good())
+    if (bugRead)
     {
-        if (getDirs(bugFile, tempBugDirs, false) != true)
+        if (getEntries(tempBugText, tempBugEntries, false) != true)
         {
             // This is not a critical error - it is possible that the
             // BUGlist.txt file has no entries in it at all (in fact, that's
             // good!).
 
-            CERR_STIL_DEBUG << "getDirs() failed for bugFile" << endl;
+            CERR_STIL_DEBUG << "getEntries() failed for bugFile" << endl;
             lastError = BUG_OPEN;
         }
     }
 
-    // Now we can copy the stuff into private data.
+    // Now we can move the stuff into private data.
     // NOTE: At this point, STILVersion and the versionString should contain
     // the new info!
 
-    // Copy.
-    baseDir = tempBaseDir;
-    stilDirs = tempStilDirs;
-    bugDirs = tempBugDirs;
-
-    // Clear the buffers (caches).
-    entrybuf.clear();
-    globalbuf.clear();
-    bugbuf.clear();
+    baseDir.swap(tempBaseDir);
+    stilText.swap(tempStilText);
+    bugText.swap(tempBugText);
+    stilEntries.swap(tempStilEntries);
+    bugEntries.swap(tempBugEntries);
 
     CERR_STIL_DEBUG << "setBaseDir() succeeded" << endl;
 
@@ -304,14 +328,35 @@ STIL::getAbsEntry(const char *absPathToEntry, int tuneNo, STILField field)
 const char *
 STIL::getEntry(const char *relPathToEntry, int tuneNo, STILField field)
 {
-    lastError = NO_STIL_ERROR;
+    size_t length;
+    const char *result = getEntry(relPathToEntry, tuneNo, field, length, &lastError);
+
+    if (result == nullptr)
+    {
+        return nullptr;
+    }
+
+    // Put the requested field into the result string.
+    resultEntry.assign(result, length);
+    return resultEntry.c_str();
+}
+
+const char *
+STIL::getEntry(const char *relPathToEntry, int tuneNo, STILField field,
+               size_t &length, STILerror *error) const
+{
+    STILerror tempError;
+    if (error == nullptr)
+        error = &tempError;
+
+    *error = NO_STIL_ERROR;
 
     CERR_STIL_DEBUG << "getEntry() called, relPath=" << relPathToEntry << ", rest=" << tuneNo << "," << field << endl;
 
     if (baseDir.empty())
     {
         CERR_STIL_DEBUG << "HVSC baseDir is not yet set!" << endl;
-        lastError = STIL_OPEN;
+        *error = STIL_OPEN;
         return nullptr;
     }
 
@@ -319,10 +364,10 @@ STIL::getEntry(const char *relPathToEntry, int tuneNo, STILField field)
 
     // Fail if a section-global comment was asked for.
 
-    if (*(relPathToEntry + relPathToEntryLen - 1) == '/')
+    if ((relPathToEntryLen > 0) && (relPathToEntry[relPathToEntryLen - 1] == '/'))
     {
         CERR_STIL_DEBUG << "getEntry() section-global comment was asked for - failed" << endl;
-        lastError = WRONG_ENTRY;
+        *error = WRONG_ENTRY;
         return nullptr;
     }
 
@@ -334,50 +379,28 @@ STIL::getEntry(const char *relPathToEntry, int tuneNo, STILField field)
         field = all;
     }
 
-    // Find out whether we have this entry in the buffer.
+    const entry_t *entry = findEntry(relPathToEntry, stilText, stilEntries);
 
-    if ((!stringutils::equal(entrybuf.data(), relPathToEntry, relPathToEntryLen))
-        || ((entrybuf.find_first_of('\n') != relPathToEntryLen)
-        && (STILVersion > 2.59f)))
+    if (entry == nullptr)
     {
-        // The relative pathnames don't match or they're not the same length:
-        // we don't have it in the buffer, so pull it in.
-
-        CERR_STIL_DEBUG << "getEntry(): entry not in buffer" << endl;
-
-        // Create the full path+filename
-        string tempName(baseDir);
-        tempName.append(PATH_TO_STIL);
-        convertSlashes(tempName);
-
-        ifstream stilFile(tempName.c_str(), STILopenFlags);
+        CERR_STIL_DEBUG << "getEntry() findEntry() failed" << endl;
+        *error = NOT_IN_STIL;
+        return nullptr;
+    }
 
-        if (stilFile.fail())
-        {
-            CERR_STIL_DEBUG << "getEntry() open failed for stilFile" << endl;
-            lastError = STIL_OPEN;
-            return nullptr;
-        }
+    const char *start = stilText.data() + entry->offset + entry->pathLen + 1;
+    const char *end = stilText.data() + entry->end;
 
-        CERR_STIL_DEBUG << "getEntry() open succeeded for stilFile" << endl;
+    const char *result;
+    const char *resultEnd;
 
-        if (positionToEntry(relPathToEntry, stilFile, stilDirs) == false)
-        {
-            // Copy the entry's name to the buffer.
-            entrybuf.assign(relPathToEntry).append("\n");
-            CERR_STIL_DEBUG << "getEntry() posToEntry() failed" << endl;
-            lastError = NOT_IN_STIL;
-        }
-        else
-        {
-            entrybuf.clear();
-            readEntry(stilFile, entrybuf);
-            CERR_STIL_DEBUG << "getEntry() entry read" << endl;
-        }
+    if (!getField(result, resultEnd, start, end, tuneNo, field))
+    {
+        return nullptr;
     }
 
-    // Put the requested field into the result string.
-    return getField(resultEntry, entrybuf.c_str(), tuneNo, field) ? resultEntry.c_str() : nullptr;
+    length = resultEnd - result;
+    return result;
 }
 
 const char *
@@ -412,14 +435,35 @@ STIL::getAbsBug(const char *absPathToEntry, int tuneNo)
 const char *
 STIL::getBug(const char *relPathToEntry, int tuneNo)
 {
-    lastError = NO_STIL_ERROR;
+    size_t length;
+    const char *result = getBug(relPathToEntry, tuneNo, length, &lastError);
+
+    if (result == nullptr)
+    {
+        return nullptr;
+    }
+
+    // Put the requested field into the result string.
+    resultBug.assign(result, length);
+    return resultBug.c_str();
+}
+
+const char *
+STIL::getBug(const char *relPathToEntry, int tuneNo,
+             size_t &length, STILerror *error) const
+{
+    STILerror tempError;
+    if (error == nullptr)
+        error = &tempError;
+
+    *error = NO_STIL_ERROR;
 
     CERR_STIL_DEBUG << "getBug() called, relPath=" << relPathToEntry << ", rest=" << tuneNo << endl;
 
-    if (baseDir.empty())
+    if (baseDir.empty() || bugText.empty())
     {
-        CERR_STIL_DEBUG << "HVSC baseDir is not yet set!" << endl;
-        lastError = BUG_OPEN;
+        CERR_STIL_DEBUG << "BUGlist is not loaded!" << endl;
+        *error = BUG_OPEN;
         return nullptr;
     }
 
@@ -430,54 +474,28 @@ STIL::getBug(const char *relPathToEntry, int tuneNo)
         tuneNo = 0;
     }
 
-    // Find out whether we have this bug entry in the buffer.
-    // If the baseDir was changed, we'll have to read it in again,
-    // even if it might be in the buffer already.
+    const entry_t *entry = findEntry(relPathToEntry, bugText, bugEntries);
 
-    const size_t relPathToEntryLen = strlen(relPathToEntry);
-
-    if ((!stringutils::equal(bugbuf.data(), relPathToEntry, relPathToEntryLen)) ||
-        ((bugbuf.find_first_of('\n') != relPathToEntryLen) &&
-         (STILVersion > 2.59f)))
+    if (entry == nullptr)
     {
-        // The relative pathnames don't match or they're not the same length:
-        // we don't have it in the buffer, so pull it in.
-
-        CERR_STIL_DEBUG << "getBug(): entry not in buffer" << endl;
-
-        // Create the full path+filename
-        string tempName(baseDir);
-        tempName.append(PATH_TO_BUGLIST);
-        convertSlashes(tempName);
-
-        ifstream bugFile(tempName.c_str(), STILopenFlags);
+        CERR_STIL_DEBUG << "getBug() findEntry() failed" << endl;
+        *error = NOT_IN_BUG;
+        return nullptr;
+    }
 
-        if (bugFile.fail())
-        {
-            CERR_STIL_DEBUG << "getBug() open failed for bugFile" << endl;
-            lastError = BUG_OPEN;
-            return nullptr;
-        }
+    const char *start = bugText.data() + entry->offset + entry->pathLen + 1;
+    const char *end = bugText.data() + entry->end;
 
-        CERR_STIL_DEBUG << "getBug() open succeeded for bugFile" << endl;
+    const char *result;
+    const char *resultEnd;
 
-        if (positionToEntry(relPathToEntry, bugFile, bugDirs) == false)
-        {
-            // Copy the entry's name to the buffer.
-            bugbuf.assign(relPathToEntry).append("\n");
-            CERR_STIL_DEBUG << "getBug() posToEntry() failed" << endl;
-            lastError = NOT_IN_BUG;
-        }
-        else
-        {
-            bugbuf.clear();
-            readEntry(bugFile, bugbuf);
-            CERR_STIL_DEBUG << "getBug() entry read" << endl;
-        }
+    if (!getField(result, resultEnd, start, end, tuneNo))
+    {
+        return nullptr;
     }
 
-    // Put the requested field into the result string.
-    return getField(resultBug, bugbuf.c_str(), tuneNo) ? resultBug.c_str() : nullptr;
+    length = resultEnd - result;
+    return result;
 }
 
 const char *
@@ -512,164 +530,178 @@ STIL::getAbsGlobalComment(const char *absPathToEntry)
 const char *
 STIL::getGlobalComment(const char *relPathToEntry)
 {
-    lastError = NO_STIL_ERROR;
+    size_t length;
+    const char *result = getGlobalComment(relPathToEntry, length, &lastError);
+
+    if (result == nullptr)
+    {
+        return nullptr;
+    }
+
+    resultGlobal.assign(result, length);
+    return resultGlobal.c_str();
+}
+
+const char *
+STIL::getGlobalComment(const char *relPathToEntry,
+                       size_t &length, STILerror *error) const
+{
+    STILerror tempError;
+    if (error == nullptr)
+        error = &tempError;
+
+    *error = NO_STIL_ERROR;
 
     CERR_STIL_DEBUG << "getGC() called, relPath=" << relPathToEntry << endl;
 
     if (baseDir.empty())
     {
         CERR_STIL_DEBUG << "HVSC baseDir is not yet set!" << endl;
-        lastError = STIL_OPEN;
+        *error = STIL_OPEN;
         return nullptr;
     }
 
-    // Save the dirpath.
+    // Get the dirpath.
 
     const char *lastSlash = strrchr(relPathToEntry, '/');
 
     if (lastSlash == nullptr)
     {
-        lastError = WRONG_DIR;
+        *error = WRONG_DIR;
         return nullptr;
     }
 
     const size_t pathLen = lastSlash - relPathToEntry + 1;
     const string dir(relPathToEntry, pathLen);
 
-    // Find out whether we have this global comment in the buffer.
-    // If the baseDir was changed, we'll have to read it in again,
-    // even if it might be in the buffer already.
+    const entry_t *entry = findEntry(dir.c_str(), stilText, stilEntries);
 
-    if ((!stringutils::equal(globalbuf.data(), dir.data(), pathLen)) ||
-        ((globalbuf.find_first_of('\n') != pathLen) &&
-         (STILVersion > 2.59f)))
+    if (entry == nullptr)
     {
-        // The relative pathnames don't match or they're not the same length:
-        // we don't have it in the buffer, so pull it in.
-
-        CERR_STIL_DEBUG << "getGC(): entry not in buffer" << endl;
-
-        // Create the full path+filename
-        string tempName(baseDir);
-        tempName.append(PATH_TO_STIL);
-        convertSlashes(tempName);
-
-        ifstream stilFile(tempName.c_str(), STILopenFlags);
-
-        if (stilFile.fail())
-        {
-            CERR_STIL_DEBUG << "getGC() open failed for stilFile" << endl;
-            lastError = STIL_OPEN;
-            return nullptr;
-        }
-
-        if (positionToEntry(dir.c_str(), stilFile, stilDirs) == false)
-        {
-            // Copy the dirname to the buffer.
-            globalbuf.assign(dir).append("\n");
-            CERR_STIL_DEBUG << "getGC() posToEntry() failed" << endl;
-            lastError = NOT_IN_STIL;
-        }
-        else
-        {
-            globalbuf.clear();
-            readEntry(stilFile, globalbuf);
-            CERR_STIL_DEBUG << "getGC() entry read" << endl;
-        }
+        CERR_STIL_DEBUG << "getGC() findEntry() failed" << endl;
+        *error = NOT_IN_STIL;
+        return nullptr;
     }
 
-    CERR_STIL_DEBUG << "getGC() globalbuf=" << globalbuf << endl;
-    CERR_STIL_DEBUG << "-=END=-" << endl;
-
     // Position pointer to the global comment field.
 
-    const size_t temp = globalbuf.find_first_of('\n') + 1;
+    const size_t start = entry->offset + entry->pathLen + 1;
 
     // Check whether this is a NULL entry or not.
-    return temp != globalbuf.size() ? globalbuf.c_str() + temp : nullptr;
+    if (start == entry->end)
+    {
+        return nullptr;
+    }
+
+    length = entry->end - start;
+    return stilText.data() + start;
 }
 
 //////// PRIVATE
 
 bool
-STIL::determineEOL(ifstream &stilFile)
+STIL::readFile(const string &fileName, string &text)
 {
-    CERR_STIL_DEBUG << "detEOL() called" << endl;
+    text.clear();
 
-    if (stilFile.fail())
+    ifstream inFile(fileName.c_str(), STILopenFlags);
+
+    if (inFile.fail())
     {
-        CERR_STIL_DEBUG << "detEOL() open failed" << endl;
         return false;
     }
 
-    stilFile.seekg(0);
+    inFile.seekg(0, ios::end);
+    const streamoff size = inFile.tellg();
+    inFile.seekg(0, ios::beg);
 
-    STIL_EOL = '\0';
-    STIL_EOL2 = '\0';
+    if (size <= 0)
+    {
+        return false;
+    }
+
+    text.resize(static_cast<size_t>(size));
+    inFile.read(&text[0], size);
+    text.resize(static_cast<size_t>(inFile.gcount()));
 
     // Determine what the EOL character is
     // (it can be different from OS to OS).
-    istream::sentry se(stilFile, true);
-    if (se)
-    {
-        streambuf *sb = stilFile.rdbuf();
+    const size_t eol = text.find_first_of("\r\n");
 
-        const int eof = char_traits<char>::eof();
+    if (eol == string::npos)
+    {
+        // Something is wrong - no EOL-like char was found.
+        return false;
+    }
 
-        while (sb->sgetc() != eof)
+    if (text[eol] == '\r')
+    {
+        // Convert CR and CR/LF line endings to LF.
+        string::iterator out = text.begin();
+        for (string::const_iterator it = text.begin(); it != text.end(); ++it)
         {
-            const int c = sb->sbumpc();
-            if ((c == '\n') || (c == '\r'))
+            if (*it == '\r')
             {
-                STIL_EOL = c;
-
-                if (c == '\r')
-                {
-                    if (sb->sgetc() == '\n')
-                        STIL_EOL2 = '\n';
-                }
-                break;
+                *out++ = '\n';
+                if (((it + 1) != text.end()) && (*(it + 1) == '\n'))
+                    ++it;
+            }
+            else
+            {
+                *out++ = *it;
             }
         }
+        text.erase(out, text.end());
     }
 
-    if (STIL_EOL == '\0')
+    // Make sure the last line is terminated, too.
+    if (text[text.size() - 1] != '\n')
     {
-        // Something is wrong - no EOL-like char was found.
-        CERR_STIL_DEBUG << "detEOL() no EOL found" << endl;
-        return false;
+        text.push_back('\n');
     }
 
-    CERR_STIL_DEBUG << "detEOL() EOL1=0x" << hex << static_cast<int>(STIL_EOL) << " EOL2=0x" << hex << static_cast<int>(STIL_EOL2) << dec << endl;
-
     return true;
 }
 
 bool
-STIL::getDirs(ifstream &inFile, dirList &dirs, bool isSTILFile)
+STIL::getEntries(const string &text, entryList &entries, bool isSTILFile)
 {
-    bool newDir = !isSTILFile;
+    CERR_STIL_DEBUG << "getEntries() called" << endl;
 
-    CERR_STIL_DEBUG << "getDirs() called" << endl;
+    const size_t size = text.size();
+    size_t pos = 0;
 
-    inFile.seekg(0);
-
-    while (inFile.good())
+    while (pos < size)
     {
-        string line;
+        const size_t eol = text.find('\n', pos);
+
+        if (text[pos] == '/')
+        {
+            // The entry runs until the first empty line.
+            size_t end = eol + 1;
+            while ((end < size) && (text[end] != '\n'))
+            {
+                end = text.find('\n', end) + 1;
+            }
 
-        getStilLine(inFile, line);
+            entry_t entry;
+            entry.offset = static_cast<uint32_t>(pos);
+            entry.pathLen = static_cast<uint32_t>(eol - pos);
+            entry.end = static_cast<uint32_t>(end);
+            entries.push_back(entry);
 
-        if (!isSTILFile) { CERR_STIL_DEBUG << line << '\n'; }
+            pos = end;
+            continue;
+        }
 
         // Try to extract STIL's version number if it's not done, yet.
 
         if (isSTILFile && (STILVersion == 0.0f))
         {
-            if (strncmp(line.data(), "#  STIL v", 9) == 0)
+            if (text.compare(pos, 9, "#  STIL v") == 0)
             {
                 // Get the version number
-                STILVersion = atof(line.c_str() + 9);
+                STILVersion = atof(text.c_str() + pos + 9);
 
                 // Put it into the string, too.
                 ostringstream ss;
@@ -677,198 +709,104 @@ STIL::getDirs(ifstream &inFile, dirList &dirs, bool isSTILFile)
                 ss << "SID Tune Information List (STIL) v" << STILVersion << endl;
                 versionString.append(ss.str());
 
-                CERR_STIL_DEBUG << "getDirs() STILVersion=" << STILVersion << endl;
-
-                continue;
+                CERR_STIL_DEBUG << "getEntries() STILVersion=" << STILVersion << endl;
             }
         }
 
-        // Search for the start of a dir separator first.
-
-        if (isSTILFile && !newDir && stringutils::equal(line.data(), "### ", 4))
-        {
-            newDir = true;
-            continue;
-        }
-
-        // Is this the start of an entry immediately following a dir separator?
-
-        if (newDir && (line[0] == '/'))
-        {
-            // Get the directory only
-            const string dirName(line, 0, line.find_last_of('/') + 1);
-
-            if (!isSTILFile)
-            {
-                // Compare it to the stored dirnames
-                newDir = (dirs.count(dirName) == 0);
-            }
-
-            // Store the info
-            if (newDir)
-            {
-                const streampos position = inFile.tellg() - (streampos)line.size() - 1L;
-
-                CERR_STIL_DEBUG << "getDirs() dirName=" << dirName << ", pos=" << position <<  endl;
-
-                dirs.insert(make_pair(dirName, position));
-            }
-
-            newDir = !isSTILFile;
-        }
+        pos = eol + 1;
     }
 
-    if (dirs.empty())
+    if (entries.empty())
     {
         // No entries found - something is wrong.
         // NOTE: It's perfectly valid to have a BUGlist.txt file with no
         // entries in it!
-        CERR_STIL_DEBUG << "getDirs() no dirs found" << endl;
+        CERR_STIL_DEBUG << "getEntries() no entries found" << endl;
         return false;
     }
 
-    CERR_STIL_DEBUG << "getDirs() successful" << endl;
+    // Keep the first of duplicate entries.
+    const char *data = text.data();
+    auto less = [data](const entry_t &a, const entry_t &b)
+    {
+        return comparePath(data + a.offset, a.pathLen, data + b.offset, b.pathLen) < 0;
+    };
+    auto equal = [data](const entry_t &a, const entry_t &b)
+    {
+        return comparePath(data + a.offset, a.pathLen, data + b.offset, b.pathLen) == 0;
+    };
+    std::stable_sort(entries.begin(), entries.end(), less);
+    entries.erase(std::unique(entries.begin(), entries.end(), equal), entries.end());
+    entries.shrink_to_fit();
+
+    CERR_STIL_DEBUG << "getEntries() successful, " << entries.size() << " entries" << endl;
 
     return true;
 }
 
-bool
-STIL::positionToEntry(const char *entryStr, ifstream &inFile, dirList &dirs)
+const STIL::entry_t *
+STIL::findEntry(const char *entryStr, const string &text, const entryList &entries) const
 {
-    CERR_STIL_DEBUG << "pos2Entry() called, entryStr=" << entryStr << endl;
-
-    inFile.seekg(0);
-
-    // Get the dirpath.
-
-    char *chrptr = strrchr((char *)entryStr, '/');
-
-    // If no slash was found, something is screwed up in the entryStr.
-
-    if (chrptr == nullptr)
-    {
-        return false;
-    }
-
-    const size_t pathLen = chrptr - entryStr + 1;
-
-    // Determine whether a section-global comment is asked for.
+    CERR_STIL_DEBUG << "findEntry() called, entryStr=" << entryStr << endl;
 
+    const char *data = text.data();
     const size_t entryStrLen = strlen(entryStr);
-    const bool globComm = (pathLen == entryStrLen);
 
-    // Find it in the table.
-    const string entry(entryStr, pathLen);
-    dirList::iterator elem = dirs.find(entry);
+    const entryList::const_iterator elem = std::lower_bound(entries.begin(), entries.end(), entryStr,
+        [data, entryStrLen](const entry_t &a, const char *key)
+        {
+            return comparePath(data + a.offset, a.pathLen, key, entryStrLen) < 0;
+        });
 
-    if (elem == dirs.end())
+    if (elem == entries.end())
     {
-        // The directory was not found.
-        CERR_STIL_DEBUG << "pos2Entry() did not find the dir" << endl;
-        return false;
+        CERR_STIL_DEBUG << "findEntry() entry not found" << endl;
+        return nullptr;
     }
 
-    // Jump to the first entry of this section.
-    inFile.seekg(elem->second);
-    bool foundIt = false;
-
-    // Now find the desired entry
-
-    string line;
-
-    do
-    {
-        getStilLine(inFile, line);
-
-        if (inFile.eof())
-        {
-            break;
-        }
-
-        // Check if it is the start of an entry
-
-        if (line[0] == '/')
-        {
-            if (!stringutils::equal(elem->first.data(), line.data(), pathLen))
-            {
-                // We are outside the section - get out of the loop,
-                // which will fail the search.
-                break;
-            }
-
-            // Check whether we need to find a section-global comment or
-            // a specific entry.
-
-            if (globComm || (STILVersion > 2.59f))
-            {
-                foundIt = stringutils::equal(line.c_str(), entryStr);
-            }
-            else
-            {
-                // To be compatible with older versions of STIL, which may have
-                // the tune designation on the first line of a STIL entry
-                // together with the pathname.
-                foundIt = stringutils::equal(line.data(), entryStr, entryStrLen);
-            }
+    // Determine whether a section-global comment is asked for.
+    const bool globComm = (entryStrLen > 0) && (entryStr[entryStrLen - 1] == '/');
 
-            CERR_STIL_DEBUG << "pos2Entry() line=" << line << endl;
-        }
-    }
-    while (!foundIt);
+    bool foundIt;
 
-    if (foundIt)
+    if (globComm || (STILVersion > 2.59f))
     {
-        // Reposition the file pointer back to the start of the entry.
-        inFile.seekg(inFile.tellg() - (streampos)line.size() - 1L);
-        CERR_STIL_DEBUG << "pos2Entry() entry found" << endl;
-        return true;
+        foundIt = (elem->pathLen == entryStrLen);
     }
     else
     {
-        CERR_STIL_DEBUG << "pos2Entry() entry not found" << endl;
-        return false;
+        // To be compatible with older versions of STIL, which may have
+        // the tune designation on the first line of a STIL entry
+        // together with the pathname.
+        foundIt = (elem->pathLen >= entryStrLen);
     }
-}
-
-void
-STIL::readEntry(ifstream &inFile, string &buffer)
-{
-    string line;
 
-    for (;;)
+    if (!foundIt || (memcmp(data + elem->offset, entryStr, entryStrLen) != 0))
     {
-        getStilLine(inFile, line);
-
-        if (line.size() == 0)
-            break;
-
-        buffer.append(line);
-        buffer.append("\n");
+        CERR_STIL_DEBUG << "findEntry() entry not found" << endl;
+        return nullptr;
     }
+
+    CERR_STIL_DEBUG << "findEntry() entry found" << endl;
+    return &(*elem);
 }
 
 bool
-STIL::getField(string &result, const char *buffer, int tuneNo, STILField field)
+STIL::getField(const char *&result, const char *&resultEnd,
+               const char *start, const char *end, int tuneNo, STILField field) const
 {
-    CERR_STIL_DEBUG << "getField() called, buffer=" << buffer << ", rest=" << tuneNo << "," << field << endl;
-
-    // Clean out the result buffer first.
-    result.clear();
-
-    // Position pointer to the first char beyond the file designation.
-
-    const char *start = strchr(buffer, '\n') + 1;
+    CERR_STIL_DEBUG << "getField() called, rest=" << tuneNo << "," << field << endl;
 
     // Check whether this is a NULL entry or not.
 
-    if (*start == '\0')
+    if (start == end)
     {
         CERR_STIL_DEBUG << "getField() null entry" << endl;
         return false;
     }
 
     // Is this a multitune entry?
-    const char *firstTuneNo = strstr(start, "(#");
+    const char *firstTuneNo = findStr(start, end, "(#");
 
     // This is a tune designation only if the previous char was
     // a newline (ie. if the "(#" is on the beginning of a line).
@@ -885,25 +823,25 @@ STIL::getField(string &result, const char *buffer, int tuneNo, STILField field)
 
         // Is the first thing in this STIL entry the COMMENT?
 
-        const char *temp = strstr(start, _COMMENT_STR);
+        const char *temp = findStr(start, end, _COMMENT_STR);
         const char *temp2 = nullptr;
 
         // Search for other potential fields beyond the COMMENT.
         if (temp == start)
         {
-            temp2 = strstr(start, _NAME_STR);
+            temp2 = findStr(start, end, _NAME_STR);
 
             if (temp2 == nullptr)
             {
-                temp2 = strstr(start, _AUTHOR_STR);
+                temp2 = findStr(start, end, _AUTHOR_STR);
 
                 if (temp2 == nullptr)
                 {
-                    temp2 = strstr(start, _TITLE_STR);
+                    temp2 = findStr(start, end, _TITLE_STR);
 
                     if (temp2 == nullptr)
                     {
-                        temp2 = strstr(start, _ARTIST_STR);
+                        temp2 = findStr(start, end, _ARTIST_STR);
                     }
                 }
             }
@@ -917,17 +855,17 @@ STIL::getField(string &result, const char *buffer, int tuneNo, STILField field)
 
             if ((tuneNo == 0) && ((field == all) || ((field == comment) && (temp2 == nullptr))))
             {
-                // Simply copy the stuff in.
-                result.append(start);
-                CERR_STIL_DEBUG << "getField() copied to resultbuf" << endl;
+                // Simply return the whole stuff.
+                result = start;
+                resultEnd = end;
                 return true;
             }
 
             else if ((tuneNo == 0) && (field == comment))
             {
-                // Copy just the comment.
-                result.append(start, temp2 - start);
-                CERR_STIL_DEBUG << "getField() copied to just the COMMENT to resultbuf" << endl;
+                // Return just the comment.
+                result = start;
+                resultEnd = temp2;
                 return true;
             }
 
@@ -935,8 +873,8 @@ STIL::getField(string &result, const char *buffer, int tuneNo, STILField field)
             {
                 // A specific field was asked for.
 
-                CERR_STIL_DEBUG << "getField() copying COMMENT to resultbuf" << endl;
-                return getOneField(result, temp2, temp2 + strlen(temp2), field);
+                CERR_STIL_DEBUG << "getField() looking up field" << endl;
+                return getOneField(result, resultEnd, temp2, end, field);
             }
 
             else
@@ -955,9 +893,9 @@ STIL::getField(string &result, const char *buffer, int tuneNo, STILField field)
 
             if ((field == all) && ((tuneNo == 0) || (tuneNo == 1)))
             {
-                // The complete entry was asked for. Simply copy the stuff in.
-                result.append(start);
-                CERR_STIL_DEBUG << "getField() copied to resultbuf" << endl;
+                // The complete entry was asked for.
+                result = start;
+                resultEnd = end;
                 return true;
             }
 
@@ -965,8 +903,8 @@ STIL::getField(string &result, const char *buffer, int tuneNo, STILField field)
             {
                 // A specific field was asked for.
 
-                CERR_STIL_DEBUG << "getField() copying COMMENT to resultbuf" << endl;
-                return getOneField(result, start, start + strlen(start), field);
+                CERR_STIL_DEBUG << "getField() looking up field" << endl;
+                return getOneField(result, resultEnd, start, end, field);
             }
 
             else
@@ -993,9 +931,9 @@ STIL::getField(string &result, const char *buffer, int tuneNo, STILField field)
             switch (field)
             {
             case all:
-                // Yes. Simply copy the stuff in.
-                result.append(start);
-                CERR_STIL_DEBUG << "getField() copied all to resultbuf" << endl;
+                // Yes. Simply return the whole stuff.
+                result = start;
+                resultEnd = end;
                 return true;
 
             case comment:
@@ -1003,8 +941,8 @@ STIL::getField(string &result, const char *buffer, int tuneNo, STILField field)
 
                 if (firstTuneNo != start)
                 {
-                    CERR_STIL_DEBUG << "getField() copying file-global comment to resultbuf" << endl;
-                    return getOneField(result, start, firstTuneNo, comment);
+                    CERR_STIL_DEBUG << "getField() looking up file-global comment" << endl;
+                    return getOneField(result, resultEnd, start, firstTuneNo, comment);
                 }
                 else
                 {
@@ -1029,22 +967,23 @@ STIL::getField(string &result, const char *buffer, int tuneNo, STILField field)
 
         snprintf(tuneNoStr, 7, "(#%d)", tuneNo);
         tuneNoStr[7] = '\0';
-        const char *myTuneNo = strstr(start, tuneNoStr);
+        const char *tuneNoBegin = tuneNoStr;
+        const char *myTuneNo = std::search(start, end, tuneNoBegin, tuneNoBegin + strlen(tuneNoStr));
 
-        if (myTuneNo != nullptr)
+        if (myTuneNo != end)
         {
             // We found the requested tune number.
             // Set the pointer beyond it.
-            myTuneNo = strchr(myTuneNo, '\n') + 1;
+            myTuneNo = std::find(myTuneNo, end, '\n') + 1;
 
             // Where is the next one?
 
-            const char *nextTuneNo = strstr(myTuneNo, "\n(#");
+            const char *nextTuneNo = findStr(myTuneNo, end, "\n(#");
 
             if (nextTuneNo == nullptr)
             {
                 // There is no next one - set pointer to end of entry.
-                nextTuneNo = start + strlen(start);
+                nextTuneNo = end;
             }
             else
             {
@@ -1052,10 +991,9 @@ STIL::getField(string &result, const char *buffer, int tuneNo, STILField field)
                 nextTuneNo++;
             }
 
-            // Put the desired fields into the result (which may be 'all').
+            // Return the desired fields (which may be 'all').
 
-            CERR_STIL_DEBUG << "getField() myTuneNo=" << myTuneNo << ", nextTuneNo=" << nextTuneNo << endl;
-            return getOneField(result, myTuneNo, nextTuneNo, field);
+            return getOneField(result, resultEnd, myTuneNo, nextTuneNo, field);
         }
 
         else
@@ -1067,7 +1005,8 @@ STIL::getField(string &result, const char *buffer, int tuneNo, STILField field)
 }
 
 bool
-STIL::getOneField(string &result, const char *start, const char *end, STILField field)
+STIL::getOneField(const char *&result, const char *&resultEnd,
+                  const char *start, const char *end, STILField field) const
 {
     // Sanity checking
 
@@ -1077,44 +1016,45 @@ STIL::getOneField(string &result, const char *start, const char *end, STILField
         return false;
     }
 
-    CERR_STIL_DEBUG << "getOneField() called, start=" << start << ", rest=" << field << endl;
+    CERR_STIL_DEBUG << "getOneField() called, rest=" << field << endl;
 
     const char *temp = nullptr;
 
     switch (field)
     {
     case all:
-        result.append(start, end - start);
+        result = start;
+        resultEnd = end;
         return true;
 
     case name:
-        temp = strstr(start, _NAME_STR);
+        temp = findStr(start, end, _NAME_STR);
         break;
 
     case author:
-        temp = strstr(start, _AUTHOR_STR);
+        temp = findStr(start, end, _AUTHOR_STR);
         break;
 
     case title:
-        temp = strstr(start, _TITLE_STR);
+        temp = findStr(start, end, _TITLE_STR);
         break;
 
     case artist:
-        temp = strstr(start, _ARTIST_STR);
+        temp = findStr(start, end, _ARTIST_STR);
         break;
 
     case comment:
-        temp = strstr(start, _COMMENT_STR);
+        temp = findStr(start, end, _COMMENT_STR);
         break;
 
     default:
         break;
     }
 
-    // If the field was not found or it is not in between 'start'
-    // and 'end', it is declared a failure.
+    // If the field was not found between 'start' and 'end',
+    // it is declared a failure.
 
-    if ((temp == nullptr) || (temp < start) || (temp > end))
+    if (temp == nullptr)
     {
         return false;
     }
@@ -1122,106 +1062,30 @@ STIL::getOneField(string &result, const char *start, const char *end, STILField
     // Search for the end of this field. This is done by finding
     // where the next field starts.
 
-    const char *nextName = strstr(temp + 1, _NAME_STR);
-    const char *nextAuthor = strstr(temp + 1, _AUTHOR_STR);
-    const char *nextTitle = strstr(temp + 1, _TITLE_STR);
-    const char *nextArtist = strstr(temp + 1, _ARTIST_STR);
-    const char *nextComment = strstr(temp + 1, _COMMENT_STR);
+    const char *nextField = end;
 
-    // If any of these fields is beyond 'end', they are ignored.
-
-    if ((nextName != nullptr) && (nextName >= end))
+    const char *fields[] =
     {
-        nextName = nullptr;
-    }
+        findStr(temp + 1, end, _NAME_STR),
+        findStr(temp + 1, end, _AUTHOR_STR),
+        findStr(temp + 1, end, _TITLE_STR),
+        findStr(temp + 1, end, _ARTIST_STR),
+        findStr(temp + 1, end, _COMMENT_STR)
+    };
 
-    if ((nextAuthor != nullptr) && (nextAuthor >= end))
-    {
-        nextAuthor = nullptr;
-    }
+    // The closest one will mark the end of the required field.
 
-    if ((nextTitle != nullptr) && (nextTitle >= end))
+    for (const char *next : fields)
     {
-        nextTitle = nullptr;
-    }
-
-    if ((nextArtist != nullptr) && (nextArtist >= end))
-    {
-        nextArtist = nullptr;
-    }
-
-    if ((nextComment != nullptr) && (nextComment >= end))
-    {
-        nextComment = nullptr;
-    }
-
-    // Now determine which one is the closest to our field - that one
-    // will mark the end of the required field.
-
-    const char *nextField = nextName;
-
-    if (nextField == nullptr)
-    {
-        nextField = nextAuthor;
-    }
-    else if ((nextAuthor != nullptr) && (nextAuthor < nextField))
-    {
-        nextField = nextAuthor;
-    }
-
-    if (nextField == nullptr)
-    {
-        nextField = nextTitle;
-    }
-    else if ((nextTitle != nullptr) && (nextTitle < nextField))
-    {
-        nextField = nextTitle;
-    }
-
-    if (nextField == nullptr)
-    {
-        nextField = nextArtist;
-    }
-    else if ((nextArtist != nullptr) && (nextArtist < nextField))
-    {
-        nextField = nextArtist;
-    }
-
-    if (nextField == nullptr)
-    {
-        nextField = nextComment;
-    }
-    else if ((nextComment != nullptr) && (nextComment < nextField))
-    {
-        nextField = nextComment;
-    }
-
-    if (nextField == nullptr)
-    {
-        nextField = end;
-    }
-
-    // Now nextField points to the last+1 char that should be copied to
-    // result. Do that.
-
-    result.append(temp, nextField - temp);
-    return true;
-}
-
-void
-STIL::getStilLine(ifstream &infile, string &line)
-{
-    if (STIL_EOL2 != '\0')
-    {
-        // If there was a remaining EOL char from the previous read, eat it up.
-
-        char temp = infile.peek();
-
-        if ((temp == 0x0d) || (temp == 0x0a))
+        if ((next != nullptr) && (next < nextField))
         {
-            infile.get(temp);
+            nextField = next;
         }
     }
 
-    getline(infile, line, STIL_EOL);
+    // Now nextField points to the last+1 char of the field.
+
+    result = temp;
+    resultEnd = nextField;
+    return true;
 }
@@ -23,10 +23,12 @@
 #ifndef STIL_H
 #define STIL_H
 
+#include <stdint.h>
+
+#include <cstddef>
 #include <string>
 #include <algorithm>
-#include <map>
-#include <iosfwd>
+#include <vector>
 
 #include "stildefs.h"
 
@@ -40,6 +42,11 @@
  * Given the location of HVSC this class can extract STIL information for a
  * given tune of a given SID file. (Sounds simple, huh?)
  *
+ * STIL.txt and BUGlist.txt are read and indexed once by setBaseDir().
+ * The const lookup methods only read the index and return pointers
+ * into the loaded text, so they can be called concurrently
+ * as long as setBaseDir() is not running at the same time.
+ *
  * PLEASE, READ THE ACCOMPANYING README.TXT FILE BEFORE PROCEEDING!!!!
  */
 class STIL_EXTERN STIL
@@ -182,6 +189,19 @@ public:
      */
     const char *getAbsEntry(const char *absPathToEntry, int tuneNo = 0, STILField field = all);
 
+    /**
+     * Same as #getEntry, but returns a pointer into the loaded
+     * STIL text instead of copying the result.
+     * Does not allocate and is thread safe.
+     *
+     * @param length receives the length of the text, which
+     *               is not zero terminated
+     * @param error  where to store the error, may be nullptr
+     * @return pointer to the STIL entry, nullptr if not found
+     */
+    const char *getEntry(const char *relPathToEntry, int tuneNo, STILField field,
+                         size_t &length, STILerror *error) const;
+
     /**
      * Given an HVSC pathname and tune number it returns a
      * formatted string that contains the section-global
@@ -206,6 +226,19 @@ public:
      */
     const char *getAbsGlobalComment(const char *absPathToEntry);
 
+    /**
+     * Same as #getGlobalComment, but returns a pointer into
+     * the loaded STIL text instead of copying the result.
+     * Does not allocate and is thread safe.
+     *
+     * @param length receives the length of the text, which
+     *               is not zero terminated
+     * @param error  where to store the error, may be nullptr
+     * @return pointer to the section-global comment, nullptr if not found
+     */
+    const char *getGlobalComment(const char *relPathToEntry,
+                                 size_t &length, STILerror *error) const;
+
     /**
      * Given an HVSC pathname and tune number it returns a
      * formatted string that contains the BUG entry for the
@@ -236,6 +269,19 @@ public:
      */
     const char *getAbsBug(const char *absPathToEntry, int tuneNo = 0);
 
+    /**
+     * Same as #getBug, but returns a pointer into the loaded
+     * BUGlist text instead of copying the result.
+     * Does not allocate and is thread safe.
+     *
+     * @param length receives the length of the text, which
+     *               is not zero terminated
+     * @param error  where to store the error, may be nullptr
+     * @return pointer to the BUG entry, nullptr if not found
+     */
+    const char *getBug(const char *relPathToEntry, int tuneNo,
+                       size_t &length, STILerror *error) const;
+
     /**
      * Returns a specific error number identifying the problem
      * that happened at the last invoked public method.
@@ -268,7 +314,20 @@ public:
     inline const char *getErrorStr() const {return (STIL_ERROR_STR[lastError]);}
 
 private:
-    typedef std::map<std::string, std::streampos> dirList;
+    /// An entry of STIL.txt or BUGlist.txt.
+    struct entry_t
+    {
+        /// Offset of the pathname line
+        uint32_t offset;
+
+        /// Length of the pathname line
+        uint32_t pathLen;
+
+        /// Offset of the last+1 char of the entry
+        uint32_t end;
+    };
+
+    typedef std::vector<entry_t> entryList;
 
     /// Path to STIL.
     const char *PATH_TO_STIL;
@@ -285,18 +344,17 @@ private:
     /// Base dir
     std::string baseDir;
 
-    /// Maps of sections (subdirs) for easier positioning.
+    /// Contents of the files, with the line delimiters converted to '\n'.
     //@{
-    dirList stilDirs;
-    dirList bugDirs;
+    std::string stilText;
+    std::string bugText;
     //@}
 
-    /**
-     * This tells us what the line delimiter is in STIL.txt.
-     * (It may be two chars!)
-     */
-    char STIL_EOL;
-    char STIL_EOL2;
+    /// Entries of the files sorted by pathname.
+    //@{
+    entryList stilEntries;
+    entryList bugEntries;
+    //@}
 
     /// Error number of the last error that happened.
     STILerror lastError;
@@ -306,17 +364,9 @@ private:
 
     ////////////////
 
-    /// The last retrieved entry
-    std::string entrybuf;
-
-    /// The last retrieved section-global comment
-    std::string globalbuf;
-
-    /// The last retrieved BUGentry
-    std::string bugbuf;
-
     /// Buffers to hold the resulting strings
     std::string resultEntry;
+    std::string resultGlobal;
     std::string resultBug;
 
     ////////////////
@@ -324,97 +374,78 @@ private:
     void setVersionString();
 
     /**
-     * Determines what the EOL char is (or are) from STIL.txt.
-     * It is assumed that BUGlist.txt will use the same EOL.
+     * Reads 'fileName' into 'text', converting the line delimiters
+     * to '\n'. The EOL char(s) are determined from the first line
+     * ending found in the file.
      *
+     * @param fileName - the file to read
+     * @param text     - where to put the contents to
      * @return
-     *      - false - something went wrong
+     *      - false - the file could not be read or no EOL was found
      *      - true  - everything is okay
      */
-    bool determineEOL(std::ifstream &stilFile);
+    static bool readFile(const std::string &fileName, std::string &text);
 
     /**
-     * Populates the given dirList array with the directories
-     * obtained from 'inFile' for faster positioning within
-     * 'inFile'.
+     * Populates the given entry list with the entries found in 'text'
+     * and sorts them by pathname.
      *
-     * @param inFile - where to read the directories from
-     * @param dirs   - the dirList array that should be populated with the
-     *                 directory list
+     * @param text       - the text to index
+     * @param entries    - the list to populate
      * @param isSTILFile - is this the STIL or the BUGlist we are parsing
      * @return
-     *      - false - No entries were found or otherwise failed to process
-     *                inFile
+     *      - false - No entries were found
      *      - true  - everything is okay
      */
-    bool getDirs(std::ifstream &inFile, dirList &dirs, bool isSTILFile);
+    bool getEntries(const std::string &text, entryList &entries, bool isSTILFile);
 
     /**
-     * Positions the file pointer to the given entry in 'inFile'
-     * using the 'dirs' dirList for faster positioning.
+     * Finds the given entry in 'entries'.
      *
-     * @param entryStr - the entry to position to
-     * @param inFile   - position the file pointer in this file
-     * @param dirs     - the list of dirs in inFile for easier positioning
+     * @param entryStr - the entry to look for
+     * @param text     - the text 'entries' refer to
+     * @param entries  - the sorted list of entries of 'text'
      * @return
-     *      - true - if successful
-     *      - false - otherwise
+     *      - pointer to the entry - if successful
+     *      - nullptr - otherwise
      */
-    bool positionToEntry(const char *entryStr, std::ifstream &inFile, dirList &dirs);
+    const entry_t *findEntry(const char *entryStr, const std::string &text, const entryList &entries) const;
 
     /**
-     * Reads the entry from 'inFile' into 'buffer'. 'inFile' should
-     * already be positioned to the entry to be read.
+     * Given the body of a STIL formatted entry between 'start'
+     * and 'end', a tune number, and a field designation, it
+     * returns the bounds of the requested STIL field.
+     * If field=all, it also includes the file-global comment
+     * (if it exists) as the first field.
      *
-     * @param inFile   - filehandle of file to read from
-     * @param entryStr - the entry needed to be read
-     * @param buffer   - where to put the result to
-     */
-    void readEntry(std::ifstream &inFile, std::string &buffer);
-
-    /**
-     * Given a STIL formatted entry in 'buffer', a tune number,
-     * and a field designation, it returns the requested
-     * STIL field into 'result'.
-     * If field=all, it also puts the file-global comment (if it exists)
-     * as the first field into 'result'.
-     *
-     * @param result - where to put the resulting string to (if any)
-     * @param buffer - pointer to the first char of what to search for
-     *                 the field. Should be a buffer in standard STIL
-     *                 format.
-     * @param tuneNo - song number within the song (default=0)
-     * @param field  - which field to retrieve (default=all).
+     * @param result    - where to put the first char of the field to
+     * @param resultEnd - where to put the last+1 char of the field to
+     * @param start     - pointer to the first char of the entry body
+     * @param end       - pointer to the last+1 char of the entry body
+     * @param tuneNo    - song number within the song (default=0)
+     * @param field     - which field to retrieve (default=all).
      * @return
-     *      - false - if nothing was put into 'result'
+     *      - false - if the field was not found
      *      - true  - 'result' has the resulting field
      */
-    bool getField(std::string &result, const char *buffer, int tuneNo = 0, STILField field = all);
+    bool getField(const char *&result, const char *&resultEnd,
+                  const char *start, const char *end, int tuneNo = 0, STILField field = all) const;
 
     /**
-     * @param result - where to put the resulting string to (if any)
-     * @param start  - pointer to the first char of what to search for
-     *                 the field. Should be a buffer in standard STIL
-     *                 format.
-     * @param end    - pointer to the last+1 char of what to search for
-     *                 the field. ('end-1' should be a '\n'!)
-     * @param field  - which specific field to retrieve
+     * @param result    - where to put the first char of the field to
+     * @param resultEnd - where to put the last+1 char of the field to
+     * @param start     - pointer to the first char of what to search for
+     *                    the field. Should be a buffer in standard STIL
+     *                    format.
+     * @param end       - pointer to the last+1 char of what to search for
+     *                    the field. ('end-1' should be a '\n'!)
+     * @param field     - which specific field to retrieve
      * @return
-     *      - false - if nothing was put into 'result'
+     *      - false - if the field was not found
      *      - true  - 'result' has the resulting field
      */
-    bool getOneField(std::string &result, const char *start, const char *end, STILField field);
-
-    /**
-     * Extracts one line from 'infile' to 'line[]'. The end of
-     * the line is marked by endOfLineChar. Also eats up
-     * additional EOL-like chars.
-     *
-     * @param infile - filehandle (streampos should already be positioned
-     *                 to the start of the desired line)
-     * @param line   - char array to put the line into
-     */
-    void getStilLine(std::ifstream &infile, std::string &line);
+    bool getOneField(const char *&result, const char *&resultEnd,
+                     const char *start, const char *end, STILField field) const;
 };
 
 #endif // STIL_H
@@ -0,0 +1,130 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "SidArchive.h"
+
+#include <cstring>
+
+#include "packedArchive.h"
+#include "sidtune/SidTuneBase.h"
+
+#include "sidcxx11.h"
+
+const char ERR_NO_ARCHIVE_LOADED[]      = "SID ARCHIVE ERROR: Archive not loaded.";
+const char ERR_UNABLE_TO_LOAD_ARCHIVE[] = "SID ARCHIVE ERROR: Unable to load the archive.";
+
+namespace
+{
+
+thread_local const SidArchive* currentArchive = nullptr;
+
+}
+
+SidArchive::SidArchive() :
+    m_archive(nullptr),
+    errorString(ERR_NO_ARCHIVE_LOADED)
+{}
+
+SidArchive::~SidArchive()
+{
+    delete m_archive;
+}
+
+bool SidArchive::open(const char *filename)
+{
+    delete m_archive;
+    m_archive = new libsidplayfp::packedArchive();
+
+    if (!m_archive->open(filename))
+    {
+        close();
+        errorString = ERR_UNABLE_TO_LOAD_ARCHIVE;
+        return false;
+    }
+
+    return true;
+}
+
+void SidArchive::close()
+{
+    delete m_archive;
+    m_archive = nullptr;
+}
+
+unsigned int SidArchive::entries() const
+{
+    return m_archive != nullptr ? m_archive->size() : 0;
+}
+
+const char *SidArchive::entryName(unsigned int i) const
+{
+    return i < entries() ? m_archive->name(i) : nullptr;
+}
+
+const uint_least8_t *SidArchive::data(const char *path, uint_least32_t &size) const
+{
+    const int i = m_archive != nullptr ? m_archive->find(path) : -1;
+    if (i < 0)
+    {
+        size = 0;
+        return nullptr;
+    }
+
+    size = m_archive->dataSize(i);
+    return m_archive->data(i);
+}
+
+bool SidArchive::read(const char *path, std::vector<uint8_t> &buffer) const
+{
+    uint_least32_t size;
+    const uint_least8_t* content = data(path, size);
+    if (content == nullptr)
+        return false;
+
+    buffer.assign(content, content + size);
+    return true;
+}
+
+const char *SidArchive::md5(const char *path, char *md5) const
+{
+    const int i = m_archive != nullptr ? m_archive->find(path) : -1;
+    if (i < 0)
+        return nullptr;
+
+    std::memcpy(md5, m_archive->md5(i), libsidplayfp::packedArchive::MD5_LENGTH);
+    md5[libsidplayfp::packedArchive::MD5_LENGTH] = '\0';
+    return md5;
+}
+
+void SidArchive::setCurrent(const SidArchive *archive)
+{
+    currentArchive = archive;
+}
+
+void SidArchive::loader(const char *path, std::vector<uint8_t> &buffer)
+{
+    if ((currentArchive == nullptr) || !currentArchive->read(path, buffer))
+        throw libsidplayfp::loadError(libsidplayfp::SidTuneBase::ERR_CANT_OPEN_FILE);
+}
+
+bool SidArchive::build(const char *filename, const char *baseDir, const std::vector<std::string> &paths)
+{
+    return libsidplayfp::packedArchive::build(filename, baseDir, paths);
+}
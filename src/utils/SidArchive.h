@@ -0,0 +1,148 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SIDARCHIVE_H
+#define SIDARCHIVE_H
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "sidplayfp/siddefs.h"
+
+namespace libsidplayfp
+{
+class packedArchive;
+}
+
+/**
+ * SidArchive
+ * A whole collection of tunes packed into a single file,
+ * with a sorted index of the paths and the MD5 of each file.
+ *
+ * Scanning a collection from an archive takes a single open
+ * instead of one, plus the probing of companion files, per tune.
+ * Entries are stored in index order so iterating over them
+ * reads the file sequentially.
+ *
+ * Lookups don't modify the archive, so an open instance
+ * can serve several threads.
+ * Opening and closing must not overlap with lookups.
+ *
+ * @since 2.13
+ */
+class SID_EXTERN SidArchive
+{
+private:
+    libsidplayfp::packedArchive* m_archive;
+
+    const char *errorString;
+
+public:
+    SidArchive();
+    ~SidArchive();
+
+    /**
+     * Open an archive.
+     *
+     * @param filename the archive file name with full path.
+     * @return false in case of errors, true otherwise.
+     */
+    bool open(const char *filename);
+
+    /**
+     * Close the archive.
+     */
+    void close();
+
+    /**
+     * Get the number of entries.
+     */
+    unsigned int entries() const;
+
+    /**
+     * Get the path of an entry, in index order.
+     *
+     * @param i the entry, from 0 to entries() - 1
+     */
+    const char *entryName(unsigned int i) const;
+
+    /**
+     * Get the content of a file without copying it.
+     * The data stays valid until the archive is closed,
+     * and can be passed to SidTune::borrow.
+     *
+     * @param path the path of the file inside the archive
+     * @param size where to store the size of the data
+     * @return the data, nullptr if the file is missing
+     */
+    const uint_least8_t *data(const char *path, uint_least32_t &size) const;
+
+    /**
+     * Copy the content of a file.
+     *
+     * @param path the path of the file inside the archive
+     * @param buffer where to store the data
+     * @return false if the file is missing
+     */
+    bool read(const char *path, std::vector<uint8_t> &buffer) const;
+
+    /**
+     * Get the precomputed MD5 of a file, matching
+     * SidTune::createMD5New for tunes.
+     *
+     * @param path the path of the file inside the archive
+     * @param md5 buffer of at least SidTune::MD5_LENGTH + 1 chars
+     * @return md5, nullptr if the file is missing
+     */
+    const char *md5(const char *path, char *md5) const;
+
+    /**
+     * Select the archive used by #loader in the calling thread.
+     *
+     * @param archive the archive, nullptr to deselect it
+     */
+    static void setCurrent(const SidArchive *archive);
+
+    /**
+     * A SidTune::LoaderFunc reading from the current archive.
+     * Missing files fail to load with the same error as
+     * the filesystem loader.
+     */
+    static void loader(const char *path, std::vector<uint8_t> &buffer);
+
+    /**
+     * Pack files into a new archive.
+     *
+     * @param filename the archive to create
+     * @param baseDir the directory the paths are relative to
+     * @param paths the files to pack, they will be looked up by these names
+     * @return false if a file can't be read or the archive can't be written
+     */
+    static bool build(const char *filename, const char *baseDir, const std::vector<std::string> &paths);
+
+    /**
+     * Get descriptive error message.
+     */
+    const char *error() const { return errorString; }
+};
+
+#endif // SIDARCHIVE_H
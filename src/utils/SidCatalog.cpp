@@ -0,0 +1,172 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "SidCatalog.h"
+
+#include <list>
+
+#include "sidplayfp/SidTune.h"
+
+#include "catalogIndex.h"
+
+#include "sidcxx11.h"
+
+const char ERR_NO_CATALOG_LOADED[]      = "SID CATALOG ERROR: Catalog not loaded.";
+const char ERR_UNABLE_TO_LOAD_CATALOG[] = "SID CATALOG ERROR: Unable to load the catalog.";
+
+SidCatalog::SidCatalog() :
+    m_index(nullptr),
+    errorString(ERR_NO_CATALOG_LOADED)
+{}
+
+SidCatalog::~SidCatalog()
+{
+    delete m_index;
+}
+
+bool SidCatalog::open(const char *filename)
+{
+    delete m_index;
+    m_index = new libsidplayfp::catalogIndex();
+
+    if (!m_index->open(filename))
+    {
+        close();
+        errorString = ERR_UNABLE_TO_LOAD_CATALOG;
+        return false;
+    }
+
+    return true;
+}
+
+void SidCatalog::close()
+{
+    delete m_index;
+    m_index = nullptr;
+}
+
+unsigned int SidCatalog::entries() const
+{
+    return m_index != nullptr ? m_index->size() : 0;
+}
+
+bool SidCatalog::get(int i, Entry &entry) const
+{
+    if (i < 0)
+        return false;
+
+    libsidplayfp::catalogIndex::record_t record;
+    m_index->get(i, record);
+
+    entry.path          = record.path;
+    entry.md5           = record.md5;
+    entry.title         = record.title;
+    entry.author        = record.author;
+    entry.released      = record.released;
+    entry.format        = record.format;
+    entry.dataFileLen   = record.dataFileLen;
+    entry.songs         = record.songs;
+    entry.startSong     = record.startSong;
+    entry.loadAddr      = record.loadAddr;
+    entry.initAddr      = record.initAddr;
+    entry.playAddr      = record.playAddr;
+    entry.clockSpeed    = static_cast<SidTuneInfo::clock_t>(record.clockSpeed);
+    entry.compatibility = static_cast<SidTuneInfo::compatibility_t>(record.compatibility);
+    entry.sidChips      = record.sidChips;
+    for (unsigned int s = 0; s < MAX_SIDS; s++)
+    {
+        entry.sidModel[s]    = static_cast<SidTuneInfo::model_t>(record.sidModel[s]);
+        entry.sidChipBase[s] = record.sidChipBase[s];
+    }
+
+    return true;
+}
+
+bool SidCatalog::entry(unsigned int i, Entry &entry) const
+{
+    return i < entries() ? get(i, entry) : false;
+}
+
+bool SidCatalog::find(const char *path, Entry &entry) const
+{
+    return m_index != nullptr ? get(m_index->find(path), entry) : false;
+}
+
+bool SidCatalog::findMD5(const char *md5, Entry &entry) const
+{
+    return m_index != nullptr ? get(m_index->findMD5(md5), entry) : false;
+}
+
+bool SidCatalog::build(const char *filename, const char *baseDir, const std::vector<std::string> &paths)
+{
+    // Owns the strings referenced by the records
+    std::list<std::string> strings;
+    auto keep = [&strings](const char* str) -> const char*
+    {
+        strings.emplace_back(str != nullptr ? str : "");
+        return strings.back().c_str();
+    };
+
+    std::vector<libsidplayfp::catalogIndex::record_t> records;
+    records.reserve(paths.size());
+
+    std::string fileName(baseDir);
+    if (!fileName.empty() && (fileName.back() != '/'))
+        fileName.push_back('/');
+    const size_t baseLen = fileName.size();
+
+    SidTune tune(nullptr);
+    for (const std::string &path : paths)
+    {
+        fileName.replace(baseLen, std::string::npos, path);
+        tune.loadMapped(fileName.c_str());
+        if (!tune.getStatus())
+            continue;
+
+        char md5[SidTune::MD5_LENGTH + 1];
+        const SidTuneInfo* info = tune.getInfo();
+
+        libsidplayfp::catalogIndex::record_t record;
+        record.path          = keep(path.c_str());
+        record.md5           = keep(tune.createMD5New(md5));
+        record.title         = keep(info->numberOfInfoStrings() > 0 ? info->infoString(0) : nullptr);
+        record.author        = keep(info->numberOfInfoStrings() > 1 ? info->infoString(1) : nullptr);
+        record.released      = keep(info->numberOfInfoStrings() > 2 ? info->infoString(2) : nullptr);
+        record.format        = keep(info->formatString());
+        record.dataFileLen   = info->dataFileLen();
+        record.songs         = info->songs();
+        record.startSong     = info->startSong();
+        record.loadAddr      = info->loadAddr();
+        record.initAddr      = info->initAddr();
+        record.playAddr      = info->playAddr();
+        record.clockSpeed    = info->clockSpeed();
+        record.compatibility = info->compatibility();
+        record.sidChips      = info->sidChips();
+        for (unsigned int s = 0; s < MAX_SIDS; s++)
+        {
+            record.sidModel[s]    = info->sidModel(s);
+            record.sidChipBase[s] = info->sidChipBase(s);
+        }
+
+        records.push_back(record);
+    }
+
+    return libsidplayfp::catalogIndex::build(filename, records);
+}
@@ -0,0 +1,157 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SIDCATALOG_H
+#define SIDCATALOG_H
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "sidplayfp/siddefs.h"
+#include "sidplayfp/SidTuneInfo.h"
+
+namespace libsidplayfp
+{
+class catalogIndex;
+}
+
+/**
+ * SidCatalog
+ * A precomputed index of the tune informations of a collection,
+ * for browsing and searching without loading the tunes.
+ *
+ * Entries are sorted by path and can be looked up by path
+ * or by the MD5 of the file (new method).
+ *
+ * Lookups don't modify the catalogue, so an open instance
+ * can serve several threads.
+ * Opening and closing must not overlap with lookups.
+ *
+ * @since 2.13
+ */
+class SID_EXTERN SidCatalog
+{
+public:
+    /// Number of SID chips described by an entry
+    static const unsigned int MAX_SIDS = 3;
+
+    /**
+     * The informations of a tune as reported by SidTuneInfo.
+     * Strings stay valid until the catalogue is closed.
+     */
+    struct Entry
+    {
+        const char *path;
+        const char *md5;                 ///< New method MD5
+        const char *title;
+        const char *author;
+        const char *released;
+        const char *format;
+        uint_least32_t dataFileLen;
+        unsigned int songs;
+        unsigned int startSong;
+        uint_least16_t loadAddr;
+        uint_least16_t initAddr;
+        uint_least16_t playAddr;
+        SidTuneInfo::clock_t clockSpeed;
+        SidTuneInfo::compatibility_t compatibility;
+        unsigned int sidChips;
+        SidTuneInfo::model_t sidModel[MAX_SIDS];
+        uint_least16_t sidChipBase[MAX_SIDS];
+    };
+
+private:
+    libsidplayfp::catalogIndex* m_index;
+
+    const char *errorString;
+
+private:
+    bool get(int i, Entry &entry) const;
+
+public:
+    SidCatalog();
+    ~SidCatalog();
+
+    /**
+     * Open a catalogue.
+     *
+     * @param filename the catalogue file name with full path.
+     * @return false in case of errors, true otherwise.
+     */
+    bool open(const char *filename);
+
+    /**
+     * Close the catalogue.
+     */
+    void close();
+
+    /**
+     * Get the number of entries.
+     */
+    unsigned int entries() const;
+
+    /**
+     * Get an entry, in path order.
+     *
+     * @param i the entry, from 0 to entries() - 1
+     * @param entry where to store the informations
+     * @return false if out of range
+     */
+    bool entry(unsigned int i, Entry &entry) const;
+
+    /**
+     * Find a tune by path.
+     *
+     * @param path the path used when building the catalogue
+     * @param entry where to store the informations
+     * @return false if not found
+     */
+    bool find(const char *path, Entry &entry) const;
+
+    /**
+     * Find a tune by MD5.
+     * If several files share the same content the first one is returned.
+     *
+     * @param md5 the lowercase hex hash as returned by SidTune::createMD5New
+     * @param entry where to store the informations
+     * @return false if not found
+     */
+    bool findMD5(const char *md5, Entry &entry) const;
+
+    /**
+     * Load tunes and write a new catalogue.
+     * Files that don't load as tunes are skipped.
+     *
+     * @param filename the catalogue to create
+     * @param baseDir the directory the paths are relative to
+     * @param paths the tunes to index, they will be looked up by these names
+     * @return false if the catalogue can't be written
+     */
+    static bool build(const char *filename, const char *baseDir, const std::vector<std::string> &paths);
+
+    /**
+     * Get descriptive error message.
+     */
+    const char *error() const { return errorString; }
+};
+
+#endif // SIDCATALOG_H
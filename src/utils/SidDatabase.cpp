@@ -20,15 +20,12 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
-#include <cctype>
-#include <cstdlib>
-
 #include "SidDatabase.h"
 
 #include "sidplayfp/SidTune.h"
 #include "sidplayfp/SidTuneInfo.h"
 
-#include "iniParser.h"
+#include "songlengthIndex.h"
 
 #include "sidcxx11.h"
 
@@ -37,74 +34,22 @@ const char ERR_NO_DATABASE_LOADED[]      = "SID DATABASE ERROR: Songlength datab
 const char ERR_NO_SELECTED_SONG[]        = "SID DATABASE ERROR: No song selected for retrieving song length.";
 const char ERR_UNABLE_TO_LOAD_DATABASE[] = "SID DATABASE ERROR: Unable to load the songlength database.";
 
-class parseError {};
-
 SidDatabase::SidDatabase() :
-    m_parser(nullptr),
+    m_index(nullptr),
     errorString(ERR_NO_DATABASE_LOADED)
 {}
 
 SidDatabase::~SidDatabase()
 {
-    delete m_parser;
-}
-
-// mm:ss[.SSS]
-//
-// Examples of song length values:
-//
-// 1:02
-//
-// 1:02.5
-//
-// 1:02.500
-//
-const char *parseTime(const char *str, int_least32_t &result)
-{
-    char *end;
-    const long minutes = strtol(str, &end, 10);
-
-    if (*end != ':')
-    {
-        throw parseError();
-    }
-
-    end++;
-    const long seconds = strtol(end, &end, 10);
-    result = ((minutes * 60) + seconds) * 1000;
-
-    if (*end == '.')
-    {
-        char *start = end + 1;
-        long milliseconds = strtol(start, &end, 10);
-        switch (end - start)
-        {
-        case 1: milliseconds *= 100; break;
-        case 2: milliseconds *= 10; break;
-        case 3: break;
-        default: throw parseError();
-        }
-        if (milliseconds<0 || milliseconds>=1000)
-            throw parseError();
-
-        result += milliseconds;
-    }
-
-    while ((*end != 0) && !isspace(*end))
-    {
-        end++;
-    }
-
-    return end;
+    delete m_index;
 }
 
-
 bool SidDatabase::open(const char *filename)
 {
-    delete m_parser;
-    m_parser = new libsidplayfp::iniParser();
+    delete m_index;
+    m_index = new libsidplayfp::songlengthIndex();
 
-    if (!m_parser->open(filename))
+    if (!m_index->open(filename))
     {
         close();
         errorString = ERR_UNABLE_TO_LOAD_DATABASE;
@@ -117,10 +62,10 @@ bool SidDatabase::open(const char *filename)
 #ifdef _WIN32
 bool SidDatabase::open(const wchar_t* filename)
 {
-    delete m_parser;
-    m_parser = new libsidplayfp::iniParser();
+    delete m_index;
+    m_index = new libsidplayfp::songlengthIndex();
 
-    if (!m_parser->open(filename))
+    if (!m_index->open(filename))
     {
         close();
         errorString = ERR_UNABLE_TO_LOAD_DATABASE;
@@ -133,8 +78,8 @@ bool SidDatabase::open(const wchar_t* filename)
 
 void SidDatabase::close()
 {
-    delete m_parser;
-    m_parser = nullptr;
+    delete m_index;
+    m_index = nullptr;
 }
 
 int_least32_t SidDatabase::length(SidTune &tune)
@@ -153,18 +98,24 @@ int_least32_t SidDatabase::length(SidTune &tune)
 }
 
 int_least32_t SidDatabase::lengthMs(SidTune &tune)
+{
+    return lengthMs(tune, &errorString);
+}
+
+int_least32_t SidDatabase::lengthMs(SidTune &tune, const char **error) const
 {
     const unsigned int song = tune.getInfo()->currentSong();
 
     if (!song)
     {
-        errorString = ERR_NO_SELECTED_SONG;
+        if (error != nullptr)
+            *error = ERR_NO_SELECTED_SONG;
         return -1;
     }
 
     char md5[SidTune::MD5_LENGTH + 1];
     tune.createMD5New(md5);
-    return lengthMs(md5, song);
+    return lengthMs(md5, song, error);
 }
 
 int_least32_t SidDatabase::length(const char *md5, unsigned int song)
@@ -174,44 +125,27 @@ int_least32_t SidDatabase::length(const char *md5, unsigned int song)
 
 int_least32_t SidDatabase::lengthMs(const char *md5, unsigned int song)
 {
-    if (m_parser == nullptr)
-    {
-        errorString = ERR_NO_DATABASE_LOADED;
-        return -1;
-    }
+    return lengthMs(md5, song, &errorString);
+}
 
-    // Read Time (and check times before hand)
-    if (!m_parser->setSection("Database"))
+int_least32_t SidDatabase::lengthMs(const char *md5, unsigned int song, const char **error) const
+{
+    if (m_index == nullptr)
     {
-        errorString = ERR_DATABASE_CORRUPT;
+        if (error != nullptr)
+            *error = ERR_NO_DATABASE_LOADED;
         return -1;
     }
 
-    const char *timeStamp = m_parser->getValue(md5);
+    const int_least32_t time = m_index->lengthMs(md5, song);
 
-    // If return is null then no entry found in database
-    if (!timeStamp)
+    // No entry found in database or malformed time
+    if (time < 0)
     {
-        errorString = ERR_DATABASE_CORRUPT;
+        if (error != nullptr)
+            *error = ERR_DATABASE_CORRUPT;
         return -1;
     }
 
-    const char *str = timeStamp;
-    int_least32_t time = 0;
-
-    for (unsigned int i = 0; i < song; i++)
-    {
-        // Validate Time
-        try
-        {
-            str = parseTime(str, time);
-        }
-        catch (parseError const &)
-        {
-            errorString = ERR_DATABASE_CORRUPT;
-            return -1;
-        }
-    }
-
     return time;
 }
@@ -31,17 +31,22 @@ class SidTune;
 
 namespace libsidplayfp
 {
-class iniParser;
+class songlengthIndex;
 }
 
 /**
  * SidDatabase
  * An utility class to deal with the songlength DataBase.
+ *
+ * The database is not modified by lookups, so an open instance
+ * can serve several threads through the const methods,
+ * which return the error instead of storing it.
+ * Opening and closing must not overlap with lookups.
  */
 class SID_EXTERN SidDatabase
 {
 private:
-    libsidplayfp::iniParser* m_parser;
+    libsidplayfp::songlengthIndex* m_index;
 
     const char *errorString;
 
@@ -101,6 +106,30 @@ public:
      */
     int_least32_t lengthMs(const char *md5, unsigned int song);
 
+    /**
+     * Get the length of the current subtune.
+     * The hash is based on the full content (new format).
+     * Thread safe.
+     *
+     * @param tune the SID tune
+     * @param error where to store the error message, may be nullptr
+     * @return tune length in milliseconds, -1 in case of errors.
+     * @since 2.13
+     */
+    int_least32_t lengthMs(SidTune &tune, const char **error) const;
+
+    /**
+     * Get the length of the selected subtune.
+     * Thread safe.
+     *
+     * @param md5 the md5 hash of the tune.
+     * @param song the subtune.
+     * @param error where to store the error message, may be nullptr
+     * @return tune length in milliseconds, -1 in case of errors.
+     * @since 2.13
+     */
+    int_least32_t lengthMs(const char *md5, unsigned int song, const char **error) const;
+
     /**
      * Get descriptive error message.
      */
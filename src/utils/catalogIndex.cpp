@@ -0,0 +1,292 @@
+/*
+ *  Copyright (C) 2025 Leandro Nini
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "catalogIndex.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+#include "sidendian.h"
+
+#include "sidcxx11.h"
+
+namespace libsidplayfp
+{
+
+namespace
+{
+
+const char MAGIC[8] = { 'S', 'I', 'D', 'I', 'N', 'F', 'O', 0 };
+
+constexpr uint_least32_t INDEX_VERSION = 1;
+
+constexpr unsigned int HEADER_SIZE = 24;
+
+constexpr unsigned int RECORD_SIZE = 52;
+
+/// Number of string offsets at the start of a record
+constexpr unsigned int RECORD_STRINGS = 6;
+
+}
+
+bool catalogIndex::open(const char* fileName)
+{
+    close();
+
+    if (!file.open(fileName) || !parse())
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+bool catalogIndex::parse()
+{
+    const uint_least8_t* base = file.data();
+    const size_t fileSize = file.size();
+
+    if ((fileSize < HEADER_SIZE)
+        || (std::memcmp(base, MAGIC, sizeof(MAGIC)) != 0)
+        || (endian_little32(base + 8) != INDEX_VERSION))
+        return false;
+
+    const uint_least32_t entries = endian_little32(base + 12);
+    const uint_least32_t stringsSize = endian_little32(base + 16);
+
+    const uint_least64_t stringsOffset = HEADER_SIZE + static_cast<uint_least64_t>(entries) * (RECORD_SIZE + 4);
+    if ((stringsOffset + stringsSize != fileSize)
+        || (stringsSize == 0)
+        || (base[fileSize - 1] != 0))
+        return false;
+
+    count = entries;
+    records = base + HEADER_SIZE;
+    md5Order = records + static_cast<size_t>(entries) * RECORD_SIZE;
+    strings = reinterpret_cast<const char*>(base + stringsOffset);
+
+    // Check everything once so that lookups can trust the data
+    for (uint_least32_t i = 0; i < count; i++)
+    {
+        const uint_least8_t* record = records + i * RECORD_SIZE;
+        for (unsigned int s = 0; s < RECORD_STRINGS; s++)
+        {
+            if (endian_little32(record + s * 4) >= stringsSize)
+                return false;
+        }
+
+        if ((i > 0) && (std::strcmp(path(i - 1), path(i)) >= 0))
+            return false;
+
+        const uint_least32_t n = endian_little32(md5Order + i * 4);
+        if (n >= count)
+            return false;
+    }
+
+    for (uint_least32_t i = 1; i < count; i++)
+    {
+        if (std::strcmp(md5(endian_little32(md5Order + (i - 1) * 4)),
+                        md5(endian_little32(md5Order + i * 4))) > 0)
+            return false;
+    }
+
+    return true;
+}
+
+void catalogIndex::close()
+{
+    count = 0;
+    records = nullptr;
+    md5Order = nullptr;
+    strings = nullptr;
+    file.close();
+}
+
+const char* catalogIndex::path(uint_least32_t i) const
+{
+    return strings + endian_little32(records + i * RECORD_SIZE);
+}
+
+const char* catalogIndex::md5(uint_least32_t i) const
+{
+    return strings + endian_little32(records + i * RECORD_SIZE + 4);
+}
+
+void catalogIndex::get(unsigned int i, record_t& record) const
+{
+    const uint_least8_t* ptr = records + i * RECORD_SIZE;
+
+    record.path          = strings + endian_little32(ptr);
+    record.md5           = strings + endian_little32(ptr + 4);
+    record.title         = strings + endian_little32(ptr + 8);
+    record.author        = strings + endian_little32(ptr + 12);
+    record.released      = strings + endian_little32(ptr + 16);
+    record.format        = strings + endian_little32(ptr + 20);
+    record.dataFileLen   = endian_little32(ptr + 24);
+    record.songs         = endian_little16(ptr + 28);
+    record.startSong     = endian_little16(ptr + 30);
+    record.loadAddr      = endian_little16(ptr + 32);
+    record.initAddr      = endian_little16(ptr + 34);
+    record.playAddr      = endian_little16(ptr + 36);
+    record.clockSpeed    = ptr[38];
+    record.compatibility = ptr[39];
+    record.sidChips      = ptr[40];
+    for (unsigned int s = 0; s < MAX_SIDS; s++)
+    {
+        record.sidModel[s]    = ptr[41 + s];
+        record.sidChipBase[s] = endian_little16(ptr + 44 + s * 2);
+    }
+}
+
+int catalogIndex::find(const char* name) const
+{
+    uint_least32_t lo = 0;
+    uint_least32_t hi = count;
+    while (lo < hi)
+    {
+        const uint_least32_t mid = lo + (hi - lo) / 2;
+        const int cmp = std::strcmp(path(mid), name);
+        if (cmp == 0)
+            return mid;
+        if (cmp < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return -1;
+}
+
+int catalogIndex::findMD5(const char* hash) const
+{
+    // Find the first match, identical files may appear in several places
+    uint_least32_t lo = 0;
+    uint_least32_t hi = count;
+    while (lo < hi)
+    {
+        const uint_least32_t mid = lo + (hi - lo) / 2;
+        if (std::strcmp(md5(endian_little32(md5Order + mid * 4)), hash) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    if (lo == count)
+        return -1;
+
+    const uint_least32_t i = endian_little32(md5Order + lo * 4);
+    return std::strcmp(md5(i), hash) == 0 ? static_cast<int>(i) : -1;
+}
+
+bool catalogIndex::build(const char* fileName, std::vector<record_t> records)
+{
+    std::sort(records.begin(), records.end(),
+        [](const record_t &a, const record_t &b)
+        {
+            return std::strcmp(a.path, b.path) < 0;
+        });
+    records.erase(std::unique(records.begin(), records.end(),
+        [](const record_t &a, const record_t &b)
+        {
+            return std::strcmp(a.path, b.path) == 0;
+        }), records.end());
+
+    // Shared string table, authors and formats repeat a lot
+    std::string table;
+    std::map<std::string, uint_least32_t> offsets;
+    auto intern = [&](const char* str) -> uint_least32_t
+    {
+        auto it = offsets.find(str);
+        if (it != offsets.end())
+            return it->second;
+
+        const uint_least32_t offset = table.size();
+        table.append(str);
+        table.push_back('\0');
+        offsets.emplace(str, offset);
+        return offset;
+    };
+
+    const uint_least32_t entries = records.size();
+    std::vector<uint8_t> data(HEADER_SIZE + entries * (RECORD_SIZE + 4));
+
+    std::memcpy(&data[0], MAGIC, sizeof(MAGIC));
+    endian_little32(&data[8], INDEX_VERSION);
+    endian_little32(&data[12], entries);
+
+    for (uint_least32_t i = 0; i < entries; i++)
+    {
+        const record_t &r = records[i];
+        uint8_t* ptr = &data[HEADER_SIZE + i * RECORD_SIZE];
+
+        endian_little32(ptr,      intern(r.path));
+        endian_little32(ptr + 4,  intern(r.md5));
+        endian_little32(ptr + 8,  intern(r.title));
+        endian_little32(ptr + 12, intern(r.author));
+        endian_little32(ptr + 16, intern(r.released));
+        endian_little32(ptr + 20, intern(r.format));
+        endian_little32(ptr + 24, r.dataFileLen);
+        endian_little16(ptr + 28, r.songs);
+        endian_little16(ptr + 30, r.startSong);
+        endian_little16(ptr + 32, r.loadAddr);
+        endian_little16(ptr + 34, r.initAddr);
+        endian_little16(ptr + 36, r.playAddr);
+        ptr[38] = r.clockSpeed;
+        ptr[39] = r.compatibility;
+        ptr[40] = r.sidChips;
+        for (unsigned int s = 0; s < MAX_SIDS; s++)
+        {
+            ptr[41 + s] = r.sidModel[s];
+            endian_little16(ptr + 44 + s * 2, r.sidChipBase[s]);
+        }
+    }
+
+    std::vector<uint_least32_t> order(entries);
+    for (uint_least32_t i = 0; i < entries; i++)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(),
+        [&records](uint_least32_t a, uint_least32_t b)
+        {
+            return std::strcmp(records[a].md5, records[b].md5) < 0;
+        });
+
+    uint8_t* md5Ptr = &data[HEADER_SIZE + entries * RECORD_SIZE];
+    for (uint_least32_t i = 0; i < entries; i++)
+        endian_little32(md5Ptr + i * 4, order[i]);
+
+    // An empty table would be rejected on open
+    if (table.empty())
+        table.push_back('\0');
+
+    endian_little32(&data[16], table.size());
+
+    std::ofstream out(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (out.fail())
+        return false;
+
+    out.write(reinterpret_cast<const char*>(data.data()), data.size());
+    out.write(table.data(), table.size());
+    out.close();
+
+    return !out.fail();
+}
+
+}
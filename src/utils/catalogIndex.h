@@ -0,0 +1,124 @@
+/*
+ *  Copyright (C) 2025 Leandro Nini
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CATALOGINDEX_H
+#define CATALOGINDEX_H
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "sidtune/mappedFile.h"
+
+namespace libsidplayfp
+{
+
+/**
+ * Binary index of the tune metadata of a collection.
+ *
+ * Layout, all numbers little endian:
+ * - header: magic "SIDINFO", version, entry count, size of the string table
+ * - records: one per tune, sorted by path, with offsets into
+ *   the string table and the numeric fields
+ * - MD5 order: the record numbers sorted by MD5
+ * - string table: zero terminated strings, shared among records
+ *
+ * The file is mapped and validated on open, records are decoded
+ * on access. Lookups don't change the object and can run concurrently.
+ */
+class catalogIndex
+{
+public:
+    static constexpr unsigned int MAX_SIDS = 3;
+
+    /// Decoded record
+    struct record_t
+    {
+        const char* path;
+        const char* md5;
+        const char* title;
+        const char* author;
+        const char* released;
+        const char* format;
+        uint_least32_t dataFileLen;
+        uint_least16_t songs;
+        uint_least16_t startSong;
+        uint_least16_t loadAddr;
+        uint_least16_t initAddr;
+        uint_least16_t playAddr;
+        uint8_t clockSpeed;
+        uint8_t compatibility;
+        uint8_t sidChips;
+        uint8_t sidModel[MAX_SIDS];
+        uint_least16_t sidChipBase[MAX_SIDS];
+    };
+
+private:
+    mappedFile file;
+
+    uint_least32_t count = 0;
+
+    const uint_least8_t* records = nullptr;
+
+    const uint_least8_t* md5Order = nullptr;
+
+    const char* strings = nullptr;
+
+private:
+    bool parse();
+
+    const char* path(uint_least32_t i) const;
+
+    const char* md5(uint_least32_t i) const;
+
+public:
+    bool open(const char* fileName);
+
+    void close();
+
+    unsigned int size() const { return count; }
+
+    /**
+     * Decode the i-th record.
+     */
+    void get(unsigned int i, record_t& record) const;
+
+    /**
+     * @return the record number, -1 if missing
+     */
+    int find(const char* path) const;
+
+    /**
+     * @return the record number, -1 if missing
+     */
+    int findMD5(const char* md5) const;
+
+    /**
+     * Write an index.
+     *
+     * @param fileName the index to create
+     * @param records the tunes, strings must be valid, they are sorted by path
+     * @return false if the index can't be written
+     */
+    static bool build(const char* fileName, std::vector<record_t> records);
+};
+
+}
+
+#endif // CATALOGINDEX_H
@@ -0,0 +1,353 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "md5Batch.h"
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+#include "sidendian.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#  include <emmintrin.h>
+#  define USE_SSE2
+#endif
+
+namespace libsidplayfp
+{
+
+namespace
+{
+
+constexpr unsigned int LANES = 4;
+
+constexpr unsigned int BLOCK_SIZE = 64;
+
+constexpr uint_least32_t IV[4] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 };
+
+// Primitives for a single lane
+
+inline uint32_t add(uint32_t x, uint32_t y) { return x + y; }
+inline uint32_t and_(uint32_t x, uint32_t y) { return x & y; }
+inline uint32_t andnot(uint32_t x, uint32_t y) { return ~x & y; }
+inline uint32_t or_(uint32_t x, uint32_t y) { return x | y; }
+inline uint32_t xor_(uint32_t x, uint32_t y) { return x ^ y; }
+inline uint32_t not_(uint32_t x) { return ~x; }
+inline uint32_t splat(uint32_t, uint32_t t) { return t; }
+template<int s> inline uint32_t rotl(uint32_t x) { return (x << s) | (x >> (32 - s)); }
+
+#ifdef USE_SSE2
+// Primitives for all the lanes at once
+
+inline __m128i add(__m128i x, __m128i y) { return _mm_add_epi32(x, y); }
+inline __m128i and_(__m128i x, __m128i y) { return _mm_and_si128(x, y); }
+inline __m128i andnot(__m128i x, __m128i y) { return _mm_andnot_si128(x, y); }
+inline __m128i or_(__m128i x, __m128i y) { return _mm_or_si128(x, y); }
+inline __m128i xor_(__m128i x, __m128i y) { return _mm_xor_si128(x, y); }
+inline __m128i not_(__m128i x) { return _mm_xor_si128(x, _mm_set1_epi32(-1)); }
+inline __m128i splat(__m128i, uint32_t t) { return _mm_set1_epi32(static_cast<int>(t)); }
+template<int s> inline __m128i rotl(__m128i x) { return _mm_or_si128(_mm_slli_epi32(x, s), _mm_srli_epi32(x, 32 - s)); }
+#endif
+
+struct F { template<typename V> static V apply(V b, V c, V d) { return or_(and_(b, c), andnot(b, d)); } };
+struct G { template<typename V> static V apply(V b, V c, V d) { return or_(and_(b, d), andnot(d, c)); } };
+struct H { template<typename V> static V apply(V b, V c, V d) { return xor_(xor_(b, c), d); } };
+struct I { template<typename V> static V apply(V b, V c, V d) { return xor_(c, or_(b, not_(d))); } };
+
+#define STEP(f, a, b, c, d, k, s, t) \
+    a = add(b, rotl<s>(add(add(a, f::apply(b, c, d)), add(x[k], splat(a, t)))))
+
+/**
+ * The MD5 compression function, on one lane or on all of them.
+ */
+template<typename V>
+void transform(V state[4], const V x[16])
+{
+    V a = state[0];
+    V b = state[1];
+    V c = state[2];
+    V d = state[3];
+
+    // Round 1
+    STEP(F, a, b, c, d,  0,  7, 0xd76aa478);
+    STEP(F, d, a, b, c,  1, 12, 0xe8c7b756);
+    STEP(F, c, d, a, b,  2, 17, 0x242070db);
+    STEP(F, b, c, d, a,  3, 22, 0xc1bdceee);
+    STEP(F, a, b, c, d,  4,  7, 0xf57c0faf);
+    STEP(F, d, a, b, c,  5, 12, 0x4787c62a);
+    STEP(F, c, d, a, b,  6, 17, 0xa8304613);
+    STEP(F, b, c, d, a,  7, 22, 0xfd469501);
+    STEP(F, a, b, c, d,  8,  7, 0x698098d8);
+    STEP(F, d, a, b, c,  9, 12, 0x8b44f7af);
+    STEP(F, c, d, a, b, 10, 17, 0xffff5bb1);
+    STEP(F, b, c, d, a, 11, 22, 0x895cd7be);
+    STEP(F, a, b, c, d, 12,  7, 0x6b901122);
+    STEP(F, d, a, b, c, 13, 12, 0xfd987193);
+    STEP(F, c, d, a, b, 14, 17, 0xa679438e);
+    STEP(F, b, c, d, a, 15, 22, 0x49b40821);
+
+    // Round 2
+    STEP(G, a, b, c, d,  1,  5, 0xf61e2562);
+    STEP(G, d, a, b, c,  6,  9, 0xc040b340);
+    STEP(G, c, d, a, b, 11, 14, 0x265e5a51);
+    STEP(G, b, c, d, a,  0, 20, 0xe9b6c7aa);
+    STEP(G, a, b, c, d,  5,  5, 0xd62f105d);
+    STEP(G, d, a, b, c, 10,  9, 0x02441453);
+    STEP(G, c, d, a, b, 15, 14, 0xd8a1e681);
+    STEP(G, b, c, d, a,  4, 20, 0xe7d3fbc8);
+    STEP(G, a, b, c, d,  9,  5, 0x21e1cde6);
+    STEP(G, d, a, b, c, 14,  9, 0xc33707d6);
+    STEP(G, c, d, a, b,  3, 14, 0xf4d50d87);
+    STEP(G, b, c, d, a,  8, 20, 0x455a14ed);
+    STEP(G, a, b, c, d, 13,  5, 0xa9e3e905);
+    STEP(G, d, a, b, c,  2,  9, 0xfcefa3f8);
+    STEP(G, c, d, a, b,  7, 14, 0x676f02d9);
+    STEP(G, b, c, d, a, 12, 20, 0x8d2a4c8a);
+
+    // Round 3
+    STEP(H, a, b, c, d,  5,  4, 0xfffa3942);
+    STEP(H, d, a, b, c,  8, 11, 0x8771f681);
+    STEP(H, c, d, a, b, 11, 16, 0x6d9d6122);
+    STEP(H, b, c, d, a, 14, 23, 0xfde5380c);
+    STEP(H, a, b, c, d,  1,  4, 0xa4beea44);
+    STEP(H, d, a, b, c,  4, 11, 0x4bdecfa9);
+    STEP(H, c, d, a, b,  7, 16, 0xf6bb4b60);
+    STEP(H, b, c, d, a, 10, 23, 0xbebfbc70);
+    STEP(H, a, b, c, d, 13,  4, 0x289b7ec6);
+    STEP(H, d, a, b, c,  0, 11, 0xeaa127fa);
+    STEP(H, c, d, a, b,  3, 16, 0xd4ef3085);
+    STEP(H, b, c, d, a,  6, 23, 0x04881d05);
+    STEP(H, a, b, c, d,  9,  4, 0xd9d4d039);
+    STEP(H, d, a, b, c, 12, 11, 0xe6db99e5);
+    STEP(H, c, d, a, b, 15, 16, 0x1fa27cf8);
+    STEP(H, b, c, d, a,  2, 23, 0xc4ac5665);
+
+    // Round 4
+    STEP(I, a, b, c, d,  0,  6, 0xf4292244);
+    STEP(I, d, a, b, c,  7, 10, 0x432aff97);
+    STEP(I, c, d, a, b, 14, 15, 0xab9423a7);
+    STEP(I, b, c, d, a,  5, 21, 0xfc93a039);
+    STEP(I, a, b, c, d, 12,  6, 0x655b59c3);
+    STEP(I, d, a, b, c,  3, 10, 0x8f0ccc92);
+    STEP(I, c, d, a, b, 10, 15, 0xffeff47d);
+    STEP(I, b, c, d, a,  1, 21, 0x85845dd1);
+    STEP(I, a, b, c, d,  8,  6, 0x6fa87e4f);
+    STEP(I, d, a, b, c, 15, 10, 0xfe2ce6e0);
+    STEP(I, c, d, a, b,  6, 15, 0xa3014314);
+    STEP(I, b, c, d, a, 13, 21, 0x4e0811a1);
+    STEP(I, a, b, c, d,  4,  6, 0xf7537e82);
+    STEP(I, d, a, b, c, 11, 10, 0xbd3af235);
+    STEP(I, c, d, a, b,  2, 15, 0x2ad7d2bb);
+    STEP(I, b, c, d, a,  9, 21, 0xeb86d391);
+
+    state[0] = add(state[0], a);
+    state[1] = add(state[1], b);
+    state[2] = add(state[2], c);
+    state[3] = add(state[3], d);
+}
+
+#undef STEP
+
+/**
+ * Compress one block for each lane.
+ *
+ * @param state the hash state, word-major
+ * @param blocks the block for each lane
+ */
+void compress(uint32_t state[4][LANES], const uint8_t* const blocks[LANES])
+{
+#ifdef USE_SSE2
+    __m128i st[4];
+    for (unsigned int w = 0; w < 4; w++)
+        st[w] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state[w]));
+
+    // Transpose so that each vector holds the same word of all the lanes
+    __m128i x[16];
+    for (unsigned int g = 0; g < 16; g += 4)
+    {
+        const __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks[0] + g * 4));
+        const __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks[1] + g * 4));
+        const __m128i r2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks[2] + g * 4));
+        const __m128i r3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks[3] + g * 4));
+        const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+        const __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+        const __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+        const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+        x[g]     = _mm_unpacklo_epi64(t0, t1);
+        x[g + 1] = _mm_unpackhi_epi64(t0, t1);
+        x[g + 2] = _mm_unpacklo_epi64(t2, t3);
+        x[g + 3] = _mm_unpackhi_epi64(t2, t3);
+    }
+
+    transform(st, x);
+
+    for (unsigned int w = 0; w < 4; w++)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(state[w]), st[w]);
+#else
+    for (unsigned int l = 0; l < LANES; l++)
+    {
+        uint32_t st[4] = { state[0][l], state[1][l], state[2][l], state[3][l] };
+
+        uint32_t x[16];
+        for (unsigned int k = 0; k < 16; k++)
+            x[k] = endian_little32(blocks[l] + k * 4);
+
+        transform(st, x);
+
+        for (unsigned int w = 0; w < 4; w++)
+            state[w][l] = st[w];
+    }
+#endif
+}
+
+/**
+ * Progress of the message in a lane.
+ */
+struct lane
+{
+    const md5Batch::job* job;
+
+    /// Length of the message
+    uint_least32_t length;
+
+    /// Number of blocks, including the padding
+    uint_least32_t blocks;
+
+    uint_least32_t block;
+
+    /// Assembled block when it can't be read in place
+    uint8_t buffer[BLOCK_SIZE];
+
+    void start(const md5Batch::job* j)
+    {
+        job = j;
+        length = j->size[0] + j->size[1];
+        blocks = (length + 8) / BLOCK_SIZE + 1;
+        block = 0;
+    }
+
+    /**
+     * Copy the part of the message in [pos, pos + BLOCK_SIZE)
+     * belonging to the segment starting at start.
+     */
+    void copy(uint_least32_t pos, const uint8_t* data, uint_least32_t start, uint_least32_t size)
+    {
+        const uint_least32_t lo = std::max(pos, start);
+        const uint_least32_t hi = std::min(pos + BLOCK_SIZE, start + size);
+        if (lo < hi)
+            std::memcpy(buffer + (lo - pos), data + (lo - start), hi - lo);
+    }
+
+    const uint8_t* fetch()
+    {
+        const uint_least32_t pos = block * BLOCK_SIZE;
+        const uint_least32_t size0 = job->size[0];
+
+        // Most blocks lie within one part
+        if (pos + BLOCK_SIZE <= size0)
+            return job->data[0] + pos;
+        if ((pos >= size0) && (pos + BLOCK_SIZE <= length))
+            return job->data[1] + (pos - size0);
+
+        std::memset(buffer, 0, BLOCK_SIZE);
+        copy(pos, job->data[0], 0, size0);
+        copy(pos, job->data[1], size0, job->size[1]);
+
+        if ((length >= pos) && (length < pos + BLOCK_SIZE))
+            buffer[length - pos] = 0x80;
+
+        if (block == blocks - 1)
+        {
+            const uint_least32_t bits = length << 3;
+            endian_little32(buffer + 56, bits);
+            endian_little32(buffer + 60, length >> 29);
+        }
+
+        return buffer;
+    }
+};
+
+}
+
+void md5Batch::run(const job* jobs, size_t count)
+{
+    static const uint8_t idle[BLOCK_SIZE] = {};
+
+    uint32_t state[4][LANES];
+    lane lanes[LANES];
+    size_t next = 0;
+
+    auto start = [&](unsigned int l)
+    {
+        if (next < count)
+        {
+            lanes[l].start(&jobs[next++]);
+            for (unsigned int w = 0; w < 4; w++)
+                state[w][l] = IV[w];
+        }
+        else
+        {
+            lanes[l].job = nullptr;
+        }
+    };
+
+    for (unsigned int l = 0; l < LANES; l++)
+        start(l);
+
+    for (;;)
+    {
+        const uint8_t* blocks[LANES];
+        bool active = false;
+        for (unsigned int l = 0; l < LANES; l++)
+        {
+            if (lanes[l].job != nullptr)
+            {
+                blocks[l] = lanes[l].fetch();
+                active = true;
+            }
+            else
+            {
+                blocks[l] = idle;
+            }
+        }
+
+        if (!active)
+            break;
+
+        compress(state, blocks);
+
+        for (unsigned int l = 0; l < LANES; l++)
+        {
+            if ((lanes[l].job != nullptr) && (++lanes[l].block == lanes[l].blocks))
+            {
+                for (unsigned int w = 0; w < 4; w++)
+                    endian_little32(lanes[l].job->digest + w * 4, state[w][l]);
+
+                start(l);
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,64 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef MD5_BATCH_H
+#define MD5_BATCH_H
+
+#include <cstddef>
+
+#include <stdint.h>
+
+namespace libsidplayfp
+{
+
+/**
+ * Multi-buffer MD5.
+ *
+ * Hashes several independent messages at once, one per lane,
+ * using SSE2 where available. As soon as a message ends
+ * its lane moves on to the next one so lanes stay busy
+ * even when the lengths differ.
+ */
+namespace md5Batch
+{
+    /// Size of a binary digest
+    constexpr unsigned int DIGEST_SIZE = 16;
+
+    /**
+     * A message made of up to two contiguous parts.
+     */
+    struct job
+    {
+        const uint8_t* data[2];
+        uint_least32_t size[2];
+
+        /// Where to store the binary digest
+        uint8_t* digest;
+    };
+
+    /**
+     * Hash all the messages.
+     */
+    void run(const job* jobs, size_t count);
+}
+
+}
+
+#endif // MD5_BATCH_H
@@ -0,0 +1,231 @@
+/*
+ *  Copyright (C) 2025 Leandro Nini
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "packedArchive.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "sidendian.h"
+#include "sidmd5.h"
+
+#include "sidcxx11.h"
+
+namespace libsidplayfp
+{
+
+namespace
+{
+
+const char MAGIC[8] = { 'S', 'I', 'D', 'P', 'A', 'C', 'K', 0 };
+
+constexpr uint_least32_t ARCHIVE_VERSION = 1;
+
+constexpr unsigned int HEADER_SIZE = 24;
+
+constexpr unsigned int RECORD_SIZE = 8 + 4 + 4 + 4 + packedArchive::MD5_LENGTH;
+
+/// Sanity limit for a single entry
+constexpr uint_least32_t MAX_ENTRY_SIZE = 16 * 1024 * 1024;
+
+uint_least64_t endian_little64(const uint8_t ptr[8])
+{
+    return static_cast<uint_least64_t>(endian_little32(ptr))
+        | (static_cast<uint_least64_t>(endian_little32(ptr + 4)) << 32);
+}
+
+void endian_little64(uint8_t ptr[8], uint_least64_t qword)
+{
+    endian_little32(ptr, static_cast<uint_least32_t>(qword));
+    endian_little32(ptr + 4, static_cast<uint_least32_t>(qword >> 32));
+}
+
+}
+
+bool packedArchive::open(const char* fileName)
+{
+    close();
+
+    if (!file.open(fileName) || !parse())
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+bool packedArchive::parse()
+{
+    const uint_least8_t* base = file.data();
+    const size_t fileSize = file.size();
+
+    if ((fileSize < HEADER_SIZE)
+        || (std::memcmp(base, MAGIC, sizeof(MAGIC)) != 0)
+        || (endian_little32(base + 8) != ARCHIVE_VERSION))
+        return false;
+
+    const uint_least32_t count = endian_little32(base + 12);
+    const uint_least32_t namesSize = endian_little32(base + 16);
+
+    const uint_least64_t namesOffset = HEADER_SIZE + static_cast<uint_least64_t>(count) * RECORD_SIZE;
+    if ((namesOffset + namesSize) > fileSize)
+        return false;
+
+    const char* names = reinterpret_cast<const char*>(base + namesOffset);
+
+    entries.reserve(count);
+
+    const uint_least8_t* record = base + HEADER_SIZE;
+    for (uint_least32_t i = 0; i < count; i++, record += RECORD_SIZE)
+    {
+        const uint_least64_t dataOffset = endian_little64(record);
+        const uint_least32_t dataSize   = endian_little32(record + 8);
+        const uint_least32_t nameOffset = endian_little32(record + 12);
+        const uint_least32_t nameLength = endian_little32(record + 16);
+
+        // Names must be zero terminated within the table
+        if ((dataOffset > fileSize)
+            || (dataSize > fileSize - dataOffset)
+            || (nameOffset >= namesSize)
+            || (nameLength >= namesSize - nameOffset)
+            || (names[nameOffset + nameLength] != 0))
+            return false;
+
+        entry_t entry;
+        entry.name = names + nameOffset;
+        entry.data = base + dataOffset;
+        entry.size = dataSize;
+        entry.md5 = reinterpret_cast<const char*>(record + 20);
+
+        // The index must be sorted for lookups to work
+        if (!entries.empty() && (std::strcmp(entries.back().name, entry.name) >= 0))
+            return false;
+
+        entries.push_back(entry);
+    }
+
+    return true;
+}
+
+void packedArchive::close()
+{
+    entries.clear();
+    file.close();
+}
+
+int packedArchive::find(const char* name) const
+{
+    auto it = std::lower_bound(entries.begin(), entries.end(), name,
+        [](const entry_t &a, const char* b)
+        {
+            return std::strcmp(a.name, b) < 0;
+        });
+
+    if ((it == entries.end()) || (std::strcmp(it->name, name) != 0))
+        return -1;
+
+    return it - entries.begin();
+}
+
+bool packedArchive::build(const char* fileName, const char* baseDir, std::vector<std::string> names)
+{
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+
+    uint_least32_t namesSize = 0;
+    for (const std::string &name : names)
+        namesSize += name.size() + 1;
+
+    std::ofstream out(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (out.fail())
+        return false;
+
+    // Write the name table first, the index is filled in later
+    std::vector<uint8_t> index(HEADER_SIZE + names.size() * RECORD_SIZE);
+
+    std::memcpy(&index[0], MAGIC, sizeof(MAGIC));
+    endian_little32(&index[8], ARCHIVE_VERSION);
+    endian_little32(&index[12], names.size());
+    endian_little32(&index[16], namesSize);
+
+    out.write(reinterpret_cast<const char*>(index.data()), index.size());
+    for (const std::string &name : names)
+        out.write(name.c_str(), name.size() + 1);
+
+    uint_least64_t dataOffset = index.size() + namesSize;
+    uint_least32_t nameOffset = 0;
+
+    std::vector<char> buffer;
+
+    try
+    {
+        for (size_t i = 0; i < names.size(); i++)
+        {
+            std::string path(baseDir);
+            if (!path.empty() && (path.back() != '/'))
+                path.push_back('/');
+            path.append(names[i]);
+
+            std::ifstream in(path.c_str(), std::ios::in | std::ios::binary);
+            if (in.fail())
+                return false;
+
+            in.seekg(0, in.end);
+            const std::streamoff size = in.tellg();
+            in.seekg(0, in.beg);
+
+            if ((size < 0) || (size > MAX_ENTRY_SIZE))
+                return false;
+
+            buffer.resize(size);
+            in.read(buffer.data(), size);
+            if (in.gcount() != size)
+                return false;
+
+            sidmd5 md5;
+            md5.append(buffer.data(), size);
+            md5.finish();
+
+            uint8_t* record = &index[HEADER_SIZE + i * RECORD_SIZE];
+            endian_little64(record, dataOffset);
+            endian_little32(record + 8, size);
+            endian_little32(record + 12, nameOffset);
+            endian_little32(record + 16, names[i].size());
+            md5.getDigest().copy(reinterpret_cast<char*>(record + 20), MD5_LENGTH);
+
+            out.write(buffer.data(), size);
+
+            dataOffset += size;
+            nameOffset += names[i].size() + 1;
+        }
+    }
+    catch (md5Error const &)
+    {
+        return false;
+    }
+
+    out.seekp(0, out.beg);
+    out.write(reinterpret_cast<const char*>(index.data()), index.size());
+    out.close();
+
+    return !out.fail();
+}
+
+}
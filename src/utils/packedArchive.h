@@ -0,0 +1,114 @@
+/*
+ *  Copyright (C) 2025 Leandro Nini
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef PACKEDARCHIVE_H
+#define PACKEDARCHIVE_H
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "sidtune/mappedFile.h"
+
+namespace libsidplayfp
+{
+
+/**
+ * A collection of files packed into a single one.
+ *
+ * Layout, all numbers little endian:
+ * - header: magic "SIDPACK", version, entry count, size of the name table
+ * - index: one record per entry, sorted by name, holding
+ *   data offset and length, name offset and length and the MD5
+ *   of the content
+ * - name table: zero terminated names
+ * - data: the file contents, in index order
+ *
+ * The archive is mapped and the index decoded once,
+ * lookups don't change the object and can run concurrently.
+ */
+class packedArchive
+{
+public:
+    /// Length of the hex MD5 stored for each entry
+    static constexpr unsigned int MD5_LENGTH = 32;
+
+private:
+    struct entry_t
+    {
+        const char* name;
+        const uint_least8_t* data;
+        uint_least32_t size;
+        const char* md5;
+    };
+
+private:
+    mappedFile file;
+
+    /// Entries sorted by name
+    std::vector<entry_t> entries;
+
+private:
+    bool parse();
+
+public:
+    bool open(const char* fileName);
+
+    void close();
+
+    unsigned int size() const { return entries.size(); }
+
+    /**
+     * Get the name of the i-th entry.
+     */
+    const char* name(unsigned int i) const { return entries[i].name; }
+
+    /**
+     * Find an entry.
+     *
+     * @return the index of the entry, -1 if missing
+     */
+    int find(const char* name) const;
+
+    /**
+     * Get the content of an entry, valid until the archive is closed.
+     */
+    const uint_least8_t* data(unsigned int i) const { return entries[i].data; }
+
+    uint_least32_t dataSize(unsigned int i) const { return entries[i].size; }
+
+    /**
+     * Get the hex MD5 of the content, not zero terminated.
+     */
+    const char* md5(unsigned int i) const { return entries[i].md5; }
+
+    /**
+     * Pack files into an archive.
+     *
+     * @param fileName the archive to create
+     * @param baseDir the directory names are relative to
+     * @param names the files to pack
+     * @return false if a file can't be read or the archive can't be written
+     */
+    static bool build(const char* fileName, const char* baseDir, std::vector<std::string> names);
+};
+
+}
+
+#endif // PACKEDARCHIVE_H
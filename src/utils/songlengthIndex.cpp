@@ -0,0 +1,313 @@
+/*
+ *  Copyright (C) 2025 Leandro Nini
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "songlengthIndex.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#include "sidcxx11.h"
+
+namespace libsidplayfp
+{
+
+namespace
+{
+
+const char DATABASE_SECTION[] = "Database";
+
+constexpr unsigned int MD5_HEX_LENGTH = songlengthIndex::MD5_SIZE * 2;
+
+int hexValue(char c)
+{
+    if ((c >= '0') && (c <= '9'))
+        return c - '0';
+    if ((c >= 'a') && (c <= 'f'))
+        return c - 'a' + 10;
+    if ((c >= 'A') && (c <= 'F'))
+        return c - 'A' + 10;
+    return -1;
+}
+
+/**
+ * Decode a hex MD5 into its binary form.
+ *
+ * @return false if the string is not a valid hash
+ */
+bool decodeMD5(const char* hex, uint8_t* md5)
+{
+    for (unsigned int i = 0; i < songlengthIndex::MD5_SIZE; i++)
+    {
+        const int hi = hexValue(hex[i * 2]);
+        const int lo = hexValue(hex[i * 2 + 1]);
+        if ((hi < 0) || (lo < 0))
+            return false;
+
+        md5[i] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+
+    return true;
+}
+
+const char* parseNumber(const char* str, long &value)
+{
+    value = 0;
+    while (isdigit(static_cast<unsigned char>(*str)))
+    {
+        value = value * 10 + (*str - '0');
+        str++;
+    }
+    return str;
+}
+
+// mm:ss[.SSS]
+//
+// Examples of song length values:
+//
+// 1:02
+//
+// 1:02.5
+//
+// 1:02.500
+//
+// Returns nullptr if the value is malformed.
+const char* parseTime(const char* str, int_least32_t &result)
+{
+    long minutes;
+    const char* end = parseNumber(str, minutes);
+
+    if (*end != ':')
+        return nullptr;
+
+    long seconds;
+    end = parseNumber(end + 1, seconds);
+    result = ((minutes * 60) + seconds) * 1000;
+
+    if (*end == '.')
+    {
+        const char* start = end + 1;
+        long milliseconds;
+        end = parseNumber(start, milliseconds);
+        switch (end - start)
+        {
+        case 1: milliseconds *= 100; break;
+        case 2: milliseconds *= 10; break;
+        case 3: break;
+        default: return nullptr;
+        }
+
+        result += milliseconds;
+    }
+
+    // Skip attributes like "(G)"
+    while ((*end != 0) && !isspace(static_cast<unsigned char>(*end)))
+    {
+        end++;
+    }
+
+    return end;
+}
+
+bool isLineEnd(char c)
+{
+    return (c == '\n') || (c == '\r') || (c == 0);
+}
+
+}
+
+bool songlengthIndex::open(const char *fName)
+{
+    std::ifstream dbFile(fName, std::ios::binary);
+
+    return open_internal(dbFile);
+}
+
+#ifdef _WIN32
+bool songlengthIndex::open(const wchar_t *fName)
+{
+    std::ifstream dbFile(fName, std::ios::binary);
+
+    return open_internal(dbFile);
+}
+#endif
+
+bool songlengthIndex::open_internal(std::ifstream &dbFile)
+{
+    close();
+
+    if (dbFile.fail())
+    {
+        return false;
+    }
+
+    dbFile.seekg(0, std::ios::end);
+    const std::streamoff size = dbFile.tellg();
+    dbFile.seekg(0, std::ios::beg);
+
+    if (size < 0)
+    {
+        return false;
+    }
+
+    std::vector<char> data(static_cast<size_t>(size) + 1);
+    dbFile.read(data.data(), size);
+    data[static_cast<size_t>(dbFile.gcount())] = 0;
+
+    parse(data.data());
+
+    // Keep the first of duplicate entries
+    auto less = [](const entry_t &a, const entry_t &b)
+    {
+        return std::memcmp(a.md5, b.md5, MD5_SIZE) < 0;
+    };
+    auto equal = [](const entry_t &a, const entry_t &b)
+    {
+        return std::memcmp(a.md5, b.md5, MD5_SIZE) == 0;
+    };
+    std::stable_sort(entries.begin(), entries.end(), less);
+    entries.erase(std::unique(entries.begin(), entries.end(), equal), entries.end());
+
+    entries.shrink_to_fit();
+    lengths.shrink_to_fit();
+
+    return true;
+}
+
+void songlengthIndex::parse(const char* data)
+{
+    bool inDatabase = false;
+
+    const char* line = data;
+    while (*line != 0)
+    {
+        const char* eol = std::strchr(line, '\n');
+        if (eol == nullptr)
+            eol = line + std::strlen(line);
+
+        switch (*line)
+        {
+        case '\n':
+        case ';':
+        case '#':
+            // skip empty lines and comments
+            break;
+        case '[':
+        {
+            const char* close = std::find(line, eol, ']');
+            if (close != eol)
+            {
+                const size_t length = close - line - 1;
+                inDatabase = (length == sizeof(DATABASE_SECTION) - 1)
+                    && (std::memcmp(line + 1, DATABASE_SECTION, length) == 0);
+            }
+            break;
+        }
+        default:
+            if (inDatabase)
+            {
+                const char* equal = std::find(line, eol, '=');
+                if (equal != eol)
+                    parseEntry(line, equal, equal + 1);
+            }
+            break;
+        }
+
+        line = (*eol != 0) ? eol + 1 : eol;
+    }
+}
+
+void songlengthIndex::parseEntry(const char* key, const char* keyEnd, const char* value)
+{
+    while ((keyEnd > key) && (keyEnd[-1] == ' '))
+        keyEnd--;
+
+    entry_t entry;
+
+    if ((keyEnd - key != MD5_HEX_LENGTH) || !decodeMD5(key, entry.md5))
+        return;
+
+    entry.first = static_cast<uint32_t>(lengths.size());
+
+    const char* str = value;
+    for (;;)
+    {
+        while ((*str == ' ') || (*str == '\t'))
+            str++;
+
+        if (isLineEnd(*str))
+            break;
+
+        int_least32_t time;
+        str = parseTime(str, time);
+        if (str == nullptr)
+        {
+            // Subtunes from here on are unavailable
+            lengths.push_back(-1);
+            break;
+        }
+
+        lengths.push_back(time);
+    }
+
+    entry.count = static_cast<uint32_t>(lengths.size()) - entry.first;
+    entries.push_back(entry);
+}
+
+void songlengthIndex::close()
+{
+    entries.clear();
+    lengths.clear();
+}
+
+const songlengthIndex::entry_t* songlengthIndex::find(const char* md5) const
+{
+    entry_t key;
+
+    if ((std::strlen(md5) != MD5_HEX_LENGTH) || !decodeMD5(md5, key.md5))
+        return nullptr;
+
+    auto it = std::lower_bound(entries.begin(), entries.end(), key,
+        [](const entry_t &a, const entry_t &b)
+        {
+            return std::memcmp(a.md5, b.md5, MD5_SIZE) < 0;
+        });
+
+    if ((it == entries.end()) || (std::memcmp(it->md5, key.md5, MD5_SIZE) != 0))
+        return nullptr;
+
+    return &(*it);
+}
+
+int_least32_t songlengthIndex::lengthMs(const char* md5, unsigned int song) const
+{
+    const entry_t* entry = find(md5);
+
+    if (entry == nullptr)
+        return -1;
+
+    if (song == 0)
+        return 0;
+
+    if (song > entry->count)
+        return -1;
+
+    return lengths[entry->first + song - 1];
+}
+
+}
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (C) 2025 Leandro Nini
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef SONGLENGTHINDEX_H
+#define SONGLENGTHINDEX_H
+
+#include <stdint.h>
+
+#include <fstream>
+#include <vector>
+
+namespace libsidplayfp
+{
+
+/**
+ * The [Database] section of the songlength database,
+ * decoded once into a sorted array of binary MD5 keys
+ * and a flat array of subtune lengths.
+ * Lookups don't allocate and, not changing the index,
+ * can run concurrently.
+ */
+class songlengthIndex
+{
+public:
+    /// Size of a binary MD5 hash
+    static constexpr unsigned int MD5_SIZE = 16;
+
+private:
+    struct entry_t
+    {
+        uint8_t md5[MD5_SIZE];
+
+        /// Index of the first subtune length
+        uint32_t first;
+
+        /// Number of subtune lengths
+        uint32_t count;
+    };
+
+private:
+    /// Entries sorted by MD5
+    std::vector<entry_t> entries;
+
+    /// Lengths in milliseconds, -1 marks a corrupt value
+    std::vector<int_least32_t> lengths;
+
+private:
+    bool open_internal(std::ifstream& dbFile);
+
+    void parse(const char* data);
+
+    void parseEntry(const char* key, const char* keyEnd, const char* value);
+
+    const entry_t* find(const char* md5) const;
+
+public:
+    bool open(const char *fName);
+#ifdef _WIN32
+    bool open(const wchar_t* fName);
+#endif
+    void close();
+
+    /**
+     * Get the length of a subtune.
+     *
+     * @param md5 the hex MD5 of the tune
+     * @param song the subtune, starting from 1
+     * @return the length in milliseconds, -1 if the tune
+     *         or the subtune is missing or corrupt
+     */
+    int_least32_t lengthMs(const char* md5, unsigned int song) const;
+};
+
+}
+
+#endif // SONGLENGTHINDEX_H
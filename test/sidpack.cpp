@@ -0,0 +1,100 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2025 Leandro Nini <drfiemost@users.sourceforge.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "utils/SidArchive.h"
+#include "utils/SidCatalog.h"
+
+/*
+ * Packs a directory tree, like an HVSC copy, into a single archive,
+ * or with -i indexes the tune informations into a catalogue.
+ *
+ * Usage:
+ *     sidpack [-i] <output> <directory>
+ *
+ * Entries are named after their path relative to the directory,
+ * e.g. MUSICIANS/H/Hubbard_Rob/Commando.sid
+ */
+
+/*
+ * Collect the regular files under baseDir/prefix.
+ */
+void scan(const std::string& baseDir, const std::string& prefix, std::vector<std::string>& paths)
+{
+    DIR* dir = opendir((baseDir + '/' + prefix).c_str());
+    if (dir == nullptr)
+        return;
+
+    while (dirent* entry = readdir(dir))
+    {
+        const std::string name(entry->d_name);
+        if (name == "." || name == "..")
+            continue;
+
+        const std::string path = prefix.empty() ? name : prefix + '/' + name;
+
+        struct stat st;
+        if (stat((baseDir + '/' + path).c_str(), &st) != 0)
+            continue;
+
+        if (S_ISDIR(st.st_mode))
+            scan(baseDir, path, paths);
+        else if (S_ISREG(st.st_mode))
+            paths.push_back(path);
+    }
+
+    closedir(dir);
+}
+
+int main(int argc, char* argv[])
+{
+    const bool catalog = (argc == 4) && (std::string(argv[1]) == "-i");
+
+    if ((argc != 3) && !catalog)
+    {
+        std::cerr << "Usage: " << argv[0] << " [-i] <output> <directory>" << std::endl;
+        return -1;
+    }
+
+    const char* output = argv[argc - 2];
+    const char* directory = argv[argc - 1];
+
+    std::vector<std::string> paths;
+    scan(directory, "", paths);
+
+    const bool ok = catalog ?
+        SidCatalog::build(output, directory, paths) :
+        SidArchive::build(output, directory, paths);
+
+    if (!ok)
+    {
+        std::cerr << "Error creating " << output << std::endl;
+        return -1;
+    }
+
+    std::cout << paths.size() << " files processed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,220 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2025 Leandro Nini
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "utpp/utpp.h"
+
+#include "../src/utils/BatchRenderer.h"
+#include "../src/sidplayfp/SidConfig.h"
+
+#include <stdint.h>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+using namespace UnitTest;
+
+SUITE(BatchRenderer)
+{
+
+#define TUNE_FILE "TestBatchRenderer.sid"
+
+static const uint8_t psid[] = {
+    0x50, 0x53, 0x49, 0x44, // magicID
+    0x00, 0x02,             // version
+    0x00, 0x7C,             // dataOffset
+    0x00, 0x00,             // loadAddress
+    0x10, 0x00,             // initAddress
+    0x10, 0x01,             // playAddress
+    0x00, 0x02,             // songs
+    0x00, 0x01,             // startSong
+    0x00, 0x00, 0x00, 0x00, // speed
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // name
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // author
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // released
+    0x00, 0x00,             // flags
+    0x00,                   // startPage
+    0x00,                   // pageLength
+    0x00,                   // secondSIDAddress
+    0x00,                   // thirdSIDAddress
+    0x00, 0x10, 0x60, 0x60  // data
+};
+
+class CountingSink : public BatchRenderer::Sink
+{
+private:
+    std::mutex lock;
+
+public:
+    std::vector<uint_least32_t> samplesCount;
+    std::vector<int> finishedCount;
+    std::vector<const char*> errors;
+
+    /// Stop the jobs after this many samples, 0 to never stop
+    uint_least32_t stopAfter = 0;
+
+public:
+    CountingSink(unsigned int jobs) :
+        samplesCount(jobs, 0),
+        finishedCount(jobs, 0),
+        errors(jobs, nullptr)
+    {}
+
+    bool samples(unsigned int job, const short *, uint_least32_t count) override
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        samplesCount[job] += count;
+        return (stopAfter == 0) || (samplesCount[job] < stopAfter);
+    }
+
+    void finished(unsigned int job, const char *error) override
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        finishedCount[job]++;
+        errors[job] = error;
+    }
+};
+
+struct Renderer
+{
+    BatchRenderer renderer;
+    SidConfig cfg;
+
+    Renderer()
+    {
+        FILE* f = fopen(TUNE_FILE, "wb");
+        fwrite(psid, 1, sizeof(psid), f);
+        fclose(f);
+
+        cfg.frequency = 48000;
+        cfg.playback = SidConfig::MONO;
+        renderer.setConfig(cfg);
+    }
+
+    ~Renderer()
+    {
+        remove(TUNE_FILE);
+    }
+};
+
+TEST_FIXTURE(Renderer, TestRenderJobs)
+{
+    CountingSink sink(4);
+
+    renderer.add(TUNE_FILE, 1, &sink, 100);
+    renderer.add(TUNE_FILE, 2, &sink, 200);
+    renderer.add(TUNE_FILE, 0, &sink, 50);
+
+    SidConfig stereo(cfg);
+    stereo.playback = SidConfig::STEREO;
+    renderer.add(TUNE_FILE, 1, &sink, 100, &stereo);
+
+    CHECK_EQUAL(4u, renderer.jobs());
+    CHECK(renderer.run(2));
+
+    CHECK_EQUAL(4800u, sink.samplesCount[0]);
+    CHECK_EQUAL(9600u, sink.samplesCount[1]);
+    CHECK_EQUAL(2400u, sink.samplesCount[2]);
+    CHECK_EQUAL(9600u, sink.samplesCount[3]);
+
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        CHECK_EQUAL(1, sink.finishedCount[i]);
+        CHECK(sink.errors[i] == nullptr);
+        CHECK(renderer.finished(i));
+    }
+
+    CHECK_EQUAL(200u, renderer.progress(1));
+}
+
+TEST_FIXTURE(Renderer, TestDefaultLength)
+{
+    CountingSink sink(1);
+
+    renderer.setDefaultLength(10);
+    renderer.add(TUNE_FILE, 1, &sink);
+
+    CHECK(renderer.run(1));
+    CHECK_EQUAL(480u, sink.samplesCount[0]);
+}
+
+TEST_FIXTURE(Renderer, TestWholeFrames)
+{
+    CountingSink sink(1);
+
+    // 44100 Hz stereo for 5 ms is 441 samples
+    SidConfig stereo(cfg);
+    stereo.frequency = 44100;
+    stereo.playback = SidConfig::STEREO;
+    renderer.add(TUNE_FILE, 1, &sink, 5, &stereo);
+
+    CHECK(renderer.run(1));
+    CHECK_EQUAL(440u, sink.samplesCount[0]);
+}
+
+TEST_FIXTURE(Renderer, TestMissingFile)
+{
+    CountingSink sink(2);
+
+    renderer.add("TestBatchRenderer.missing", 1, &sink, 100);
+    renderer.add(TUNE_FILE, 1, &sink, 100);
+
+    CHECK(!renderer.run(2));
+
+    CHECK(sink.errors[0] != nullptr);
+    CHECK_EQUAL(0u, sink.samplesCount[0]);
+    CHECK(sink.errors[1] == nullptr);
+    CHECK_EQUAL(4800u, sink.samplesCount[1]);
+}
+
+TEST_FIXTURE(Renderer, TestCancel)
+{
+    CountingSink sink(2);
+
+    renderer.add(TUNE_FILE, 1, &sink, 100);
+    renderer.add(TUNE_FILE, 1, &sink, 100);
+
+    renderer.cancel(0);
+
+    CHECK(!renderer.run(1));
+
+    CHECK_EQUAL(1, sink.finishedCount[0]);
+    CHECK(sink.errors[0] != nullptr);
+    CHECK_EQUAL(0u, sink.samplesCount[0]);
+    CHECK(sink.errors[1] == nullptr);
+}
+
+TEST_FIXTURE(Renderer, TestSinkStops)
+{
+    CountingSink sink(1);
+    sink.stopAfter = 1;
+
+    renderer.add(TUNE_FILE, 1, &sink, 1000);
+
+    CHECK(!renderer.run(1));
+
+    CHECK(sink.errors[0] != nullptr);
+    CHECK(sink.samplesCount[0] < 48000u);
+    CHECK(renderer.progress(0) < 1000u);
+}
+
+}
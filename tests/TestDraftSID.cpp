@@ -0,0 +1,180 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2025 Leandro Nini
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "utpp/utpp.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "../src/builders/residfp-builder/residfp/SID.h"
+#include "../src/builders/residfp-builder/residfp/DraftSID.h"
+
+using namespace UnitTest;
+using namespace reSIDfp;
+
+#define CLOCK_FREQ 985248.
+#define SAMPLE_FREQ 44100.
+#define DFT_SIZE 4096
+#define BANDS 7
+
+/// Play a note for half a second and keep the last DFT_SIZE samples.
+template<class T>
+static std::vector<double> render(T& sid, const unsigned char* regs)
+{
+    for (int i = 0; i < 0x19; i++)
+        sid.write(i, regs[i]);
+
+    std::vector<short> buf(SAMPLE_FREQ);
+    int n = 0;
+
+    for (int i = 0; i < CLOCK_FREQ / 2; i += 1000)
+        n += sid.clock(1000, buf.data() + n);
+
+    std::vector<double> out(DFT_SIZE);
+    for (int i = 0; i < DFT_SIZE; i++)
+        out[i] = buf[n - DFT_SIZE + i];
+
+    return out;
+}
+
+static double rms(const std::vector<double>& s)
+{
+    double mean = 0.;
+    for (double v: s)
+        mean += v;
+    mean /= s.size();
+
+    double sum = 0.;
+    for (double v: s)
+        sum += (v - mean) * (v - mean);
+
+    return std::sqrt(sum / s.size());
+}
+
+/// Energy in the octave bands starting from 172Hz, in dB.
+static std::vector<double> bands(const std::vector<double>& s)
+{
+    std::vector<double> energy(BANDS, 0.);
+
+    for (int k = 16, b = 0; b < BANDS; k *= 2, b++)
+    {
+        for (int bin = k; bin < 2 * k; bin++)
+        {
+            double re = 0.;
+            double im = 0.;
+            for (int i = 0; i < DFT_SIZE; i++)
+            {
+                // Hann window
+                const double w = 0.5 - 0.5 * std::cos(2. * M_PI * i / DFT_SIZE);
+                re += w * s[i] * std::cos(2. * M_PI * bin * i / DFT_SIZE);
+                im += w * s[i] * std::sin(2. * M_PI * bin * i / DFT_SIZE);
+            }
+            energy[b] += re * re + im * im;
+        }
+
+        energy[b] = 10. * std::log10(energy[b] + 1.);
+    }
+
+    return energy;
+}
+
+/**
+ * Compare the loudness, in dB, and the spectral balance
+ * of the draft emulation against the full one.
+ */
+static void compare(ChipModel model, const unsigned char* regs, double maxLoudnessDeviation, double maxBandDeviation)
+{
+    SID full;
+    full.setChipModel(model);
+    full.setSamplingParameters(CLOCK_FREQ, RESAMPLE, SAMPLE_FREQ);
+    full.reset();
+
+    DraftSID draft;
+    draft.setChipModel(model);
+    draft.setSamplingParameters(CLOCK_FREQ, SAMPLE_FREQ);
+    draft.reset();
+
+    const std::vector<double> ref = render(full, regs);
+    const std::vector<double> test = render(draft, regs);
+
+    const double loudness = 20. * std::log10(rms(test) / rms(ref));
+    CHECK(std::fabs(loudness) < maxLoudnessDeviation);
+
+    const std::vector<double> refBands = bands(ref);
+    const std::vector<double> testBands = bands(test);
+
+    double peak = 0.;
+    for (double e: refBands)
+        peak = std::max(peak, e);
+
+    for (int b = 0; b < BANDS; b++)
+    {
+        // Ignore bands without meaningful content
+        if (refBands[b] < peak - 40.)
+            continue;
+
+        CHECK(std::fabs(testBands[b] - refBands[b]) < maxBandDeviation);
+    }
+}
+
+SUITE(DraftSID)
+{
+
+// 440Hz sawtooth, unfiltered
+const unsigned char sawtooth[0x19] =
+{
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xd6, 0x1c, 0x00, 0x00, 0x21, 0x00, 0xf0,
+    0x00, 0x00, 0x00, 0x0f
+};
+
+// 220Hz pulse through the lowpass filter
+const unsigned char pulse[0x19] =
+{
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x6b, 0x0e, 0x00, 0x08, 0x41, 0x00, 0xf0,
+    0x00, 0x80, 0x04, 0x1f
+};
+
+TEST(TestSawtooth6581)
+{
+    compare(MOS6581, sawtooth, 1., 2.);
+}
+
+TEST(TestSawtooth8580)
+{
+    compare(MOS8580, sawtooth, 1., 2.);
+}
+
+// The 6581 filter is the least accurate part of the draft model
+TEST(TestPulse6581)
+{
+    compare(MOS6581, pulse, 4., 8.);
+}
+
+TEST(TestPulse8580)
+{
+    compare(MOS8580, pulse, 1., 3.);
+}
+
+}
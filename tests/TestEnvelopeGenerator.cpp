@@ -142,4 +142,40 @@ TEST_FIXTURE(TestFixture, TestFlip00toFF)
     CHECK_EQUAL(0xff, (int)generator.readENV());
 }
 
+TEST(TestClockMultiple)
+{
+    // Skipping ahead must give the same result as clocking each cycle
+    reSIDfp::EnvelopeGenerator single;
+    reSIDfp::EnvelopeGenerator multiple;
+
+    single.reset();
+    multiple.reset();
+
+    const unsigned char writes[][2] =
+    {
+        { 0x33, 0x01 }, { 0x33, 0x01 }, { 0xa5, 0x00 }, { 0x0f, 0x01 }, { 0x00, 0x00 },
+    };
+
+    for (const auto& w: writes)
+    {
+        single.writeATTACK_DECAY(w[0]);
+        single.writeSUSTAIN_RELEASE(w[0]);
+        single.writeCONTROL_REG(w[1]);
+        multiple.writeATTACK_DECAY(w[0]);
+        multiple.writeSUSTAIN_RELEASE(w[0]);
+        multiple.writeCONTROL_REG(w[1]);
+
+        for (unsigned int n = 1; n < 400; n += 7)
+        {
+            for (unsigned int i = 0; i < n; i++)
+                single.clock();
+
+            multiple.clock(n);
+
+            CHECK_EQUAL((int)single.readENV(), (int)multiple.readENV());
+            CHECK_EQUAL(single.lfsr, multiple.lfsr);
+        }
+    }
+}
+
 }
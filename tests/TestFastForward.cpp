@@ -0,0 +1,158 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2025 Leandro Nini
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "utpp/utpp.h"
+
+#include "../src/sidplayfp/sidplayfp.h"
+#include "../src/sidplayfp/SidConfig.h"
+#include "../src/sidplayfp/SidTune.h"
+#include "../src/builders/residfp-builder/residfp.h"
+
+#include <stdint.h>
+#include <cstdlib>
+#include <vector>
+
+using namespace UnitTest;
+
+SUITE(FastForward)
+{
+
+// $1000: init, a sustained pulse of zero width on voice 1,
+// which outputs a constant level
+//   lda #$0f
+//   sta $d418
+//   lda #$00
+//   sta $d402
+//   lda #$f0
+//   sta $d406
+//   lda #$41
+//   sta $d404
+//   rts
+// $1015: play
+//   rts
+static const uint8_t code[] =
+{
+    0xa9, 0x0f, 0x8d, 0x18, 0xd4, 0xa9, 0x00, 0x8d, 0x02, 0xd4,
+    0xa9, 0xf0, 0x8d, 0x06, 0xd4, 0xa9, 0x41, 0x8d, 0x04, 0xd4,
+    0x60, 0x60
+};
+
+/// Samples played before and after the speed changes
+const uint_least32_t LENGTH = 4800;
+
+std::vector<uint8_t> makeTune()
+{
+    std::vector<uint8_t> psid(0x7c, 0);
+    psid[0] = 'P'; psid[1] = 'S'; psid[2] = 'I'; psid[3] = 'D';
+    psid[5] = 0x02;                     // version
+    psid[7] = 0x7c;                     // dataOffset
+    psid[10] = 0x10; psid[11] = 0x00;   // initAddress
+    psid[12] = 0x10; psid[13] = 0x15;   // playAddress
+    psid[15] = 0x01;                    // songs
+    psid[17] = 0x01;                    // startSong
+
+    psid.push_back(0x00);               // load address
+    psid.push_back(0x10);
+    psid.insert(psid.end(), code, code + sizeof(code));
+    return psid;
+}
+
+struct Engine
+{
+    sidplayfp engine;
+    ReSIDfpBuilder rs;
+    const std::vector<uint8_t> psid;
+    SidTune tune;
+
+    Engine() :
+        rs("TestFastForward"),
+        psid(makeTune()),
+        tune(psid.data(), static_cast<uint_least32_t>(psid.size()))
+    {
+        rs.create(1);
+
+        SidConfig cfg;
+        cfg.frequency = 48000;
+        cfg.playback = SidConfig::MONO;
+        cfg.samplingMethod = SidConfig::RESAMPLE_INTERPOLATE;
+        cfg.powerOnDelay = 0;
+        cfg.sidEmulation = &rs;
+        engine.config(cfg);
+
+        engine.load(&tune);
+    }
+
+    std::vector<short> play(uint_least32_t count)
+    {
+        std::vector<short> buffer(count);
+        CHECK_EQUAL(count, engine.play(buffer.data(), count));
+        return buffer;
+    }
+};
+
+TEST(TestSameSpeedKeepsResampler)
+{
+    Engine reference;
+    reference.play(LENGTH);
+    const std::vector<short> expected = reference.play(LENGTH);
+
+    Engine engine;
+    engine.play(LENGTH);
+    CHECK(engine.engine.fastForward(100));
+    const std::vector<short> actual = engine.play(LENGTH);
+
+    CHECK(expected == actual);
+}
+
+TEST(TestToggleKeepsResampler)
+{
+    Engine reference;
+    reference.play(LENGTH);
+    const std::vector<short> expected = reference.play(LENGTH);
+
+    Engine engine;
+    engine.play(LENGTH);
+    CHECK(engine.engine.fastForward(400));
+    CHECK(engine.engine.fastForward(100));
+    const std::vector<short> actual = engine.play(LENGTH);
+
+    CHECK(expected == actual);
+}
+
+TEST(TestResumeAfterFastForward)
+{
+    Engine engine;
+    const std::vector<short> before = engine.play(LENGTH);
+    const int level = before[LENGTH - 1];
+    CHECK(level > 1000);
+
+    CHECK(engine.engine.fastForward(400));
+    engine.play(LENGTH);
+    CHECK(engine.engine.fastForward(100));
+
+    // The level holds, with no fade in from silence
+    const std::vector<short> after = engine.play(LENGTH);
+    for (uint_least32_t i = 0; i < 256; i++)
+    {
+        CHECK(std::abs(after[i] - level) < level / 100);
+    }
+}
+
+}
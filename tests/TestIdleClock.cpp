@@ -0,0 +1,151 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2025 Leandro Nini
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "utpp/utpp.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#define private public
+
+#include "../src/builders/residfp-builder/residfp/SID.h"
+
+#undef private
+
+using namespace UnitTest;
+using namespace reSIDfp;
+
+#define CLOCK_FREQ 985248.
+
+SUITE(IdleClock)
+{
+
+/// Cycles clocked per call
+const unsigned int CHUNK = 1000;
+
+/**
+ * Two chips playing the same register writes,
+ * one allowed to take the idle path and one
+ * kept in the full clock loop.
+ */
+struct Chips
+{
+    SID idle;
+    SID full;
+
+    std::vector<short> idleBuf;
+    std::vector<short> fullBuf;
+
+    bool wasIdle;
+
+    Chips(ChipModel model, SamplingMethod method, double sampleFreq) :
+        idleBuf(CHUNK),
+        fullBuf(CHUNK),
+        wasIdle(false)
+    {
+        for (SID* sid: { &idle, &full })
+        {
+            sid->setChipModel(model);
+            sid->setSamplingParameters(CLOCK_FREQ, method, sampleFreq);
+            sid->reset();
+        }
+
+        // Pretend the envelope DAC leaks, so the voices never count as silent
+        full.silentEnvDAC = false;
+    }
+
+    void write(int offset, unsigned char value)
+    {
+        idle.write(offset, value);
+        full.write(offset, value);
+    }
+
+    /**
+     * Clock both chips and compare every output sample.
+     */
+    bool clock(unsigned int cycles)
+    {
+        for (unsigned int i = 0; i < cycles; i += CHUNK)
+        {
+            const int n = idle.clock(CHUNK, idleBuf.data());
+            wasIdle |= idle.idle;
+
+            if (full.clock(CHUNK, fullBuf.data()) != n)
+                return false;
+
+            if (!std::equal(idleBuf.begin(), idleBuf.begin() + n, fullBuf.begin()))
+                return false;
+        }
+
+        CHECK(!full.idle);
+        return true;
+    }
+};
+
+/*
+ * Play a filtered note, release it and let the filter settle
+ * in silence, then start a new note.
+ */
+static void check(ChipModel model, SamplingMethod method, double sampleFreq)
+{
+    Chips chips(model, method, sampleFreq);
+
+    chips.write(0x00, 0x00);
+    chips.write(0x01, 0x1c);
+    chips.write(0x05, 0x00);
+    chips.write(0x06, 0xf0);
+    chips.write(0x15, 0x03);
+    chips.write(0x16, 0x40);
+    chips.write(0x17, 0xf1);
+    chips.write(0x18, 0x1f);
+    chips.write(0x04, 0x21);
+
+    CHECK(chips.clock(100000));
+    CHECK(!chips.wasIdle);
+
+    // Gate off, fast release
+    chips.write(0x04, 0x20);
+    CHECK(chips.clock(2000000));
+    CHECK(chips.wasIdle);
+    CHECK(chips.idle.idle);
+
+    // Resume the sound
+    chips.write(0x04, 0x21);
+    CHECK(!chips.idle.idle);
+    CHECK(chips.clock(100000));
+}
+
+TEST(TestIdle8580PassThrough)
+{
+    check(MOS8580, DECIMATE, CLOCK_FREQ);
+}
+
+TEST(TestIdle8580Resample)
+{
+    check(MOS8580, RESAMPLE, 48000.);
+}
+
+TEST(TestIdle6581Resample)
+{
+    check(MOS6581, RESAMPLE, 48000.);
+}
+
+}
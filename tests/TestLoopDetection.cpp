@@ -0,0 +1,184 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2025 Leandro Nini
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "utpp/utpp.h"
+
+#include "../src/sidplayfp/sidplayfp.h"
+#include "../src/sidplayfp/SidConfig.h"
+#include "../src/sidplayfp/SidTune.h"
+#include "../src/sidplayfp/TuneLength.h"
+#include "../src/builders/residfp-builder/residfp.h"
+
+#include <stdint.h>
+#include <vector>
+
+using namespace UnitTest;
+
+SUITE(LoopDetection)
+{
+
+/// PAL frame length in milliseconds
+const double FRAME_MS = 19656. * 1000. / 985248.;
+
+// $1000: init
+//   lda #$0f
+//   sta $d418
+//   lda #$00
+//   sta $fb
+//   rts
+static const uint8_t init[] =
+{
+    0xa9, 0x0f, 0x8d, 0x18, 0xd4, 0xa9, 0x00, 0x85, 0xfb, 0x60
+};
+
+// $100a: play, the pitch follows a counter repeating every 64 frames
+//   inc $fb
+//   lda $fb
+//   and #$3f
+//   sta $fb
+//   sta $d401
+//   lda #$11
+//   sta $d404
+//   lda #$f0
+//   sta $d406
+//   rts
+static const uint8_t loopPlay[] =
+{
+    0xe6, 0xfb, 0xa5, 0xfb, 0x29, 0x3f, 0x85, 0xfb, 0x8d, 0x01, 0xd4,
+    0xa9, 0x11, 0x8d, 0x04, 0xd4, 0xa9, 0xf0, 0x8d, 0x06, 0xd4, 0x60
+};
+
+// $100a: play, a note for 100 frames then the gate is released
+//   lda $fb
+//   cmp #$64
+//   bcs off
+//   inc $fb
+//   lda #$11
+//   sta $d404
+//   lda #$f0
+//   sta $d406
+//   rts
+// off:
+//   lda #$10
+//   sta $d404
+//   rts
+static const uint8_t endPlay[] =
+{
+    0xa5, 0xfb, 0xc9, 0x64, 0xb0, 0x0d, 0xe6, 0xfb, 0xa9, 0x11, 0x8d, 0x04,
+    0xd4, 0xa9, 0xf0, 0x8d, 0x06, 0xd4, 0x60, 0xa9, 0x10, 0x8d, 0x04, 0xd4, 0x60
+};
+
+// $100a: play, a jam instruction
+static const uint8_t jamPlay[] =
+{
+    0x02
+};
+
+std::vector<uint8_t> makeTune(const uint8_t* play, size_t playSize)
+{
+    std::vector<uint8_t> psid(0x7c, 0);
+    psid[0] = 'P'; psid[1] = 'S'; psid[2] = 'I'; psid[3] = 'D';
+    psid[5] = 0x02;                     // version
+    psid[7] = 0x7c;                     // dataOffset
+    psid[10] = 0x10; psid[11] = 0x00;   // initAddress
+    psid[12] = 0x10; psid[13] = 0x0a;   // playAddress
+    psid[15] = 0x01;                    // songs
+    psid[17] = 0x01;                    // startSong
+
+    psid.push_back(0x00);               // load address
+    psid.push_back(0x10);
+    psid.insert(psid.end(), init, init + sizeof(init));
+    psid.insert(psid.end(), play, play + playSize);
+    return psid;
+}
+
+struct Engine
+{
+    sidplayfp engine;
+    ReSIDfpBuilder rs;
+
+    Engine() :
+        rs("TestLoopDetection")
+    {
+        rs.create(1);
+
+        SidConfig cfg;
+        cfg.sidEmulation = &rs;
+        engine.config(cfg);
+    }
+
+    TuneLength detect(const uint8_t* play, size_t playSize, uint_least32_t silenceMs)
+    {
+        const std::vector<uint8_t> psid = makeTune(play, playSize);
+        SidTune tune(psid.data(), static_cast<uint_least32_t>(psid.size()));
+        engine.load(&tune);
+
+        TuneLength result;
+        CHECK(engine.detectLength(60000, silenceMs, result));
+        CHECK_EQUAL(0u, engine.timeMs());
+
+        engine.load(nullptr);
+        return result;
+    }
+};
+
+TEST_FIXTURE(Engine, TestLoop)
+{
+    const TuneLength result = detect(loopPlay, sizeof(loopPlay), 3000);
+
+    CHECK_EQUAL(TuneLength::LOOP, result.end);
+    CHECK_CLOSE(64. * FRAME_MS, result.loopLength, FRAME_MS);
+    CHECK(result.loopStart < 3 * FRAME_MS);
+    CHECK_EQUAL(result.loopStart + result.loopLength, result.endMs);
+}
+
+TEST_FIXTURE(Engine, TestSilence)
+{
+    const TuneLength result = detect(endPlay, sizeof(endPlay), 3000);
+
+    CHECK_EQUAL(TuneLength::SILENCE, result.end);
+    CHECK_CLOSE(100. * FRAME_MS, result.endMs, 3 * FRAME_MS);
+}
+
+TEST_FIXTURE(Engine, TestStaticEnd)
+{
+    // Without silence detection the tune ends in a one frame loop
+    const TuneLength result = detect(endPlay, sizeof(endPlay), 0);
+
+    CHECK_EQUAL(TuneLength::LOOP, result.end);
+    CHECK_CLOSE(FRAME_MS, result.loopLength, 1.);
+    CHECK_CLOSE(100. * FRAME_MS, result.loopStart, 3 * FRAME_MS);
+}
+
+TEST_FIXTURE(Engine, TestStopped)
+{
+    const TuneLength result = detect(jamPlay, sizeof(jamPlay), 3000);
+
+    CHECK_EQUAL(TuneLength::STOPPED, result.end);
+    CHECK(result.endMs < 100);
+}
+
+TEST_FIXTURE(Engine, TestNoTune)
+{
+    TuneLength result;
+    CHECK(!engine.detectLength(60000, 3000, result));
+}
+
+}
@@ -0,0 +1,166 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2025 Leandro Nini
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "utpp/utpp.h"
+
+#include <cmath>
+#include <cstdlib>
+
+#include "../src/builders/residfp-builder/residfp/MultiSID.h"
+#include "../src/builders/residfp-builder/residfp/SID.h"
+
+using namespace UnitTest;
+using namespace reSIDfp;
+
+#define CLOCK_FREQ 985248.
+#define SAMPLE_FREQ 44100.
+
+SUITE(MultiSID)
+{
+
+static void setup(SID& sid, int n)
+{
+    sid.reset();
+
+    sid.write(0x00, 0x34 + n * 0x11);
+    sid.write(0x01, 0x12 + n);
+    sid.write(0x03, 0x08);
+    sid.write(0x05, 0x00);
+    sid.write(0x06, 0xf0);
+    sid.write(0x04, 0x41);
+    sid.write(0x07, 0x55);
+    sid.write(0x08, 0x05 + n);
+    sid.write(0x0d, 0xa0);
+    sid.write(0x0b, 0x21);
+    sid.write(0x15, 0x07);
+    sid.write(0x16, 0x40);
+    sid.write(0x17, 0xf1);
+    sid.write(0x18, 0x1f);
+}
+
+/*
+ * The chips mixed before resampling must give
+ * the same output as mixing them afterwards.
+ */
+static void check(unsigned int chips, unsigned int channels, SamplingMethod method)
+{
+    static const float matrix[2][2][3] =
+    {
+        { { 1.f, 1.f, 0.f }, { 0.f, 0.f, 0.f } },
+        { { 1.f, 0.5f, 0.f }, { 0.5f, 1.f, 0.f } },
+    };
+
+    const float scale = 1.f / std::sqrt(static_cast<float>(chips));
+
+    float gains[2 * 3];
+    for (unsigned int ch = 0; ch < channels; ch++)
+        for (unsigned int i = 0; i < chips; i++)
+            gains[ch * chips + i] = matrix[channels - 1][ch][i] * scale;
+
+    SID single[3];
+    short singleBuf[3][3000];
+    int n = 0;
+
+    for (unsigned int i = 0; i < chips; i++)
+    {
+        single[i].setChipModel(i == 0 ? MOS6581 : MOS8580);
+        single[i].setSamplingParameters(CLOCK_FREQ, method, SAMPLE_FREQ);
+        setup(single[i], i);
+        n = single[i].clock(60000, singleBuf[i]);
+    }
+
+    SID grouped[3];
+    SID* sids[3];
+
+    for (unsigned int i = 0; i < chips; i++)
+    {
+        grouped[i].setChipModel(i == 0 ? MOS6581 : MOS8580);
+        sids[i] = &grouped[i];
+    }
+
+    MultiSID multiSID;
+    multiSID.setChips(sids, chips, gains, channels);
+    multiSID.setSamplingParameters(CLOCK_FREQ, method, SAMPLE_FREQ);
+
+    for (unsigned int i = 0; i < chips; i++)
+        setup(grouped[i], i);
+
+    short groupBuf[2][3000];
+    short* buf[2] = { groupBuf[0], groupBuf[1] };
+
+    // Clock in uneven chunks
+    int m = multiSID.clock(12345, buf);
+    buf[0] += m;
+    buf[1] += m;
+    m += multiSID.clock(60000 - 12345, buf);
+
+    CHECK_EQUAL(n, m);
+
+    int maxDiff = 0;
+    for (unsigned int ch = 0; ch < channels; ch++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            float expected = 0.f;
+            for (unsigned int i = 0; i < chips; i++)
+                expected += gains[ch * chips + i] * singleBuf[i][j];
+
+            const int diff = std::abs(static_cast<int>(expected) - groupBuf[ch][j]);
+            if (diff > maxDiff)
+                maxDiff = diff;
+        }
+    }
+
+    // Within the resamplers' fixed point rounding
+    CHECK(maxDiff <= 8);
+}
+
+TEST(TestMonoTwoChips)
+{
+    check(2, 1, RESAMPLE);
+}
+
+TEST(TestStereoThreeChips)
+{
+    check(3, 2, RESAMPLE);
+}
+
+TEST(TestDecimate)
+{
+    check(3, 1, DECIMATE);
+}
+
+TEST(TestTooManyChips)
+{
+    SID sid;
+    SID* sids[MultiSID::MAX_CHIPS + 1];
+    float gains[MultiSID::MAX_CHIPS + 1];
+
+    for (unsigned int i = 0; i <= MultiSID::MAX_CHIPS; i++)
+    {
+        sids[i] = &sid;
+        gains[i] = 1.f;
+    }
+
+    MultiSID multiSID;
+    CHECK_THROW(multiSID.setChips(sids, MultiSID::MAX_CHIPS + 1, gains, 1), SIDError);
+}
+
+}
@@ -0,0 +1,133 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2025 Leandro Nini
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "utpp/utpp.h"
+
+#include <cmath>
+#include <vector>
+
+#include "../src/builders/residfp-builder/residfp/SID.h"
+
+using namespace UnitTest;
+using namespace reSIDfp;
+
+#define CLOCK_FREQ 985248.
+#define SAMPLE_FREQ 44100.
+
+SUITE(OscillatorEvents)
+{
+
+struct EventsFixture
+{
+    SID sid;
+    short buf[44100];
+
+    EventsFixture()
+    {
+        sid.setSamplingParameters(CLOCK_FREQ, DECIMATE, SAMPLE_FREQ);
+        sid.reset();
+        sid.enableOscillatorEvents(true);
+    }
+
+    std::vector<OscillatorEvent> read()
+    {
+        std::vector<OscillatorEvent> events(OscillatorEventBuffer::SIZE);
+        events.resize(sid.getOscillatorEvents()->read(events.data(), events.size()));
+        return events;
+    }
+};
+
+TEST(TestDisabled)
+{
+    SID sid;
+    CHECK(sid.getOscillatorEvents() == nullptr);
+}
+
+TEST_FIXTURE(EventsFixture, TestMsbRising)
+{
+    // voice 1 at freq 0x1000, MSB goes high every 4096 cycles
+    sid.write(0x00, 0x00);
+    sid.write(0x01, 0x10);
+    sid.write(0x04, 0x20);
+
+    int samples = 0;
+    for (int i = 0; i < 100; i++)
+        samples += sid.clock(1000, buf + samples);
+
+    const std::vector<OscillatorEvent> events = read();
+
+    CHECK(std::abs(static_cast<int>(events.size()) - 100000 / 4096) <= 1);
+
+    const double period = 4096. * SAMPLE_FREQ / CLOCK_FREQ;
+
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        CHECK_EQUAL(0, (int)events[i].voice);
+        CHECK_EQUAL((int)OscillatorEvent::MSB_RISING, (int)events[i].type);
+        CHECK(events[i].sample <= static_cast<unsigned int>(samples));
+
+        if (i > 0)
+            CHECK(std::fabs(events[i].sample - events[i - 1].sample - period) <= 2.);
+    }
+}
+
+TEST_FIXTURE(EventsFixture, TestSync)
+{
+    // voice 2 synced to voice 1
+    sid.write(0x00, 0x00);
+    sid.write(0x01, 0x10);
+    sid.write(0x04, 0x20);
+    sid.write(0x07, 0x00);
+    sid.write(0x08, 0x30);
+    sid.write(0x0b, 0x22);
+
+    int samples = 0;
+    for (int i = 0; i < 10; i++)
+        samples += sid.clock(1000, buf + samples);
+
+    int syncs = 0;
+    for (const OscillatorEvent& e: read())
+    {
+        if (e.type == OscillatorEvent::SYNC)
+        {
+            CHECK_EQUAL(1, (int)e.voice);
+            syncs++;
+        }
+    }
+
+    CHECK(std::abs(syncs - 10000 / 4096) <= 1);
+}
+
+TEST_FIXTURE(EventsFixture, TestTestBit)
+{
+    sid.clock(1000, buf);
+    sid.write(0x04, 0x08);
+    sid.clock(1000, buf);
+    sid.write(0x04, 0x00);
+
+    const std::vector<OscillatorEvent> events = read();
+
+    CHECK_EQUAL(2, (int)events.size());
+    CHECK_EQUAL((int)OscillatorEvent::TEST_SET, (int)events[0].type);
+    CHECK_EQUAL((int)OscillatorEvent::TEST_CLEARED, (int)events[1].type);
+    CHECK(events[1].sample > events[0].sample);
+}
+
+}
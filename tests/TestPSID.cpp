@@ -24,6 +24,7 @@
 #include "../src/sidplayfp/SidTuneInfo.h"
 
 #include <stdint.h>
+#include <cstdio>
 #include <cstring>
 
 #define BUFFERSIZE 128
@@ -96,6 +97,186 @@ TEST_FIXTURE(TestFixture, TestLoadOk)
     CHECK_EQUAL("No errors", tune.statusString());
 }
 
+/*
+ * Check that a borrowed buffer is parsed in place.
+ */
+TEST_FIXTURE(TestFixture, TestBorrowOk)
+{
+    SidTune copied(data, BUFFERSIZE);
+    SidTune borrowed(data, BUFFERSIZE, true);
+    CHECK(borrowed.getStatus());
+
+    // Data offset plus the load address
+    CHECK(borrowed.c64Data() == data + 0x7E);
+    CHECK(copied.c64Data() != data + 0x7E);
+
+    char md5[SidTune::MD5_LENGTH + 1];
+    char md5Borrowed[SidTune::MD5_LENGTH + 1];
+    CHECK_EQUAL(copied.createMD5New(md5), borrowed.createMD5New(md5Borrowed));
+}
+
+/*
+ * Check that a borrowed buffer reports the same errors.
+ */
+TEST_FIXTURE(TestFixture, TestBorrowError)
+{
+    data[VERSION_LO] = 0x01;
+
+    SidTune tune(data, BUFFERSIZE, true);
+    CHECK(!tune.getStatus());
+
+    CHECK_EQUAL("Unsupported RSID version", tune.statusString());
+}
+
+/*
+ * Check that a mapped file loads like a regular one.
+ */
+TEST_FIXTURE(TestFixture, TestLoadMappedOk)
+{
+    const char fileName[] = "TestPSID.sid";
+
+    FILE* f = fopen(fileName, "wb");
+    fwrite(data, 1, BUFFERSIZE, f);
+    fclose(f);
+
+    SidTune loaded(fileName);
+    SidTune mapped(nullptr);
+    mapped.loadMapped(fileName);
+    remove(fileName);
+
+    CHECK(mapped.getStatus());
+    CHECK_EQUAL(loaded.getInfo()->dataFileLen(), mapped.getInfo()->dataFileLen());
+
+    char md5[SidTune::MD5_LENGTH + 1];
+    char md5Mapped[SidTune::MD5_LENGTH + 1];
+    CHECK_EQUAL(loaded.createMD5(md5), mapped.createMD5(md5Mapped));
+}
+
+/*
+ * Check that a tune received in chunks loads like a buffer.
+ */
+TEST_FIXTURE(TestFixture, TestReadChunksOk)
+{
+    SidTune tune(nullptr);
+    tune.beginRead();
+
+    // Header size of version 2 plus the load address
+    CHECK_EQUAL(6u, tune.readChunk(data, 0));
+    CHECK_EQUAL(126u - 7u, tune.readChunk(data, 7));
+
+    // Data offset plus load address plus one byte of data
+    CHECK_EQUAL(127u - 126u, tune.readChunk(data + 7, 119));
+    CHECK_EQUAL(0u, tune.readChunk(data + 126, BUFFERSIZE - 126));
+
+    tune.endRead();
+    CHECK(tune.getStatus());
+
+    SidTune copied(data, BUFFERSIZE);
+    CHECK_EQUAL(copied.getInfo()->loadAddr(), tune.getInfo()->loadAddr());
+
+    char md5[SidTune::MD5_LENGTH + 1];
+    char md5Read[SidTune::MD5_LENGTH + 1];
+    CHECK_EQUAL(copied.createMD5New(md5), tune.createMD5New(md5Read));
+}
+
+/*
+ * Check that an invalid header is rejected before the data arrives.
+ */
+TEST_FIXTURE(TestFixture, TestReadChunksBadHeader)
+{
+    data[VERSION_LO] = 0x01;
+
+    SidTune tune(nullptr);
+    tune.beginRead();
+    tune.readChunk(data, 6);
+    CHECK(tune.getStatus());
+
+    CHECK_EQUAL(0u, tune.readChunk(data + 6, 120));
+    CHECK(!tune.getStatus());
+    CHECK_EQUAL("Unsupported RSID version", tune.statusString());
+
+    tune.endRead();
+    CHECK(!tune.getStatus());
+}
+
+/*
+ * Check that an unknown format is rejected from the magic ID.
+ */
+TEST_FIXTURE(TestFixture, TestReadChunksBadMagic)
+{
+    data[0] = 0x00;
+
+    SidTune tune(nullptr);
+    tune.beginRead();
+    tune.readChunk(data, 4);
+    CHECK(!tune.getStatus());
+}
+
+/*
+ * Check that a truncated stream fails to load.
+ */
+TEST_FIXTURE(TestFixture, TestReadChunksTruncated)
+{
+    SidTune tune(nullptr);
+    tune.beginRead();
+    tune.readChunk(data, 100);
+    tune.endRead();
+    CHECK(!tune.getStatus());
+
+    tune.beginRead();
+    tune.readChunk(data, 126);
+    tune.endRead();
+    CHECK(!tune.getStatus());
+}
+
+/*
+ * Check that batch hashing matches the single tune methods.
+ */
+TEST_FIXTURE(TestFixture, TestMD5Batch)
+{
+    uint8_t ntsc[BUFFERSIZE];
+    memcpy(ntsc, data, BUFFERSIZE);
+    ntsc[FLAGS] = 0x08;
+    ntsc[SONGS_LO] = 0x03;
+
+    uint8_t large[BUFFERSIZE + 300];
+    memcpy(large, data, BUFFERSIZE);
+    for (unsigned int i = BUFFERSIZE; i < sizeof(large); i++)
+        large[i] = i;
+
+    SidTune tunes[] = {
+        { data, BUFFERSIZE },
+        { ntsc, BUFFERSIZE },
+        { large, sizeof(large) },
+        { nullptr },
+    };
+    const unsigned int count = sizeof(tunes) / sizeof(tunes[0]);
+
+    char md5[count][SidTune::MD5_LENGTH + 1];
+    char md5New[count][SidTune::MD5_LENGTH + 1];
+    SidTune* tunePtr[count];
+    char* md5Ptr[count];
+    char* md5NewPtr[count];
+    for (unsigned int i = 0; i < count; i++)
+    {
+        tunePtr[i] = &tunes[i];
+        md5Ptr[i] = md5[i];
+        md5NewPtr[i] = md5New[i];
+    }
+
+    SidTune::createMD5Batch(tunePtr, count, md5Ptr, md5NewPtr);
+
+    for (unsigned int i = 0; i < count - 1; i++)
+    {
+        char expected[SidTune::MD5_LENGTH + 1];
+        CHECK_EQUAL(tunes[i].createMD5(expected), md5[i]);
+        CHECK_EQUAL(tunes[i].createMD5New(expected), md5New[i]);
+    }
+
+    CHECK_EQUAL("", md5[count - 1]);
+    CHECK_EQUAL("", md5New[count - 1]);
+}
+
 /*
  * Version must be at least 2 for RSID files.
  */
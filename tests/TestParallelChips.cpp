@@ -0,0 +1,148 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2025 Leandro Nini
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "utpp/utpp.h"
+
+#include "../src/sidplayfp/sidplayfp.h"
+#include "../src/sidplayfp/SidConfig.h"
+#include "../src/sidplayfp/SidTune.h"
+#include "../src/builders/residfp-builder/residfp.h"
+
+#include <stdint.h>
+#include <vector>
+
+using namespace UnitTest;
+
+SUITE(ParallelChips)
+{
+
+// $1000: init, a sustained note on each chip
+//   lda #$0f
+//   sta $d418
+//   sta $d438
+//   sta $d458
+//   lda #$f0
+//   sta $d406
+//   sta $d426
+//   sta $d446
+//   lda #$21
+//   sta $d404
+//   lda #$41
+//   sta $d424
+//   lda #$11
+//   sta $d444
+//   rts
+static const uint8_t init[] =
+{
+    0xa9, 0x0f, 0x8d, 0x18, 0xd4, 0x8d, 0x38, 0xd4, 0x8d, 0x58, 0xd4,
+    0xa9, 0xf0, 0x8d, 0x06, 0xd4, 0x8d, 0x26, 0xd4, 0x8d, 0x46, 0xd4,
+    0xa9, 0x21, 0x8d, 0x04, 0xd4, 0xa9, 0x41, 0x8d, 0x24, 0xd4,
+    0xa9, 0x11, 0x8d, 0x44, 0xd4, 0x60
+};
+
+// $1026: play, sweeps the pitches and modulates the pulse width
+// of the second chip with the OSC3 reading of the first one
+//   inc $fb
+//   lda $fb
+//   sta $d401
+//   sta $d421
+//   eor #$ff
+//   sta $d441
+//   lda $d41b
+//   sta $d423
+//   rts
+static const uint8_t play[] =
+{
+    0xe6, 0xfb, 0xa5, 0xfb, 0x8d, 0x01, 0xd4, 0x8d, 0x21, 0xd4,
+    0x49, 0xff, 0x8d, 0x41, 0xd4, 0xad, 0x1b, 0xd4, 0x8d, 0x23, 0xd4, 0x60
+};
+
+/// Samples rendered for each configuration
+const uint_least32_t LENGTH = 48000;
+
+/// Samples rendered per call
+const uint_least32_t CHUNK = 1000;
+
+std::vector<uint8_t> makeTune(unsigned int chips)
+{
+    std::vector<uint8_t> psid(0x7c, 0);
+    psid[0] = 'P'; psid[1] = 'S'; psid[2] = 'I'; psid[3] = 'D';
+    psid[5] = chips == 3 ? 0x04 : 0x03; // version
+    psid[7] = 0x7c;                     // dataOffset
+    psid[10] = 0x10; psid[11] = 0x00;   // initAddress
+    psid[12] = 0x10; psid[13] = 0x26;   // playAddress
+    psid[15] = 0x01;                    // songs
+    psid[17] = 0x01;                    // startSong
+    psid[0x7a] = 0x42;                  // secondSIDAddress
+    if (chips == 3)
+        psid[0x7b] = 0x44;              // thirdSIDAddress
+
+    psid.push_back(0x00);               // load address
+    psid.push_back(0x10);
+    psid.insert(psid.end(), init, init + sizeof(init));
+    psid.insert(psid.end(), play, play + sizeof(play));
+    return psid;
+}
+
+std::vector<short> render(unsigned int chips, SidConfig::playback_t playback, bool parallel)
+{
+    sidplayfp engine;
+    ReSIDfpBuilder rs("TestParallelChips");
+    rs.create(chips);
+
+    SidConfig cfg;
+    cfg.frequency = 48000;
+    cfg.playback = playback;
+    cfg.powerOnDelay = 0;
+    cfg.parallelChips = parallel;
+    cfg.sidEmulation = &rs;
+    CHECK(engine.config(cfg));
+
+    const std::vector<uint8_t> psid = makeTune(chips);
+    SidTune tune(psid.data(), static_cast<uint_least32_t>(psid.size()));
+    CHECK(engine.load(&tune));
+    CHECK_EQUAL(chips, rs.usedDevices());
+
+    std::vector<short> buffer(LENGTH);
+    for (uint_least32_t i = 0; i < LENGTH; i += CHUNK)
+    {
+        CHECK_EQUAL(CHUNK, engine.play(buffer.data() + i, CHUNK));
+    }
+
+    return buffer;
+}
+
+TEST(TestTwoChipsMono)
+{
+    const std::vector<short> serial = render(2, SidConfig::MONO, false);
+    const std::vector<short> parallel = render(2, SidConfig::MONO, true);
+
+    CHECK(serial == parallel);
+}
+
+TEST(TestThreeChipsStereo)
+{
+    const std::vector<short> serial = render(3, SidConfig::STEREO, false);
+    const std::vector<short> parallel = render(3, SidConfig::STEREO, true);
+
+    CHECK(serial == parallel);
+}
+
+}
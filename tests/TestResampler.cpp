@@ -23,6 +23,8 @@
 #define private public
 
 #include "../src/builders/residfp-builder/residfp/resample/Resampler.h"
+#include "../src/builders/residfp-builder/residfp/resample/TwoPassSincResampler.h"
+#include "../src/builders/residfp-builder/residfp/resample/SincResampler.cpp"
 
 #include <limits>
 
@@ -41,4 +43,41 @@ TEST(TestSoftClip)
     CHECK(Resampler::softClipImpl(std::numeric_limits<int>::min()+1) >= -32768);
 }
 
+TEST(TestIntegerRatio)
+{
+    std::unique_ptr<TwoPassSincResampler> r(TwoPassSincResampler::create(985248., 985248. / 20.));
+
+    // Both passes use exact phases
+    CHECK(r->s1->phases == 1);
+    CHECK(r->s2->phases != 0);
+
+    // Let the filters settle
+    for (int i = 0; i < 20 * 1000; i++)
+        r->input(10000);
+
+    int outputs = 0;
+    int last = 0;
+
+    for (int i = 0; i < 20 * 1000; i++)
+    {
+        if (r->input(10000))
+        {
+            outputs++;
+            last = r->output();
+        }
+    }
+
+    // Exactly one output every 20 cycles
+    CHECK_EQUAL(1000, outputs);
+    CHECK(std::abs(last - 10000) < 10);
+}
+
+TEST(TestArbitraryRatio)
+{
+    std::unique_ptr<TwoPassSincResampler> r(TwoPassSincResampler::create(985248., 44100.));
+
+    CHECK(r->s1->phases == 0);
+    CHECK(r->s2->phases == 0);
+}
+
 }
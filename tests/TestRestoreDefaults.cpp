@@ -0,0 +1,94 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2025 Leandro Nini
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "utpp/utpp.h"
+
+#include "../src/builders/residfp-builder/residfp/SID.h"
+
+using namespace UnitTest;
+using namespace reSIDfp;
+
+#define CLOCK_FREQ 985248.
+#define SAMPLE_FREQ 44100.
+
+SUITE(RestoreDefaults)
+{
+
+static void play(SID& sid, int n, short* buf)
+{
+    sid.reset();
+
+    sid.write(0x00, 0x34 + n * 0x11);
+    sid.write(0x01, 0x12 + n);
+    sid.write(0x03, 0x08);
+    sid.write(0x06, 0xf0);
+    sid.write(0x04, 0x41);
+    sid.write(0x0d, 0xa0);
+    sid.write(0x0b, 0x21);
+    sid.write(0x16, 0x40);
+    sid.write(0x17, 0xf7);
+    sid.write(0x18, 0x1f);
+
+    sid.clock(20000, buf);
+}
+
+/*
+ * A chip brought back to its defaults must play
+ * exactly like a new one.
+ */
+static void check(ChipModel model)
+{
+    short expected[1000];
+    short actual[1000];
+
+    SID fresh;
+    fresh.setChipModel(model);
+    fresh.setSamplingParameters(CLOCK_FREQ, RESAMPLE, SAMPLE_FREQ);
+    play(fresh, 0, expected);
+
+    SID used;
+    used.setChipModel(model);
+    used.setSamplingParameters(CLOCK_FREQ, RESAMPLE, SAMPLE_FREQ);
+    used.setFilter6581Curve(0.9);
+    used.setFilter6581Range(0.1);
+    used.setFilter8580Curve(0.2);
+    used.setCombinedWaveforms(STRONG);
+    used.enableStateSnapshots(100);
+    play(used, 1, actual);
+    used.sidvis(0x12, true, true, false);
+
+    used.restoreDefaults();
+    play(used, 0, actual);
+
+    CHECK(used.getStateSnapshots() == nullptr);
+    CHECK_ARRAY_EQUAL(expected, actual, 880);
+}
+
+TEST(Test6581)
+{
+    check(MOS6581);
+}
+
+TEST(Test8580)
+{
+    check(MOS8580);
+}
+
+}
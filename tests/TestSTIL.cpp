@@ -0,0 +1,186 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2025 Leandro Nini
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "utpp/utpp.h"
+
+#include "../src/utils/STILview/stil.h"
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace UnitTest;
+
+SUITE(STIL)
+{
+
+#define STIL_FILE "/TestSTIL.stil"
+#define BUG_FILE "/TestSTIL.bug"
+
+static const char stilText[] =
+    "#  STIL v3.10\r\n"
+    "\r\n"
+    "### /DEMOS/ ###\r\n"
+    "/DEMOS/\r\n"
+    "COMMENT: Section comment\r\n"
+    "\r\n"
+    "/DEMOS/Multi.sid\r\n"
+    "COMMENT: File comment\r\n"
+    "(#1)\r\n"
+    "   TITLE: One\r\n"
+    "  ARTIST: A\r\n"
+    "(#2)\r\n"
+    "   TITLE: Two\r\n"
+    "  AUTHOR: B\r\n"
+    "\r\n"
+    "/DEMOS/Single.sid\r\n"
+    "   NAME: Single\r\n"
+    " COMMENT: Just one\r\n";
+
+static const char bugText[] =
+    "/DEMOS/Multi.sid\n"
+    "(#2)\n"
+    "BUG: Wrong speed\n";
+
+static void writeFile(const char* name, const char* text)
+{
+    FILE* f = fopen(name, "wb");
+    fputs(text, f);
+    fclose(f);
+}
+
+struct Stil
+{
+    STIL stil;
+
+    Stil() :
+        stil(STIL_FILE, BUG_FILE)
+    {
+        writeFile("." STIL_FILE, stilText);
+        writeFile("." BUG_FILE, bugText);
+
+        stil.setBaseDir(".");
+    }
+
+    ~Stil()
+    {
+        remove("." STIL_FILE);
+        remove("." BUG_FILE);
+    }
+};
+
+TEST(TestMissingFile)
+{
+    STIL stil("/TestSTIL.missing", BUG_FILE);
+
+    CHECK(!stil.setBaseDir("."));
+    CHECK_EQUAL(STIL::STIL_OPEN, stil.getError());
+    CHECK(stil.getEntry("/DEMOS/Multi.sid") == nullptr);
+}
+
+TEST_FIXTURE(Stil, TestVersion)
+{
+    CHECK_CLOSE(3.10f, stil.getSTILVersionNo(), 0.001f);
+}
+
+TEST_FIXTURE(Stil, TestEntry)
+{
+    CHECK_EQUAL("   NAME: Single\n COMMENT: Just one\n", stil.getEntry("/DEMOS/Single.sid"));
+    CHECK_EQUAL("COMMENT: Just one\n", stil.getEntry("/DEMOS/Single.sid", 1, STIL::comment));
+    CHECK_EQUAL("COMMENT: File comment\n", stil.getEntry("/DEMOS/Multi.sid", 0, STIL::comment));
+    CHECK_EQUAL("   TITLE: Two\n  AUTHOR: B\n", stil.getEntry("/DEMOS/Multi.sid", 2));
+    CHECK_EQUAL(" ARTIST: A\n", stil.getEntry("/DEMOS/Multi.sid", 1, STIL::artist));
+    CHECK(stil.getEntry("/DEMOS/Multi.sid", 3) == nullptr);
+}
+
+TEST_FIXTURE(Stil, TestMissingEntry)
+{
+    CHECK(stil.getEntry("/DEMOS/Multi") == nullptr);
+    CHECK_EQUAL(STIL::NOT_IN_STIL, stil.getError());
+
+    CHECK(stil.getEntry("/DEMOS/") == nullptr);
+    CHECK_EQUAL(STIL::WRONG_ENTRY, stil.getError());
+}
+
+TEST_FIXTURE(Stil, TestGlobalComment)
+{
+    CHECK_EQUAL("COMMENT: Section comment\n", stil.getGlobalComment("/DEMOS/Single.sid"));
+}
+
+TEST_FIXTURE(Stil, TestBug)
+{
+    CHECK_EQUAL("BUG: Wrong speed\n", stil.getBug("/DEMOS/Multi.sid", 2));
+    CHECK(stil.getBug("/DEMOS/Multi.sid", 1) == nullptr);
+
+    CHECK(stil.getBug("/DEMOS/Single.sid") == nullptr);
+    CHECK_EQUAL(STIL::NOT_IN_BUG, stil.getError());
+}
+
+TEST_FIXTURE(Stil, TestConstLookup)
+{
+    const STIL& shared = stil;
+
+    size_t length;
+    STIL::STILerror error;
+
+    const char* text = shared.getEntry("/DEMOS/Multi.sid", 1, STIL::title, length, &error);
+    CHECK_EQUAL(STIL::NO_STIL_ERROR, error);
+    CHECK_EQUAL("  TITLE: One\n ", std::string(text, length));
+
+    CHECK(shared.getEntry("/DEMOS/None.sid", 1, STIL::all, length, &error) == nullptr);
+    CHECK_EQUAL(STIL::NOT_IN_STIL, error);
+
+    // The stored error is left alone
+    CHECK_EQUAL(STIL::NO_STIL_ERROR, stil.getError());
+
+    text = shared.getBug("/DEMOS/Multi.sid", 2, length, nullptr);
+    CHECK_EQUAL("BUG: Wrong speed\n", std::string(text, length));
+}
+
+TEST_FIXTURE(Stil, TestConcurrentLookups)
+{
+    const STIL& shared = stil;
+    int failures[4] = { 0, 0, 0, 0 };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&shared, &failures, t]()
+        {
+            for (int i = 0; i < 10000; i++)
+            {
+                size_t length;
+                STIL::STILerror error;
+                if ((shared.getEntry("/DEMOS/Multi.sid", 1 + (i + t) % 2, STIL::title, length, &error) == nullptr)
+                    || (shared.getGlobalComment("/DEMOS/Multi.sid", length, &error) == nullptr))
+                    failures[t]++;
+            }
+        });
+    }
+
+    for (std::thread& thread: threads)
+        thread.join();
+
+    for (int t = 0; t < 4; t++)
+        CHECK_EQUAL(0, failures[t]);
+}
+
+}
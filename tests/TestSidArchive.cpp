@@ -0,0 +1,164 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2025 Leandro Nini
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "utpp/utpp.h"
+
+#include "../src/utils/SidArchive.h"
+#include "../src/sidplayfp/SidTune.h"
+#include "../src/sidplayfp/SidTuneInfo.h"
+
+#include <stdint.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace UnitTest;
+
+SUITE(SidArchive)
+{
+
+#define ARCHIVE_FILE "TestSidArchive.pack"
+#define TUNE_FILE "TestSidArchive.sid"
+#define TEXT_FILE "TestSidArchive.txt"
+
+static const uint8_t psid[] = {
+    0x50, 0x53, 0x49, 0x44, // magicID
+    0x00, 0x02,             // version
+    0x00, 0x7C,             // dataOffset
+    0x00, 0x00,             // loadAddress
+    0x10, 0x00,             // initAddress
+    0x10, 0x03,             // playAddress
+    0x00, 0x01,             // songs
+    0x00, 0x01,             // startSong
+    0x00, 0x00, 0x00, 0x00, // speed
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // name
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // author
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // released
+    0x00, 0x00,             // flags
+    0x00,                   // startPage
+    0x00,                   // pageLength
+    0x00,                   // secondSIDAddress
+    0x00,                   // thirdSIDAddress
+    0x00, 0x10, 0x60, 0x60  // data
+};
+
+static const char text[] = "not a tune";
+
+void writeFile(const char* fileName, const void* data, size_t size)
+{
+    FILE* f = fopen(fileName, "wb");
+    fwrite(data, 1, size, f);
+    fclose(f);
+}
+
+struct Archive
+{
+    SidArchive archive;
+
+    Archive()
+    {
+        writeFile(TUNE_FILE, psid, sizeof(psid));
+        writeFile(TEXT_FILE, text, sizeof(text) - 1);
+
+        std::vector<std::string> paths;
+        paths.push_back(TEXT_FILE);
+        paths.push_back(TUNE_FILE);
+        SidArchive::build(ARCHIVE_FILE, ".", paths);
+
+        archive.open(ARCHIVE_FILE);
+    }
+
+    ~Archive()
+    {
+        SidArchive::setCurrent(nullptr);
+        remove(ARCHIVE_FILE);
+        remove(TUNE_FILE);
+        remove(TEXT_FILE);
+    }
+};
+
+TEST_FIXTURE(Archive, TestIndexSorted)
+{
+    CHECK_EQUAL(2u, archive.entries());
+    CHECK_EQUAL(TUNE_FILE, archive.entryName(0));
+    CHECK_EQUAL(TEXT_FILE, archive.entryName(1));
+    CHECK(archive.entryName(2) == nullptr);
+}
+
+TEST_FIXTURE(Archive, TestRead)
+{
+    std::vector<uint8_t> buffer;
+    CHECK(archive.read(TEXT_FILE, buffer));
+    CHECK_EQUAL(sizeof(text) - 1, buffer.size());
+    CHECK(std::memcmp(buffer.data(), text, buffer.size()) == 0);
+
+    CHECK(!archive.read("missing.sid", buffer));
+}
+
+TEST_FIXTURE(Archive, TestBorrow)
+{
+    uint_least32_t size;
+    const uint_least8_t* data = archive.data(TUNE_FILE, size);
+    CHECK_EQUAL(sizeof(psid), size);
+
+    SidTune tune(data, size, true);
+    CHECK(tune.getStatus());
+    CHECK_EQUAL(0x1000, tune.getInfo()->loadAddr());
+}
+
+TEST_FIXTURE(Archive, TestMD5)
+{
+    SidTune tune(psid, sizeof(psid));
+
+    char md5[SidTune::MD5_LENGTH + 1];
+    char md5Archive[SidTune::MD5_LENGTH + 1];
+    CHECK_EQUAL(tune.createMD5New(md5), archive.md5(TUNE_FILE, md5Archive));
+
+    CHECK(archive.md5("missing.sid", md5Archive) == nullptr);
+}
+
+TEST_FIXTURE(Archive, TestLoader)
+{
+    SidArchive::setCurrent(&archive);
+
+    SidTune tune(SidArchive::loader, TUNE_FILE);
+    CHECK(tune.getStatus());
+
+    SidTune missing(SidArchive::loader, "missing.sid");
+    CHECK(!missing.getStatus());
+
+    SidTune missingFile("missing.sid");
+    CHECK_EQUAL(missingFile.statusString(), missing.statusString());
+}
+
+TEST_FIXTURE(Archive, TestCorruptArchive)
+{
+    writeFile(ARCHIVE_FILE, psid, sizeof(psid));
+
+    SidArchive corrupt;
+    CHECK(!corrupt.open(ARCHIVE_FILE));
+    CHECK_EQUAL(0u, corrupt.entries());
+}
+
+}
@@ -0,0 +1,174 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2025 Leandro Nini
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "utpp/utpp.h"
+
+#include "../src/utils/SidCatalog.h"
+#include "../src/sidplayfp/SidTune.h"
+#include "../src/sidplayfp/SidTuneInfo.h"
+
+#include <stdint.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace UnitTest;
+
+SUITE(SidCatalog)
+{
+
+#define CATALOG_FILE "TestSidCatalog.idx"
+#define TUNE_FILE "TestSidCatalog.sid"
+#define NTSC_FILE "TestSidCatalog_ntsc.sid"
+#define TEXT_FILE "TestSidCatalog.txt"
+
+static const uint8_t psid[] = {
+    0x50, 0x53, 0x49, 0x44, // magicID
+    0x00, 0x02,             // version
+    0x00, 0x7C,             // dataOffset
+    0x00, 0x00,             // loadAddress
+    0x10, 0x00,             // initAddress
+    0x10, 0x03,             // playAddress
+    0x00, 0x01,             // songs
+    0x00, 0x01,             // startSong
+    0x00, 0x00, 0x00, 0x00, // speed
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // name
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // author
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // released
+    0x00, 0x00,             // flags
+    0x00,                   // startPage
+    0x00,                   // pageLength
+    0x00,                   // secondSIDAddress
+    0x00,                   // thirdSIDAddress
+    0x00, 0x10, 0x60, 0x60  // data
+};
+
+void writeFile(const char* fileName, const void* data, size_t size)
+{
+    FILE* f = fopen(fileName, "wb");
+    fwrite(data, 1, size, f);
+    fclose(f);
+}
+
+struct Catalog
+{
+    SidCatalog catalog;
+
+    Catalog()
+    {
+        uint8_t ntsc[sizeof(psid)];
+        memcpy(ntsc, psid, sizeof(psid));
+        memcpy(ntsc + 22, "Title", 5);
+        memcpy(ntsc + 54, "Author", 6);
+        ntsc[15] = 3;       // songs
+        ntsc[119] = 0x28;   // NTSC, 8580
+        ntsc[122] = 0x42;   // second SID at $D420
+        ntsc[5] = 3;        // version
+
+        writeFile(TUNE_FILE, psid, sizeof(psid));
+        writeFile(NTSC_FILE, ntsc, sizeof(ntsc));
+        writeFile(TEXT_FILE, "not a tune", 10);
+
+        std::vector<std::string> paths;
+        paths.push_back(TEXT_FILE);
+        paths.push_back(NTSC_FILE);
+        paths.push_back(TUNE_FILE);
+        SidCatalog::build(CATALOG_FILE, ".", paths);
+
+        catalog.open(CATALOG_FILE);
+    }
+
+    ~Catalog()
+    {
+        remove(CATALOG_FILE);
+        remove(TUNE_FILE);
+        remove(NTSC_FILE);
+        remove(TEXT_FILE);
+    }
+};
+
+TEST_FIXTURE(Catalog, TestEntriesSorted)
+{
+    // Not a tune, skipped
+    CHECK_EQUAL(2u, catalog.entries());
+
+    SidCatalog::Entry entry;
+    CHECK(catalog.entry(0, entry));
+    CHECK_EQUAL(TUNE_FILE, entry.path);
+    CHECK(catalog.entry(1, entry));
+    CHECK_EQUAL(NTSC_FILE, entry.path);
+    CHECK(!catalog.entry(2, entry));
+}
+
+TEST_FIXTURE(Catalog, TestFind)
+{
+    SidCatalog::Entry entry;
+    CHECK(catalog.find(NTSC_FILE, entry));
+
+    SidTune tune(NTSC_FILE);
+    const SidTuneInfo* info = tune.getInfo();
+
+    CHECK_EQUAL(info->infoString(0), entry.title);
+    CHECK_EQUAL(info->infoString(1), entry.author);
+    CHECK_EQUAL(info->infoString(2), entry.released);
+    CHECK_EQUAL(info->formatString(), entry.format);
+    CHECK_EQUAL(3u, entry.songs);
+    CHECK_EQUAL(info->startSong(), entry.startSong);
+    CHECK_EQUAL(info->loadAddr(), entry.loadAddr);
+    CHECK_EQUAL(info->initAddr(), entry.initAddr);
+    CHECK_EQUAL(info->playAddr(), entry.playAddr);
+    CHECK_EQUAL(SidTuneInfo::CLOCK_NTSC, entry.clockSpeed);
+    CHECK_EQUAL(info->compatibility(), entry.compatibility);
+    CHECK_EQUAL(2u, entry.sidChips);
+    CHECK_EQUAL(SidTuneInfo::SIDMODEL_8580, entry.sidModel[0]);
+    CHECK_EQUAL(0xd420, entry.sidChipBase[1]);
+    CHECK_EQUAL(0, entry.sidChipBase[2]);
+
+    CHECK(!catalog.find("missing.sid", entry));
+}
+
+TEST_FIXTURE(Catalog, TestFindMD5)
+{
+    SidTune tune(TUNE_FILE);
+    char md5[SidTune::MD5_LENGTH + 1];
+    tune.createMD5New(md5);
+
+    SidCatalog::Entry entry;
+    CHECK(catalog.findMD5(md5, entry));
+    CHECK_EQUAL(TUNE_FILE, entry.path);
+    CHECK_EQUAL(md5, entry.md5);
+
+    CHECK(!catalog.findMD5("00000000000000000000000000000000", entry));
+}
+
+TEST_FIXTURE(Catalog, TestCorruptCatalog)
+{
+    writeFile(CATALOG_FILE, psid, sizeof(psid));
+
+    SidCatalog corrupt;
+    CHECK(!corrupt.open(CATALOG_FILE));
+    CHECK_EQUAL(0u, corrupt.entries());
+}
+
+}
@@ -0,0 +1,175 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2025 Leandro Nini
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "utpp/utpp.h"
+
+#include "../src/utils/SidDatabase.h"
+
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace UnitTest;
+
+SUITE(SidDatabase)
+{
+
+#define DB_FILE "TestSidDatabase.md5"
+
+#define MD5_A "0123456789abcdef0123456789abcdef"
+#define MD5_B "fedcba9876543210fedcba9876543210"
+#define MD5_C "00000000000000000000000000000001"
+#define MD5_D "ffffffffffffffffffffffffffffffff"
+#define MD5_E "11111111111111111111111111111111"
+
+static const char database[] =
+    "; Songlengths database\n"
+    "[Other]\n"
+    MD5_E "=9:99\n"
+    "[Database]\n"
+    "; /MUSICIANS/A/Test.sid\n"
+    MD5_B "=0:12 1:02.5 0:30.25 2:00.125\n"
+    "\n"
+    MD5_A "=3:10(G) 0:05(M)\r\n"
+    MD5_C " =0:01 bad 0:03\n"
+    MD5_A "=0:00\n"
+    "not a hash=1:00\n"
+    MD5_D "=1:00.1234";
+
+struct Database
+{
+    SidDatabase db;
+
+    Database()
+    {
+        FILE* f = fopen(DB_FILE, "wb");
+        fputs(database, f);
+        fclose(f);
+
+        db.open(DB_FILE);
+    }
+
+    ~Database()
+    {
+        remove(DB_FILE);
+    }
+};
+
+TEST(TestNotLoaded)
+{
+    SidDatabase db;
+
+    CHECK_EQUAL(-1, db.lengthMs(MD5_A, 1));
+}
+
+TEST(TestMissingFile)
+{
+    SidDatabase db;
+
+    CHECK(!db.open("TestSidDatabase.missing"));
+    CHECK_EQUAL(-1, db.lengthMs(MD5_A, 1));
+}
+
+TEST_FIXTURE(Database, TestLengths)
+{
+    CHECK_EQUAL(12000, db.lengthMs(MD5_B, 1));
+    CHECK_EQUAL(62500, db.lengthMs(MD5_B, 2));
+    CHECK_EQUAL(30250, db.lengthMs(MD5_B, 3));
+    CHECK_EQUAL(120125, db.lengthMs(MD5_B, 4));
+    CHECK_EQUAL(-1, db.lengthMs(MD5_B, 5));
+
+    CHECK_EQUAL(62, db.length(MD5_B, 2));
+}
+
+TEST_FIXTURE(Database, TestAttributes)
+{
+    // CRLF line ending, first entry wins
+    CHECK_EQUAL(190000, db.lengthMs(MD5_A, 1));
+    CHECK_EQUAL(5000, db.lengthMs(MD5_A, 2));
+    CHECK_EQUAL(-1, db.lengthMs(MD5_A, 3));
+}
+
+TEST_FIXTURE(Database, TestCorrupt)
+{
+    CHECK_EQUAL(1000, db.lengthMs(MD5_C, 1));
+    CHECK_EQUAL(-1, db.lengthMs(MD5_C, 2));
+    CHECK_EQUAL(-1, db.lengthMs(MD5_C, 3));
+
+    CHECK_EQUAL(-1, db.lengthMs(MD5_D, 1));
+}
+
+TEST_FIXTURE(Database, TestMissing)
+{
+    // Only the Database section is used
+    CHECK_EQUAL(-1, db.lengthMs(MD5_E, 1));
+
+    CHECK_EQUAL(-1, db.lengthMs("0123456789abcdef", 1));
+    CHECK_EQUAL(-1, db.lengthMs("not a hash", 1));
+}
+
+TEST_FIXTURE(Database, TestErrorResult)
+{
+    const char* error = nullptr;
+
+    CHECK_EQUAL(62500, db.lengthMs(MD5_B, 2, &error));
+    CHECK(error == nullptr);
+
+    CHECK_EQUAL(-1, db.lengthMs(MD5_E, 1, &error));
+    CHECK(error != nullptr);
+
+    // The stored error is left alone
+    CHECK(db.error() != error);
+
+    CHECK_EQUAL(-1, db.lengthMs(MD5_E, 1, nullptr));
+}
+
+TEST_FIXTURE(Database, TestConcurrentLookups)
+{
+    const SidDatabase& shared = db;
+    int failures[4] = { 0, 0, 0, 0 };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&shared, &failures, t]()
+        {
+            for (int i = 0; i < 10000; i++)
+            {
+                const char* error;
+                if ((shared.lengthMs(MD5_B, 1 + (i + t) % 4, &error) <= 0)
+                    || (shared.lengthMs(MD5_E, 1, &error) != -1))
+                    failures[t]++;
+            }
+        });
+    }
+
+    for (std::thread& thread: threads)
+        thread.join();
+
+    for (int t = 0; t < 4; t++)
+        CHECK_EQUAL(0, failures[t]);
+}
+
+TEST_FIXTURE(Database, TestUpperCase)
+{
+    CHECK_EQUAL(12000, db.lengthMs("FEDCBA9876543210FEDCBA9876543210", 1));
+}
+
+}
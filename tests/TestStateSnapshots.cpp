@@ -0,0 +1,122 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2025 Leandro Nini
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "utpp/utpp.h"
+
+#include <algorithm>
+
+#include "../src/builders/residfp-builder/residfp/SID.h"
+
+using namespace UnitTest;
+using namespace reSIDfp;
+
+#define CLOCK_FREQ 985248.
+#define SAMPLE_FREQ 44100.
+
+SUITE(StateSnapshots)
+{
+
+static void setup(SID& sid)
+{
+    sid.setSamplingParameters(CLOCK_FREQ, DECIMATE, SAMPLE_FREQ);
+    sid.reset();
+
+    sid.write(0x00, 0x34);
+    sid.write(0x01, 0x12);
+    sid.write(0x02, 0x00);
+    sid.write(0x03, 0x08);
+    sid.write(0x05, 0x00);
+    sid.write(0x06, 0xf0);
+    sid.write(0x04, 0x41);
+    sid.write(0x15, 0x07);
+    sid.write(0x16, 0x80);
+    sid.write(0x17, 0xf1);
+    sid.write(0x18, 0x1f);
+}
+
+TEST(TestDisabled)
+{
+    SID sid;
+    CHECK(sid.getStateSnapshots() == nullptr);
+
+    sid.enableStateSnapshots(1000);
+    CHECK(sid.getStateSnapshots() != nullptr);
+
+    sid.enableStateSnapshots(0);
+    CHECK(sid.getStateSnapshots() == nullptr);
+}
+
+TEST(TestSnapshots)
+{
+    SID sid;
+    sid.enableStateSnapshots(1000);
+    setup(sid);
+
+    short buf[1000];
+    int samples = 0;
+    for (int i = 0; i < 10; i++)
+        samples += sid.clock(999, buf);
+    sid.write(0x01, 0x20);
+    samples += sid.clock(1000, buf);
+
+    SIDStateBuffer* b = sid.getStateSnapshots();
+
+    CHECK_EQUAL(10u, b->available());
+
+    for (unsigned int j = 0; j < b->available(); j++)
+    {
+        const unsigned int i = b->index(j);
+
+        CHECK_EQUAL((j < 9) ? 0x1234 : 0x2034, (int)b->freq[0][i]);
+        CHECK_EQUAL(0x800, (int)b->pw[0][i]);
+        CHECK_EQUAL(0x4, (int)b->waveform[0][i]);
+        CHECK_EQUAL(0x407, (int)b->fc[i]);
+        CHECK_EQUAL(0xf1, (int)b->resFilt[i]);
+        CHECK_EQUAL(0x1f, (int)b->modeVol[i]);
+        CHECK(b->sample[i] <= static_cast<unsigned int>(samples));
+    }
+
+    // Envelope at sustain level
+    CHECK_EQUAL(0xff, (int)b->envelope[0][b->index(9)]);
+    CHECK_EQUAL(1, (int)b->envelopeState[0][b->index(9)]);
+
+    b->consume(10);
+    CHECK_EQUAL(0u, b->available());
+}
+
+TEST(TestSameOutput)
+{
+    SID a;
+    SID b;
+    b.enableStateSnapshots(100);
+    setup(a);
+    setup(b);
+
+    short bufA[5000];
+    short bufB[5000];
+
+    const int na = a.clock(100000, bufA);
+    const int nb = b.clock(100000, bufB);
+
+    CHECK_EQUAL(na, nb);
+    CHECK(std::equal(bufA, bufA + na, bufB));
+}
+
+}
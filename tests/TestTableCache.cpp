@@ -0,0 +1,135 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2025 Leandro Nini
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "utpp/utpp.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include "../src/builders/residfp-builder/residfp/TableCache.h"
+#include "../src/builders/residfp-builder/residfp/TableCache.cpp"
+
+using namespace UnitTest;
+using namespace reSIDfp;
+
+#define CACHE_NAME "TestTableCache.cache"
+#define TABLE_SIZE 1024
+
+SUITE(TableCache)
+{
+
+struct CacheFixture
+{
+    unsigned short table[TABLE_SIZE];
+
+    CacheFixture()
+    {
+        setenv("RESIDFP_CACHE_DIR", ".", 1);
+        std::remove("./" CACHE_NAME);
+
+        for (int i = 0; i < TABLE_SIZE; i++)
+            table[i] = static_cast<unsigned short>(i * 37);
+    }
+
+    ~CacheFixture()
+    {
+        std::remove("./" CACHE_NAME);
+        unsetenv("RESIDFP_CACHE_DIR");
+    }
+};
+
+TEST_FIXTURE(CacheFixture, TestMissing)
+{
+    TableCache cache(CACHE_NAME, 1, sizeof(table));
+
+    CHECK(cache.load() == nullptr);
+}
+
+TEST_FIXTURE(CacheFixture, TestRoundTrip)
+{
+    TableCache(CACHE_NAME, 1, sizeof(table)).store(table);
+
+    TableCache cache(CACHE_NAME, 1, sizeof(table));
+    const void* data = cache.load();
+
+    CHECK(data != nullptr);
+    CHECK(std::memcmp(data, table, sizeof(table)) == 0);
+}
+
+TEST_FIXTURE(CacheFixture, TestKeyMismatch)
+{
+    TableCache(CACHE_NAME, 1, sizeof(table)).store(table);
+
+    TableCache cache(CACHE_NAME, 2, sizeof(table));
+
+    CHECK(cache.load() == nullptr);
+}
+
+TEST_FIXTURE(CacheFixture, TestCorrupted)
+{
+    TableCache(CACHE_NAME, 1, sizeof(table)).store(table);
+
+    {
+        std::fstream fs("./" CACHE_NAME, std::ios::in | std::ios::out | std::ios::binary);
+        fs.seekp(100);
+        fs.put('\x55');
+    }
+
+    TableCache cache(CACHE_NAME, 1, sizeof(table));
+
+    CHECK(cache.load() == nullptr);
+}
+
+TEST_FIXTURE(CacheFixture, TestConcurrentStore)
+{
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; i++)
+    {
+        threads.emplace_back([this]()
+        {
+            for (int j = 0; j < 16; j++)
+                TableCache(CACHE_NAME, 1, sizeof(table)).store(table);
+        });
+    }
+    for (std::thread &t : threads)
+        t.join();
+
+    TableCache cache(CACHE_NAME, 1, sizeof(table));
+    const void* data = cache.load();
+
+    CHECK(data != nullptr);
+    CHECK(std::memcmp(data, table, sizeof(table)) == 0);
+}
+
+TEST_FIXTURE(CacheFixture, TestDisabled)
+{
+    unsetenv("RESIDFP_CACHE_DIR");
+
+    TableCache(CACHE_NAME, 1, sizeof(table)).store(table);
+
+    std::ifstream is("./" CACHE_NAME);
+    CHECK(is.fail());
+}
+
+}
@@ -0,0 +1,158 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2025 Leandro Nini
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "utpp/utpp.h"
+
+#include <algorithm>
+
+#include "../src/builders/residfp-builder/residfp/SID.h"
+
+using namespace UnitTest;
+using namespace reSIDfp;
+
+#define CLOCK_FREQ 985248.
+#define SAMPLE_FREQ 44100.
+
+SUITE(WaveformCapture)
+{
+
+static void setup(SID& sid)
+{
+    sid.setSamplingParameters(CLOCK_FREQ, DECIMATE, SAMPLE_FREQ);
+    sid.reset();
+
+    // Voice 1 sawtooth, about 3605 cycles per period
+    sid.write(0x00, 0x34);
+    sid.write(0x01, 0x12);
+    sid.write(0x05, 0x00);
+    sid.write(0x06, 0xf0);
+    sid.write(0x04, 0x21);
+    sid.write(0x18, 0x0f);
+}
+
+TEST(TestDisabled)
+{
+    SID sid;
+    CHECK(sid.getWaveformCapture() == nullptr);
+
+    sid.enableWaveformCapture(1, false);
+    CHECK(sid.getWaveformCapture() != nullptr);
+
+    sid.enableWaveformCapture(0, false);
+    CHECK(sid.getWaveformCapture() == nullptr);
+}
+
+TEST(TestFullRate)
+{
+    SID sid;
+    sid.enableWaveformCapture(1, false);
+    setup(sid);
+
+    short buf[1000];
+    sid.clock(10000, buf);
+
+    WaveformCaptureBuffer* b = sid.getWaveformCapture();
+
+    CHECK_EQUAL(10000u, b->available());
+
+    // Without reduction the max arrays alias the min ones
+    CHECK(b->waveMax[0] == b->waveMin[0]);
+
+    // The sawtooth rises by freq / 4096 every cycle, with wraparound
+    unsigned int rising = 0;
+    for (unsigned int j = 1000; j < 10000; j++)
+    {
+        const int prev = b->waveMin[0][b->index(j - 1)];
+        const int cur = b->waveMin[0][b->index(j)];
+        if ((cur - prev == 1) || (cur - prev == 2))
+            rising++;
+    }
+    CHECK(rising > 8990);
+
+    // Envelope at sustain level
+    CHECK_EQUAL(0xff, (int)b->envMin[0][b->index(9999)]);
+    CHECK_EQUAL(0, (int)b->envMin[1][b->index(9999)]);
+
+    b->consume(10000);
+    CHECK_EQUAL(0u, b->available());
+}
+
+TEST(TestMinMax)
+{
+    SID sid;
+    sid.enableWaveformCapture(4096, true);
+    setup(sid);
+
+    short buf[2000];
+    sid.clock(40960, buf);
+
+    WaveformCaptureBuffer* b = sid.getWaveformCapture();
+
+    CHECK_EQUAL(10u, b->available());
+
+    // Each bucket spans a full period
+    for (unsigned int j = 1; j < 10; j++)
+    {
+        const unsigned int i = b->index(j);
+        CHECK(b->waveMin[0][i] < 0x10);
+        CHECK(b->waveMax[0][i] > 0xff0);
+        CHECK_EQUAL(0, (int)b->waveMax[1][i]);
+    }
+
+    // The attack completes within the first bucket
+    CHECK_EQUAL(0xff, (int)b->envMax[0][b->index(0)]);
+    CHECK_EQUAL(0xff, (int)b->envMin[0][b->index(1)]);
+}
+
+TEST(TestDropped)
+{
+    SID sid;
+    sid.enableWaveformCapture(1, false);
+    setup(sid);
+
+    short buf[4000];
+    sid.clock(WaveformCaptureBuffer::SIZE + 100, buf);
+
+    WaveformCaptureBuffer* b = sid.getWaveformCapture();
+
+    CHECK_EQUAL(WaveformCaptureBuffer::SIZE, b->available());
+    CHECK_EQUAL(100u, b->readDropped());
+    CHECK_EQUAL(0u, b->readDropped());
+}
+
+TEST(TestSameOutput)
+{
+    SID a;
+    SID b;
+    b.enableWaveformCapture(16, true);
+    setup(a);
+    setup(b);
+
+    short bufA[5000];
+    short bufB[5000];
+
+    const int na = a.clock(100000, bufA);
+    const int nb = b.clock(100000, bufB);
+
+    CHECK_EQUAL(na, nb);
+    CHECK(std::equal(bufA, bufA + na, bufB));
+}
+
+}